@@ -0,0 +1,35 @@
+ /******************************************************************************
+ *
+ * Module: Application
+ *
+ * File Name: App_Cfg.h
+ *
+ * Description: Pre-compile configuration header file of the application. It binds the services of
+ *              the application to the drivers below them, so the drivers do not include the headers
+ *              of the services they call.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef APP_CFG_H_
+#define APP_CFG_H_
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "SwTimer.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Tick consumers called in order by SysTick_Handler on every tick when SYSTICK_HOOK_MODE is
+ * SYSTICK_HOOK_STATIC, add one call per consumer */
+#define SYSTICK_STATIC_HOOKS()              \
+    do                                      \
+    {                                       \
+        SwTimer_Tick();                     \
+    } while(0)
+
+#endif /* APP_CFG_H_ */
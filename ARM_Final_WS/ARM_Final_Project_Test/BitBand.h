@@ -0,0 +1,56 @@
+ /******************************************************************************
+ *
+ * Module: Bit-Band
+ *
+ * File Name: BitBand.h
+ *
+ * Description: header file for the bit-band access layer. Every bit of the first 1 MB of the SRAM
+ *              (0x20000000) and of the peripherals (0x40000000) has a word in an alias region, a store
+ *              of 0 or 1 to this word clears or sets the bit with one write that the bus performs as
+ *              an atomic read-modify-write, and a load returns the bit. The System Control Space
+ *              (NVIC, SysTick, SCB at 0xE000E000) is not bit-banded.
+ *
+ *              The layer is kept to the peripheral registers: the alias address of a register is
+ *              computed at build time and the access is one store. BITBAND_STATIC_CHECK rejects at
+ *              build time a constant address outside the two regions.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef BITBAND_H_
+#define BITBAND_H_
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define BITBAND_SRAM_BASE                    0x20000000UL
+#define BITBAND_SRAM_ALIAS_BASE              0x22000000UL
+#define BITBAND_PERIPH_BASE                  0x40000000UL
+#define BITBAND_PERIPH_ALIAS_BASE            0x42000000UL
+
+/* Size of each bit-band region */
+#define BITBAND_REGION_MASK                  0x000FFFFFUL
+
+/* TRUE if ADDR is in one of the two bit-band regions */
+#define BITBAND_IS_BANDED(ADDR)              ((((uint32)(ADDR) & ~BITBAND_REGION_MASK) == BITBAND_SRAM_BASE) || \
+                                              (((uint32)(ADDR) & ~BITBAND_REGION_MASK) == BITBAND_PERIPH_BASE))
+
+/* Build time check that the constant address ADDR is bit-banded, e.g. a register the alias is used
+ * for. NAME is the name of the typedef holding the check, unique in its file */
+#define BITBAND_STATIC_CHECK(ADDR, NAME)     typedef char NAME[BITBAND_IS_BANDED(ADDR) ? 1 : -1]
+
+/* Alias word of bit BIT (0 .. 31) of the word at ADDR, the region alias is 32 MB above its base */
+#define BITBAND_ALIAS_ADDRESS(ADDR, BIT)     (((uint32)(ADDR) & 0xF0000000UL) + 0x02000000UL + \
+                                              (((uint32)(ADDR) & BITBAND_REGION_MASK) << 5) + ((uint32)(BIT) << 2))
+
+/* Bit BIT of a peripheral register given as its lvalue (e.g. GPIO_PORTF_IM_REG) */
+#define BITBAND_PERIPH(REG, BIT)             (*((volatile uint32 *)BITBAND_ALIAS_ADDRESS(&(REG), (BIT))))
+
+#endif /* BITBAND_H_ */
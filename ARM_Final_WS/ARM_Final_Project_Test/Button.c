@@ -0,0 +1,364 @@
+ /******************************************************************************
+ *
+ * Module: Button
+ *
+ * File Name: Button.c
+ *
+ * Description: Source file for the debounced button input engine
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "Button.h"
+#include "SwTimer.h"
+#include "RingBuffer.h"
+#include "NVIC.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* No button on a pin */
+#define BUTTON_NONE                          0xFF
+
+#define BUTTON_CFG_ENTRY(ID, PORT, PIN, PULL, ACTIVE_LEVEL)  {PORT, PIN, PULL, ACTIVE_LEVEL},
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef struct
+{
+    Gpio_PortType Port;
+    uint8 Pin;
+    Gpio_PullType Pull;
+    uint8 ActiveLevel;              /* Pin level of a pressed button */
+}Button_ConfigType;
+
+/* Gesture detection state of a button */
+typedef enum
+{
+    BUTTON_GESTURE_IDLE,            /* Released, nothing pending */
+    BUTTON_GESTURE_PRESSED,         /* Pressed, waiting for the long press time */
+    BUTTON_GESTURE_HELD,            /* Long press reported, repeating */
+    BUTTON_GESTURE_CLICK_WAIT,      /* Released after a short press, waiting for a second press */
+    BUTTON_GESTURE_SECOND_PRESS     /* Pressed again within the double click time */
+}Button_GestureType;
+
+typedef struct
+{
+    SwTimer_Type DebounceTimer;
+    SwTimer_Type GestureTimer;
+    uint32 EdgeTicks;               /* Tick of the first edge of the running debounce */
+    Button_IdType Id;
+    volatile boolean Pressed;       /* Debounced state */
+    Button_GestureType Gesture;
+}Button_StateType;
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+static const Button_ConfigType g_ButtonConfig[BUTTONS_NUM] =
+{
+    BUTTON_CFG_TABLE(BUTTON_CFG_ENTRY)
+};
+
+static Button_StateType g_Buttons[BUTTONS_NUM];
+
+/* Button of each pin and button pins of each port, used by the port ISRs */
+static uint8 g_PinButton[GPIO_PORTS_NUM][8];
+static uint8 g_PortPins[GPIO_PORTS_NUM];
+
+/* Events produced in the SysTick interrupt, read by Button_GetEvent */
+static RingBuffer_Type g_EventQueue;
+static Button_EventType g_EventStorage[BUTTON_QUEUE_LENGTH];
+
+static volatile Button_CallBackType g_CallBackPtr = NULL_PTR;
+
+static Button_StatsType g_Stats;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Queue an event and notify the consumer. Runs in the SysTick interrupt, the only producer */
+static void Button_Emit(const Button_StateType *Button, Button_EventIdType Event, uint32 Timestamp)
+{
+    Button_EventType Element;
+
+    Element.Timestamp = Timestamp;
+    Element.Button = (uint8)Button->Id;
+    Element.Event = (uint8)Event;
+
+    if(RingBuffer_Push(&g_EventQueue, &Element) == E_OK)
+    {
+        g_Stats.Events++;
+        if(g_CallBackPtr != NULL_PTR)
+        {
+            (*g_CallBackPtr)();
+        }
+    }
+    else
+    {
+        g_Stats.Dropped++;
+    }
+}
+
+/* Debounced press */
+static void Button_Press(Button_StateType *Button)
+{
+    Button_Emit(Button, BUTTON_EVENT_PRESS, Button->EdgeTicks);
+
+    if(Button->Gesture == BUTTON_GESTURE_CLICK_WAIT)
+    {
+        /* Second click, reported on the release */
+        SwTimer_Stop(&Button->GestureTimer);
+        Button->Gesture = BUTTON_GESTURE_SECOND_PRESS;
+    }
+    else
+    {
+        Button->Gesture = BUTTON_GESTURE_PRESSED;
+        SwTimer_Restart(&Button->GestureTimer, BUTTON_LONG_PRESS_TICKS);
+    }
+}
+
+/* Debounced release */
+static void Button_Release(Button_StateType *Button)
+{
+    Button_Emit(Button, BUTTON_EVENT_RELEASE, Button->EdgeTicks);
+
+    switch(Button->Gesture)
+    {
+    case BUTTON_GESTURE_PRESSED:
+        /* Short press, a click unless the button is pressed again soon */
+        Button->Gesture = BUTTON_GESTURE_CLICK_WAIT;
+        SwTimer_Restart(&Button->GestureTimer, BUTTON_DOUBLE_CLICK_TICKS);
+        break;
+    case BUTTON_GESTURE_SECOND_PRESS:
+        Button_Emit(Button, BUTTON_EVENT_DOUBLE_CLICK, SwTimer_GetTicks());
+        Button->Gesture = BUTTON_GESTURE_IDLE;
+        break;
+    default:
+        /* End of a long press */
+        SwTimer_Stop(&Button->GestureTimer);
+        Button->Gesture = BUTTON_GESTURE_IDLE;
+        break;
+    }
+}
+
+/* Debounce timer call back, runs in the SysTick interrupt */
+static void Button_DebounceCallBack(void *a_Arg)
+{
+    Button_StateType *Button = (Button_StateType *)a_Arg;
+    const Button_ConfigType *Config = &g_ButtonConfig[Button->Id];
+    boolean Pressed;
+
+    /* Acknowledge the edges of the debounce time before sampling, an edge after the sample is
+     * latched and interrupts as soon as the pin is unmasked */
+    Gpio_ClearInterrupt(Config->Port, 1 << Config->Pin);
+    Pressed = (Gpio_ReadPin(Config->Port, Config->Pin) == Config->ActiveLevel) ? TRUE : FALSE;
+    Gpio_EnableInterruptPin(Config->Port, Config->Pin);
+
+    /* The same level is a glitch shorter than the debounce time */
+    if(Pressed != Button->Pressed)
+    {
+        Button->Pressed = Pressed;
+        if(Pressed)
+        {
+            Button_Press(Button);
+        }
+        else
+        {
+            Button_Release(Button);
+        }
+    }
+}
+
+/* Gesture timer call back, runs in the SysTick interrupt */
+static void Button_GestureCallBack(void *a_Arg)
+{
+    Button_StateType *Button = (Button_StateType *)a_Arg;
+
+    switch(Button->Gesture)
+    {
+    case BUTTON_GESTURE_PRESSED:
+        Button_Emit(Button, BUTTON_EVENT_LONG_PRESS, SwTimer_GetTicks());
+        Button->Gesture = BUTTON_GESTURE_HELD;
+        SwTimer_Restart(&Button->GestureTimer, BUTTON_REPEAT_TICKS);
+        break;
+    case BUTTON_GESTURE_HELD:
+        Button_Emit(Button, BUTTON_EVENT_REPEAT, SwTimer_GetTicks());
+        SwTimer_Restart(&Button->GestureTimer, 0);
+        break;
+    case BUTTON_GESTURE_CLICK_WAIT:
+        Button_Emit(Button, BUTTON_EVENT_CLICK, SwTimer_GetTicks());
+        Button->Gesture = BUTTON_GESTURE_IDLE;
+        break;
+    default:
+        break;
+    }
+}
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Button_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the buttons are configured, E_NOT_OK for an invalid entry of Button_Cfg.h
+* Description: Function to configure the button pins with both edge interrupts and create the debounce
+*              and gesture timers, SwTimer_Init must be called before. The port IRQs are enabled by NVIC_Init.
+**********************************************************************/
+Std_ReturnType Button_Init(void)
+{
+    Std_ReturnType Status = E_OK;
+    const Button_ConfigType *Config;
+    Button_StateType *Button;
+    uint8 Port;
+    uint8 Pin;
+    uint8 Id;
+
+    RingBuffer_Init(&g_EventQueue, g_EventStorage, BUTTON_QUEUE_LENGTH, sizeof(Button_EventType));
+
+    for(Port = 0; Port < GPIO_PORTS_NUM; Port++)
+    {
+        g_PortPins[Port] = 0;
+        for(Pin = 0; Pin < 8; Pin++)
+        {
+            g_PinButton[Port][Pin] = BUTTON_NONE;
+        }
+    }
+
+    for(Id = 0; Id < BUTTONS_NUM; Id++)
+    {
+        Config = &g_ButtonConfig[Id];
+        Button = &g_Buttons[Id];
+
+        if((Config->Pin > 7) || (Gpio_ConfigPins(Config->Port, 1 << Config->Pin, GPIO_INPUT, Config->Pull) != E_OK))
+        {
+            Status = E_NOT_OK;
+            continue;
+        }
+
+        Button->Id = (Button_IdType)Id;
+        Button->Gesture = BUTTON_GESTURE_IDLE;
+        Button->Pressed = (Gpio_ReadPin(Config->Port, Config->Pin) == Config->ActiveLevel) ? TRUE : FALSE;
+        SwTimer_Create(&Button->DebounceTimer, SWTIMER_ONE_SHOT, BUTTON_DEBOUNCE_TICKS, Button_DebounceCallBack, Button);
+        SwTimer_Create(&Button->GestureTimer, SWTIMER_ONE_SHOT, BUTTON_LONG_PRESS_TICKS, Button_GestureCallBack, Button);
+
+        g_PinButton[Config->Port][Config->Pin] = Id;
+        g_PortPins[Config->Port] |= (1 << Config->Pin);
+
+        Gpio_ConfigInterrupt(Config->Port, 1 << Config->Pin, GPIO_EDGE_BOTH);
+    }
+
+    return Status;
+}
+
+/*********************************************************************
+* Service Name: Button_SetCallBack
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): CallBack - Function called from the SysTick interrupt after events are queued
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the notification of the event consumer, NULL_PTR for none.
+**********************************************************************/
+void Button_SetCallBack(Button_CallBackType CallBack)
+{
+    g_CallBackPtr = CallBack;
+}
+
+/*********************************************************************
+* Service Name: Button_GetEvent
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Event - Oldest queued event
+* Return value: E_OK if an event is read, E_NOT_OK if the queue is empty
+* Description: Function to read the next event, called by a single consumer.
+**********************************************************************/
+Std_ReturnType Button_GetEvent(Button_EventType *a_Event)
+{
+    return RingBuffer_Pop(&g_EventQueue, a_Event);
+}
+
+/*********************************************************************
+* Service Name: Button_IsPressed
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Button - Button
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: TRUE if the debounced state of the button is pressed
+* Description: Function to read the debounced state of a button.
+**********************************************************************/
+boolean Button_IsPressed(Button_IdType Button)
+{
+    return (Button < BUTTONS_NUM) ? g_Buttons[Button].Pressed : FALSE;
+}
+
+/*********************************************************************
+* Service Name: Button_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Stats - Copy of the engine counts
+* Return value: None
+* Description: Function to read the edge and event counts.
+**********************************************************************/
+void Button_GetStats(Button_StatsType *a_Stats)
+{
+    NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+    *a_Stats = g_Stats;
+    NVIC_ExitCritical(IntState);
+}
+
+/*********************************************************************
+* Service Name: Button_PortIsr
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Port - Port of the interrupt
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to be called by the ISR of a GPIO port with buttons. It acknowledges the button
+*              pins of the port, masks their interrupt and starts their debounce.
+**********************************************************************/
+void Button_PortIsr(Gpio_PortType Port)
+{
+    uint8 Pending = Gpio_GetInterruptStatus(Port) & g_PortPins[Port];
+    uint32 Ticks = SwTimer_GetTicks();
+    Button_StateType *Button;
+    uint8 Pin;
+
+    Gpio_ClearInterrupt(Port, Pending);
+
+    /* One pass per button with a first edge, its bounces are masked until the debounce ends */
+    while(Pending != 0)
+    {
+        Pin = 31 - _norm(Pending);
+        Pending &= ~(1 << Pin);
+
+        Gpio_DisableInterruptPin(Port, Pin);
+
+        Button = &g_Buttons[g_PinButton[Port][Pin]];
+        Button->EdgeTicks = Ticks;
+        SwTimer_Restart(&Button->DebounceTimer, 0);
+
+        g_Stats.Edges++;
+    }
+}
@@ -0,0 +1,154 @@
+ /******************************************************************************
+ *
+ * Module: Button
+ *
+ * File Name: Button.h
+ *
+ * Description: header file for the debounced button input engine.
+ *
+ *              The pins of the buttons listed in Button_Cfg.h interrupt on both edges. The first edge
+ *              masks the interrupt of its pin and starts a debounce timer, so the ISR work is the same
+ *              for a clean edge and for a bouncing one. When the timer expires the pin is sampled and
+ *              unmasked, a changed level is a press or a release. The gestures are detected from the
+ *              debounced presses and releases by a second timer per button:
+ *                  - CLICK: released before the long press time and not pressed again within
+ *                    the double click time (reported when this time is over)
+ *                  - DOUBLE_CLICK: pressed again within the double click time, reported on the release
+ *                  - LONG_PRESS: held for the long press time, then REPEAT every repeat period
+ *              The events are queued with the SysTick tick of the first edge (press and release) or
+ *              of their detection (gestures). They are produced in the SysTick interrupt and read by
+ *              one consumer with Button_GetEvent.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef BUTTON_H_
+#define BUTTON_H_
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "std_types.h"
+#include "Gpio.h"
+#include "Button_Cfg.h"
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+#define BUTTON_CFG_ID(ID, PORT, PIN, PULL, ACTIVE_LEVEL)     ID,
+
+typedef enum
+{
+    BUTTON_CFG_TABLE(BUTTON_CFG_ID)
+    BUTTONS_NUM
+}Button_IdType;
+
+#undef BUTTON_CFG_ID
+
+typedef enum
+{
+    BUTTON_EVENT_PRESS,
+    BUTTON_EVENT_RELEASE,
+    BUTTON_EVENT_CLICK,
+    BUTTON_EVENT_DOUBLE_CLICK,
+    BUTTON_EVENT_LONG_PRESS,
+    BUTTON_EVENT_REPEAT
+}Button_EventIdType;
+
+typedef struct
+{
+    uint32 Timestamp;               /* SysTick tick of the event */
+    uint8 Button;                   /* Button_IdType */
+    uint8 Event;                    /* Button_EventIdType */
+}Button_EventType;
+
+typedef void (*Button_CallBackType)(void);
+
+typedef struct
+{
+    uint32 Edges;                   /* Edge interrupts served, one per debounce at most */
+    uint32 Events;                  /* Events queued */
+    uint32 Dropped;                 /* Events lost because the queue was full */
+}Button_StatsType;
+
+/*******************************************************************************
+ *                                Functions Prototypes                          *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Button_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the buttons are configured, E_NOT_OK for an invalid entry of Button_Cfg.h
+* Description: Function to configure the button pins with both edge interrupts and create the debounce
+*              and gesture timers, SwTimer_Init must be called before. The port IRQs are enabled by NVIC_Init.
+**********************************************************************/
+Std_ReturnType Button_Init(void);
+
+/*********************************************************************
+* Service Name: Button_SetCallBack
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): CallBack - Function called from the SysTick interrupt after events are queued
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the notification of the event consumer, NULL_PTR for none.
+**********************************************************************/
+void Button_SetCallBack(Button_CallBackType CallBack);
+
+/*********************************************************************
+* Service Name: Button_GetEvent
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Event - Oldest queued event
+* Return value: E_OK if an event is read, E_NOT_OK if the queue is empty
+* Description: Function to read the next event, called by a single consumer.
+**********************************************************************/
+Std_ReturnType Button_GetEvent(Button_EventType *a_Event);
+
+/*********************************************************************
+* Service Name: Button_IsPressed
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Button - Button
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: TRUE if the debounced state of the button is pressed
+* Description: Function to read the debounced state of a button.
+**********************************************************************/
+boolean Button_IsPressed(Button_IdType Button);
+
+/*********************************************************************
+* Service Name: Button_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Stats - Copy of the engine counts
+* Return value: None
+* Description: Function to read the edge and event counts.
+**********************************************************************/
+void Button_GetStats(Button_StatsType *a_Stats);
+
+/*********************************************************************
+* Service Name: Button_PortIsr
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Port - Port of the interrupt
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to be called by the ISR of a GPIO port with buttons. It acknowledges the button
+*              pins of the port, masks their interrupt and starts their debounce.
+**********************************************************************/
+void Button_PortIsr(Gpio_PortType Port);
+
+#endif /* BUTTON_H_ */
@@ -0,0 +1,36 @@
+ /******************************************************************************
+ *
+ * Module: Button
+ *
+ * File Name: Button_Cfg.h
+ *
+ * Description: Pre-compile configuration header file for the button input engine
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef BUTTON_CFG_H_
+#define BUTTON_CFG_H_
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Times in SysTick ticks */
+#define BUTTON_DEBOUNCE_TICKS                20     /* Pin interrupt masked after an edge, the level is then sampled */
+#define BUTTON_LONG_PRESS_TICKS              800    /* Hold time reported as a long press */
+#define BUTTON_REPEAT_TICKS                  200    /* Repeat period while held after a long press */
+#define BUTTON_DOUBLE_CLICK_TICKS            300    /* Time after a release to press again for a double click */
+
+/* Events queued until read by Button_GetEvent, power of 2 */
+#define BUTTON_QUEUE_LENGTH                  16
+
+/* Buttons handled by the engine, one ENTRY per button:
+ *     ENTRY(Button_IdType, Gpio_PortType, Pin, Gpio_PullType, Pressed level)
+ * The ISR of each port used here must call Button_PortIsr for the port */
+#define BUTTON_CFG_TABLE(ENTRY)                                                         \
+    ENTRY(BUTTON_SW1,   GPIO_PORTF,     4,  GPIO_PULL_UP,   LOGIC_LOW)  /* SW1 (PF4) */ \
+    ENTRY(BUTTON_SW2,   GPIO_PORTF,     0,  GPIO_PULL_UP,   LOGIC_LOW)  /* SW2 (PF0) */
+
+#endif /* BUTTON_CFG_H_ */
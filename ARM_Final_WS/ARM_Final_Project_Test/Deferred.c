@@ -0,0 +1,252 @@
+ /******************************************************************************
+ *
+ * Module: Deferred Work
+ *
+ * File Name: Deferred.c
+ *
+ * Description: Source file for the deferred interrupt processing service
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "Deferred.h"
+#include "NVIC.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* PENDSVSET bit in the Interrupt Control and State register, writing 0 to the other bits has no effect */
+#define DEFERRED_PENDSVSET_MASK              0x10000000
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+/* FIFO of the posted work items, g_QueueTail points to the Next field of the last item */
+static Deferred_WorkType *g_QueueHead = NULL_PTR;
+static Deferred_WorkType **g_QueueTail = &g_QueueHead;
+static uint32 g_QueueDepth = 0;
+
+static Deferred_StatsType g_Stats;
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Deferred_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to empty the work queue, the PendSV priority is set by NVIC_Init
+*              (NVIC_CFG_EXCEPTION_TABLE).
+**********************************************************************/
+void Deferred_Init(void)
+{
+    NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    g_QueueHead = NULL_PTR;
+    g_QueueTail = &g_QueueHead;
+    g_QueueDepth = 0;
+
+    NVIC_ExitCritical(IntState);
+}
+
+/*********************************************************************
+* Service Name: Deferred_Create
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.WorkFunc - Function executed from PendSV
+*                  2.Arg - User argument passed to the work function
+* Parameters (inout): Work - Work item to be initialized
+* Parameters (out): None
+* Return value: E_OK if the work item is created, E_NOT_OK for invalid parameters
+* Description: Function to initialize a work item.
+**********************************************************************/
+Std_ReturnType Deferred_Create(Deferred_WorkType *Work, Deferred_WorkFuncType WorkFunc, void *Arg)
+{
+    if((Work == NULL_PTR) || (WorkFunc == NULL_PTR))
+    {
+        return E_NOT_OK;
+    }
+
+    Work->Next = NULL_PTR;
+    Work->WorkFunc = WorkFunc;
+    Work->Arg = Arg;
+    Work->PostCycles = 0;
+    Work->Queued = FALSE;
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Deferred_Post
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): Work - Work item to be executed
+* Parameters (out): None
+* Return value: E_OK if the item is queued, E_NOT_OK if it is still queued from a previous post
+* Description: Function to queue a work item and pend PendSV. A work item is queued only once,
+*              posting it again before it runs is counted as coalesced and the work runs once.
+**********************************************************************/
+Std_ReturnType Deferred_Post(Deferred_WorkType *Work)
+{
+    NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    if(Work->Queued)
+    {
+        g_Stats.Coalesced++;
+        NVIC_ExitCritical(IntState);
+        return E_NOT_OK;
+    }
+
+    Work->Next = NULL_PTR;
+    Work->PostCycles = DWT_CYCCNT_REG;
+    Work->Queued = TRUE;
+    *g_QueueTail = Work;
+    g_QueueTail = &Work->Next;
+
+    g_Stats.Posted++;
+    if(++g_QueueDepth > g_Stats.MaxQueueDepth)
+    {
+        g_Stats.MaxQueueDepth = g_QueueDepth;
+    }
+
+    NVIC_ExitCritical(IntState);
+
+    /* PendSV runs once every other active or pending interrupt has returned */
+    NVIC_SYSTEM_INTCTRL = DEFERRED_PENDSVSET_MASK;
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Deferred_IsrEnter
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Cycle counter value at the start of the ISR
+* Description: Function to be called first in an ISR to measure its execution time.
+**********************************************************************/
+uint32 Deferred_IsrEnter(void)
+{
+    return DWT_CYCCNT_REG;
+}
+
+/*********************************************************************
+* Service Name: Deferred_IsrExit
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): a_EnterCycles - Value returned by Deferred_IsrEnter
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to be called last in an ISR to record its execution time.
+**********************************************************************/
+void Deferred_IsrExit(uint32 a_EnterCycles)
+{
+    uint32 IsrCycles = DWT_CYCCNT_REG - a_EnterCycles;
+    NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    g_Stats.LastIsrCycles = IsrCycles;
+    if(IsrCycles > g_Stats.MaxIsrCycles)
+    {
+        g_Stats.MaxIsrCycles = IsrCycles;
+    }
+
+    NVIC_ExitCritical(IntState);
+}
+
+/*********************************************************************
+* Service Name: Deferred_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Stats - Copy of the measurements
+* Return value: None
+* Description: Function to read the ISR time and the queue-to-execution latency measurements.
+**********************************************************************/
+void Deferred_GetStats(Deferred_StatsType *a_Stats)
+{
+    NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+    *a_Stats = g_Stats;
+    NVIC_ExitCritical(IntState);
+}
+
+/*********************************************************************
+* Service Name: Deferred_Run
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to execute the queued work items in posting order until the queue is empty.
+*              Called from the PendSV handler in Kernel_PendSV.asm.
+**********************************************************************/
+void Deferred_Run(void)
+{
+    Deferred_WorkType *Work;
+    uint32 PostCycles;
+    uint32 StartCycles;
+    uint32 Latency;
+    uint32 WorkCycles;
+    NVIC_CriticalStateType IntState;
+
+    while(1)
+    {
+        /* Take the first item, it may be posted again as soon as it is unlinked */
+        IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+        Work = g_QueueHead;
+        if(Work == NULL_PTR)
+        {
+            NVIC_ExitCritical(IntState);
+            break;
+        }
+        g_QueueHead = Work->Next;
+        if(g_QueueHead == NULL_PTR)
+        {
+            g_QueueTail = &g_QueueHead;
+        }
+        g_QueueDepth--;
+        /* A post after the unlink writes PostCycles again, keep the one of this run */
+        PostCycles = Work->PostCycles;
+        Work->Queued = FALSE;
+        NVIC_ExitCritical(IntState);
+
+        StartCycles = DWT_CYCCNT_REG;
+        Latency = StartCycles - PostCycles;
+
+        /* The work runs with interrupts enabled, any interrupt can preempt it */
+        Work->WorkFunc(Work->Arg);
+
+        WorkCycles = DWT_CYCCNT_REG - StartCycles;
+
+        IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+        g_Stats.Executed++;
+        g_Stats.LastLatencyCycles = Latency;
+        if(Latency > g_Stats.MaxLatencyCycles)
+        {
+            g_Stats.MaxLatencyCycles = Latency;
+        }
+        g_Stats.LastWorkCycles = WorkCycles;
+        if(WorkCycles > g_Stats.MaxWorkCycles)
+        {
+            g_Stats.MaxWorkCycles = WorkCycles;
+        }
+        NVIC_ExitCritical(IntState);
+    }
+}
@@ -0,0 +1,145 @@
+ /******************************************************************************
+ *
+ * Module: Deferred Work
+ *
+ * File Name: Deferred.h
+ *
+ * Description: header file for the deferred interrupt processing service. An ISR only
+ *              acknowledges its peripheral and posts a work item, the work items are executed
+ *              later from the PendSV exception that runs at the lowest priority.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef DEFERRED_H_
+#define DEFERRED_H_
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef void (*Deferred_WorkFuncType)(void *a_Arg);
+
+/* Work item, allocated by the user and linked into the queue while posted */
+typedef struct Deferred_WorkStruct
+{
+    struct Deferred_WorkStruct *Next;
+    Deferred_WorkFuncType WorkFunc;
+    void *Arg;
+    uint32 PostCycles;              /* Cycle counter value when the item was posted */
+    volatile boolean Queued;
+}Deferred_WorkType;
+
+/* Measurements in core cycles, the cycle counter must be enabled by Delay_Init */
+typedef struct
+{
+    uint32 Posted;                  /* Work items queued */
+    uint32 Coalesced;               /* Posts of an item that was still queued */
+    uint32 Executed;                /* Work items executed */
+    uint32 MaxQueueDepth;
+    uint32 LastLatencyCycles;       /* From the post to the start of the work */
+    uint32 MaxLatencyCycles;
+    uint32 LastWorkCycles;          /* Execution time of the work */
+    uint32 MaxWorkCycles;
+    uint32 LastIsrCycles;           /* From Deferred_IsrEnter to Deferred_IsrExit */
+    uint32 MaxIsrCycles;
+}Deferred_StatsType;
+
+/*******************************************************************************
+ *                                Functions Prototypes                          *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Deferred_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to empty the work queue, the PendSV priority is set by NVIC_Init
+*              (NVIC_CFG_EXCEPTION_TABLE).
+**********************************************************************/
+void Deferred_Init(void);
+
+/*********************************************************************
+* Service Name: Deferred_Create
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.WorkFunc - Function executed from PendSV
+*                  2.Arg - User argument passed to the work function
+* Parameters (inout): Work - Work item to be initialized
+* Parameters (out): None
+* Return value: E_OK if the work item is created, E_NOT_OK for invalid parameters
+* Description: Function to initialize a work item.
+**********************************************************************/
+Std_ReturnType Deferred_Create(Deferred_WorkType *Work, Deferred_WorkFuncType WorkFunc, void *Arg);
+
+/*********************************************************************
+* Service Name: Deferred_Post
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): Work - Work item to be executed
+* Parameters (out): None
+* Return value: E_OK if the item is queued, E_NOT_OK if it is still queued from a previous post
+* Description: Function to queue a work item and pend PendSV. A work item is queued only once,
+*              posting it again before it runs is counted as coalesced and the work runs once.
+**********************************************************************/
+Std_ReturnType Deferred_Post(Deferred_WorkType *Work);
+
+/*********************************************************************
+* Service Name: Deferred_IsrEnter
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Cycle counter value at the start of the ISR
+* Description: Function to be called first in an ISR to measure its execution time.
+**********************************************************************/
+uint32 Deferred_IsrEnter(void);
+
+/*********************************************************************
+* Service Name: Deferred_IsrExit
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): a_EnterCycles - Value returned by Deferred_IsrEnter
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to be called last in an ISR to record its execution time.
+**********************************************************************/
+void Deferred_IsrExit(uint32 a_EnterCycles);
+
+/*********************************************************************
+* Service Name: Deferred_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Stats - Copy of the measurements
+* Return value: None
+* Description: Function to read the ISR time and the queue-to-execution latency measurements.
+**********************************************************************/
+void Deferred_GetStats(Deferred_StatsType *a_Stats);
+
+/*********************************************************************
+* Service Name: Deferred_Run
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to execute the queued work items in posting order until the queue is empty.
+*              Called from the PendSV handler in Kernel_PendSV.asm.
+**********************************************************************/
+void Deferred_Run(void);
+
+#endif /* DEFERRED_H_ */
@@ -0,0 +1,206 @@
+ /******************************************************************************
+ *
+ * Module: Delay
+ *
+ * File Name: Delay.c
+ *
+ * Description: Source file for the busy-wait delay driver. The delays poll the DWT cycle
+ *              counter, so they do not depend on the compiler output or the flash wait
+ *              states and stay accurate at any core clock.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "Delay.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define CORE_DEBUG_DEMCR_TRCENA_MASK         0x01000000  /* Enable the DWT and ITM units */
+#define DWT_CTRL_CYCCNTENA_MASK              0x00000001  /* Enable the cycle counter */
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+static Delay_CalibrationType g_Calibration;
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Delay_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): a_CoreClockHz - Core clock frequency in Hz
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the cycle counter is running, E_NOT_OK otherwise
+* Description: Function to enable the DWT cycle counter and calibrate the delays: the fixed cost
+*              of a delay call is measured and removed, then a reference delay is measured to
+*              report the remaining error.
+**********************************************************************/
+Std_ReturnType Delay_Init(uint32 a_CoreClockHz)
+{
+    uint32 Start;
+    uint32 Measured;
+    uint32 Overhead = 0xFFFFFFFF;
+    uint8 Run;
+
+    if(a_CoreClockHz < 1000000UL)
+    {
+        return E_NOT_OK;
+    }
+
+    /* Enable the cycle counter */
+    CORE_DEBUG_DEMCR_REG |= CORE_DEBUG_DEMCR_TRCENA_MASK;
+    DWT_CYCCNT_REG = 0;
+    DWT_CTRL_REG |= DWT_CTRL_CYCCNTENA_MASK;
+
+    /* The counter is not implemented or did not start */
+    Start = DWT_CYCCNT_REG;
+    if(DWT_CYCCNT_REG == Start)
+    {
+        return E_NOT_OK;
+    }
+
+    g_Calibration.CoreClockHz = a_CoreClockHz;
+    g_Calibration.CyclesPerMicro = (a_CoreClockHz + 500000UL) / 1000000UL;
+    g_Calibration.OverheadCycles = 0;
+
+    /* Fixed cost of a delay call: the shortest of a few empty delays */
+    for(Run = 0; Run < DELAY_CALIBRATION_RUNS; Run++)
+    {
+        Start = DWT_CYCCNT_REG;
+        Delay_Cycles(0);
+        Measured = DWT_CYCCNT_REG - Start;
+        if(Measured < Overhead)
+        {
+            Overhead = Measured;
+        }
+    }
+    g_Calibration.OverheadCycles = Overhead;
+
+    /* Remaining error of a reference delay */
+    Start = DWT_CYCCNT_REG;
+    Delay_Us(DELAY_CALIBRATION_REFERENCE_US);
+    Measured = DWT_CYCCNT_REG - Start;
+    g_Calibration.ReferenceErrorCycles = (sint32)(Measured - (DELAY_CALIBRATION_REFERENCE_US * g_Calibration.CyclesPerMicro));
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Delay_Cycles
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): a_Cycles - Number of core cycles to wait
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to busy-wait the given number of core cycles (call included).
+**********************************************************************/
+void Delay_Cycles(uint32 a_Cycles)
+{
+    uint32 Start = DWT_CYCCNT_REG;
+
+    if(a_Cycles <= g_Calibration.OverheadCycles)
+    {
+        return;
+    }
+    a_Cycles -= g_Calibration.OverheadCycles;
+
+    /* Unsigned difference is correct across the counter wrap-around */
+    while((DWT_CYCCNT_REG - Start) < a_Cycles);
+}
+
+/*********************************************************************
+* Service Name: Delay_Us
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): a_TimeInMicroSeconds - Required delay in microseconds
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to busy-wait the given number of microseconds (call included). Returns at
+*              once if Delay_Init did not succeed.
+**********************************************************************/
+void Delay_Us(uint32 a_TimeInMicroSeconds)
+{
+    uint32 Start = DWT_CYCCNT_REG;
+    uint32 CyclesPerMicro = g_Calibration.CyclesPerMicro;
+
+    /* Not calibrated, the slice below would divide by zero */
+    if(CyclesPerMicro == 0)
+    {
+        return;
+    }
+
+    /* The deadlines count from the call, not from the counter read: the cycles of the call measured
+     * by Delay_Init are taken off the first one like Delay_Cycles does */
+    Start -= g_Calibration.OverheadCycles;
+
+    /* Wait in slices of at most 2^31 cycles, each slice ends exactly where the next starts
+     * so the slicing adds no error */
+    while(a_TimeInMicroSeconds > 0)
+    {
+        uint32 Slice = (a_TimeInMicroSeconds > (0x7FFFFFFFUL / CyclesPerMicro)) ? (0x7FFFFFFFUL / CyclesPerMicro) : a_TimeInMicroSeconds;
+
+        Start += Slice * CyclesPerMicro;
+        a_TimeInMicroSeconds -= Slice;
+
+        while((sint32)(DWT_CYCCNT_REG - Start) < 0);
+    }
+}
+
+/*********************************************************************
+* Service Name: Delay_Ms
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): a_TimeInMilliSeconds - Required delay in milliseconds
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to busy-wait the given number of milliseconds (call included). Returns at
+*              once if Delay_Init did not succeed.
+**********************************************************************/
+void Delay_Ms(uint32 a_TimeInMilliSeconds)
+{
+    uint32 Start = DWT_CYCCNT_REG - g_Calibration.OverheadCycles;
+    uint32 CyclesPerMilli = g_Calibration.CyclesPerMicro * 1000UL;
+
+    if(CyclesPerMilli == 0)
+    {
+        return;
+    }
+
+    /* One deadline per millisecond, each deadline is derived from the previous one so the loop
+     * overhead does not accumulate */
+    while(a_TimeInMilliSeconds > 0)
+    {
+        Start += CyclesPerMilli;
+        a_TimeInMilliSeconds--;
+
+        while((sint32)(DWT_CYCCNT_REG - Start) < 0);
+    }
+}
+
+/*********************************************************************
+* Service Name: Delay_GetCalibration
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Calibration - Copy of the calibration result
+* Return value: None
+* Description: Function to read the calibration result and the measured error of the delays.
+**********************************************************************/
+void Delay_GetCalibration(Delay_CalibrationType *a_Calibration)
+{
+    *a_Calibration = g_Calibration;
+}
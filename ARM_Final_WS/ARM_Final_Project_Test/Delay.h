@@ -0,0 +1,112 @@
+ /******************************************************************************
+ *
+ * Module: Delay
+ *
+ * File Name: Delay.h
+ *
+ * Description: header file for the busy-wait delay driver based on the DWT cycle counter
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef DELAY_H_
+#define DELAY_H_
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Number of runs used to measure the fixed cost of a delay call */
+#define DELAY_CALIBRATION_RUNS               8
+
+/* Reference delay measured after the calibration to report the remaining error */
+#define DELAY_CALIBRATION_REFERENCE_US       100
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Result of the boot-time calibration */
+typedef struct
+{
+    uint32 CoreClockHz;         /* Core clock used to convert time to cycles */
+    uint32 CyclesPerMicro;      /* Core cycles in one microsecond */
+    uint32 OverheadCycles;      /* Fixed cost of a delay call, removed from every delay */
+    sint32 ReferenceErrorCycles;/* Measured - requested cycles of a DELAY_CALIBRATION_REFERENCE_US delay */
+}Delay_CalibrationType;
+
+/*******************************************************************************
+ *                                Functions Prototypes                          *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Delay_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): a_CoreClockHz - Core clock frequency in Hz
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the cycle counter is running, E_NOT_OK otherwise
+* Description: Function to enable the DWT cycle counter and calibrate the delays: the fixed cost
+*              of a delay call is measured and removed, then a reference delay is measured to
+*              report the remaining error.
+**********************************************************************/
+Std_ReturnType Delay_Init(uint32 a_CoreClockHz);
+
+/*********************************************************************
+* Service Name: Delay_Cycles
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): a_Cycles - Number of core cycles to wait
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to busy-wait the given number of core cycles (call included).
+**********************************************************************/
+void Delay_Cycles(uint32 a_Cycles);
+
+/*********************************************************************
+* Service Name: Delay_Us
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): a_TimeInMicroSeconds - Required delay in microseconds
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to busy-wait the given number of microseconds (call included). Returns at
+*              once if Delay_Init did not succeed.
+**********************************************************************/
+void Delay_Us(uint32 a_TimeInMicroSeconds);
+
+/*********************************************************************
+* Service Name: Delay_Ms
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): a_TimeInMilliSeconds - Required delay in milliseconds
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to busy-wait the given number of milliseconds (call included). Returns at
+*              once if Delay_Init did not succeed.
+**********************************************************************/
+void Delay_Ms(uint32 a_TimeInMilliSeconds);
+
+/*********************************************************************
+* Service Name: Delay_GetCalibration
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Calibration - Copy of the calibration result
+* Return value: None
+* Description: Function to read the calibration result and the measured error of the delays.
+**********************************************************************/
+void Delay_GetCalibration(Delay_CalibrationType *a_Calibration);
+
+#endif /* DELAY_H_ */
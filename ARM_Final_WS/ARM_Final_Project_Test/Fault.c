@@ -0,0 +1,214 @@
+ /******************************************************************************
+ *
+ * Module: Fault
+ *
+ * File Name: Fault.c
+ *
+ * Description: Source file for the post-mortem fault capture
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "Fault.h"
+#include "NVIC.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* SRAM range, a stacked frame is only read when it lies completely inside it */
+#define FAULT_SRAM_START                     0x20000000UL
+#define FAULT_SRAM_END                       0x20008000UL
+#define FAULT_FRAME_WORDS                    8
+
+/* VECTACTIVE field of the Interrupt Control and State register */
+#define FAULT_VECTACTIVE_MASK                0x000000FF
+
+/* System reset request of the APINT register */
+#define FAULT_APINT_SYSRESREQ                0x00000004
+
+/* Number of words of the record covered by the checksum */
+#define FAULT_RECORD_WORDS                   ((sizeof(Fault_RecordType) / sizeof(uint32)) - 1)
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+/* Record of the last fault, not initialized by the C startup so it survives the system reset */
+#pragma NOINIT(g_FaultRecord)
+static Fault_RecordType g_FaultRecord;
+
+/* Count of consecutive fault resets and its complement, apart from the record so Fault_Init can drop
+ * the record and keep the count. A power-on leaves a count that does not match its complement */
+#pragma NOINIT(g_FaultResets)
+static uint32 g_FaultResets;
+#pragma NOINIT(g_FaultResetsCheck)
+static uint32 g_FaultResetsCheck;
+
+/* Record of the previous run taken by Fault_Init */
+static Fault_RecordType g_LastRecord;
+static boolean g_LastRecordValid = FALSE;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Sum of the record words before the checksum */
+static uint32 Fault_Checksum(const Fault_RecordType *Record)
+{
+    const uint32 *Word_PTR = (const uint32 *)Record;
+    uint32 Sum = 0;
+    uint8 Word;
+
+    for(Word = 0; Word < FAULT_RECORD_WORDS; Word++)
+    {
+        Sum += Word_PTR[Word];
+    }
+    return Sum;
+}
+
+/* A power-on leaves random data in the record, only a complete record is accepted */
+static boolean Fault_IsRecordValid(const Fault_RecordType *Record)
+{
+    return ((Record->Magic == FAULT_RECORD_MAGIC) && (Record->Checksum == Fault_Checksum(Record))) ? TRUE : FALSE;
+}
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Fault_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to take the record left by a fault before the reset, to be called first in main.
+*              The record is kept for Fault_GetLastRecord and removed from the no-init RAM, the count
+*              of fault resets is kept until Fault_ClearResets.
+**********************************************************************/
+void Fault_Init(void)
+{
+    if(Fault_IsRecordValid(&g_FaultRecord))
+    {
+        g_LastRecord = g_FaultRecord;
+        g_LastRecordValid = TRUE;
+    }
+
+    /* The next fault starts a new record, the count goes on until Fault_ClearResets */
+    g_FaultRecord.Magic = 0;
+}
+
+/*********************************************************************
+* Service Name: Fault_GetLastRecord
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Record - Copy of the fault record of the previous run
+* Return value: E_OK if the previous run ended with a fault, E_NOT_OK otherwise
+* Description: Function to report the fault that caused the last reset.
+**********************************************************************/
+Std_ReturnType Fault_GetLastRecord(Fault_RecordType *a_Record)
+{
+    if(g_LastRecordValid == FALSE)
+    {
+        return E_NOT_OK;
+    }
+
+    *a_Record = g_LastRecord;
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Fault_ClearResets
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to restart the count of consecutive fault resets, to be called once the run
+*              is known to be healthy (e.g. the boot completed). Until then every fault reset adds
+*              one to the FaultResets of the next record, so a reset loop shows in the count.
+**********************************************************************/
+void Fault_ClearResets(void)
+{
+    g_FaultResets = 0;
+    g_FaultResetsCheck = ~g_FaultResets;
+}
+
+/*********************************************************************
+* Service Name: Fault_Capture
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): 1.a_Frame - Stack pointer holding the exception frame
+*                  2.a_ExcReturn - EXC_RETURN value of the exception
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None, the function resets the system
+* Description: Function called by Fault_Handler to save the fault record and reset the system.
+**********************************************************************/
+void Fault_Capture(const uint32 *a_Frame, uint32 a_ExcReturn)
+{
+    Fault_RecordType *Record = &g_FaultRecord;
+    uint32 FaultResets = (g_FaultResetsCheck == ~g_FaultResets) ? g_FaultResets : 0;
+    uint32 Frame = (uint32)a_Frame;
+
+    Disable_Exceptions();
+
+    Record->Magic = FAULT_RECORD_MAGIC;
+    Record->Vector = NVIC_SYSTEM_INTCTRL & FAULT_VECTACTIVE_MASK;
+    Record->ExcReturn = a_ExcReturn;
+    Record->StackPointer = Frame;
+
+    /* A stacking fault leaves the stack pointer outside the RAM, reading it would fault again */
+    if((Frame >= FAULT_SRAM_START) && (Frame <= (FAULT_SRAM_END - (FAULT_FRAME_WORDS * 4))) && ((Frame & 0x03) == 0))
+    {
+        Record->R0 = a_Frame[0];
+        Record->R1 = a_Frame[1];
+        Record->R2 = a_Frame[2];
+        Record->R3 = a_Frame[3];
+        Record->R12 = a_Frame[4];
+        Record->LR = a_Frame[5];
+        Record->PC = a_Frame[6];
+        Record->xPSR = a_Frame[7];
+    }
+    else
+    {
+        Record->R0 = 0;
+        Record->R1 = 0;
+        Record->R2 = 0;
+        Record->R3 = 0;
+        Record->R12 = 0;
+        Record->LR = 0;
+        Record->PC = 0;
+        Record->xPSR = 0;
+    }
+
+    Record->CFSR = NVIC_FAULT_STAT_REG;
+    Record->HFSR = NVIC_HFAULT_STAT_REG;
+    Record->MMFAR = NVIC_MM_ADDR_REG;
+    Record->BFAR = NVIC_FAULT_ADDR_REG;
+    Record->FaultResets = FaultResets + 1;
+    Record->Checksum = Fault_Checksum(Record);
+    g_FaultResets = Record->FaultResets;
+    g_FaultResetsCheck = ~Record->FaultResets;
+
+    /* The record must be in the RAM before the reset request */
+    Data_Sync_Barrier();
+    NVIC_SYSTEM_APINT = NVIC_APINT_VECTKEY | FAULT_APINT_SYSRESREQ;
+    Data_Sync_Barrier();
+
+    while(1)
+    {
+        /* Wait for the reset */
+    }
+}
@@ -0,0 +1,119 @@
+ /******************************************************************************
+ *
+ * Module: Fault
+ *
+ * File Name: Fault.h
+ *
+ * Description: header file for the post-mortem fault capture. The NMI, fault and unexpected interrupt
+ *              vectors enter Fault_Handler (Fault_Handler.asm), which saves the stacked exception frame
+ *              and the fault status registers in a RAM record that is not initialized at boot, then
+ *              resets the system. Fault_Init reports the record on the next boot.
+ *
+ *              A record is decoded on the host with the image of the same build, HostTests/FaultDecode
+ *              maps its PC and LR to their function and source line and names the CFSR and HFSR bits:
+ *              make -C HostTests decode VECTOR=<Vector> PC=<PC> LR=<LR> CFSR=<CFSR> HFSR=<HFSR>
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef FAULT_H_
+#define FAULT_H_
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Marks a record written by Fault_Handler */
+#define FAULT_RECORD_MAGIC                   0xFA017EC0UL
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Fault record, the frame registers are 0 when the stack pointer was not valid */
+typedef struct
+{
+    uint32 Magic;
+    uint32 Vector;                  /* Active exception number: 2 NMI, 3 - 6 faults, 16 and above IRQs */
+    uint32 ExcReturn;               /* EXC_RETURN, bit 2 set when the frame is on the process stack */
+    uint32 StackPointer;            /* Address of the stacked frame */
+    uint32 R0;
+    uint32 R1;
+    uint32 R2;
+    uint32 R3;
+    uint32 R12;
+    uint32 LR;
+    uint32 PC;                      /* Address of the faulting instruction for precise faults */
+    uint32 xPSR;
+    uint32 CFSR;                    /* Configurable Fault Status (MemManage, Bus and Usage faults) */
+    uint32 HFSR;                    /* Hard Fault Status */
+    uint32 MMFAR;                   /* MemManage fault address, valid when CFSR.MMARVALID is set */
+    uint32 BFAR;                    /* Bus fault address, valid when CFSR.BFARVALID is set */
+    uint32 FaultResets;             /* Consecutive fault resets, this one included, since Fault_ClearResets */
+    uint32 Checksum;                /* Sum of all the words above */
+}Fault_RecordType;
+
+/*******************************************************************************
+ *                                Functions Prototypes                          *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Fault_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to take the record left by a fault before the reset, to be called first in main.
+*              The record is kept for Fault_GetLastRecord and removed from the no-init RAM, the count
+*              of fault resets is kept until Fault_ClearResets.
+**********************************************************************/
+void Fault_Init(void);
+
+/*********************************************************************
+* Service Name: Fault_GetLastRecord
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Record - Copy of the fault record of the previous run
+* Return value: E_OK if the previous run ended with a fault, E_NOT_OK otherwise
+* Description: Function to report the fault that caused the last reset.
+**********************************************************************/
+Std_ReturnType Fault_GetLastRecord(Fault_RecordType *a_Record);
+
+/*********************************************************************
+* Service Name: Fault_ClearResets
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to restart the count of consecutive fault resets, to be called once the run
+*              is known to be healthy (e.g. the boot completed). Until then every fault reset adds
+*              one to the FaultResets of the next record, so a reset loop shows in the count.
+**********************************************************************/
+void Fault_ClearResets(void);
+
+/*********************************************************************
+* Service Name: Fault_Capture
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): 1.a_Frame - Stack pointer holding the exception frame
+*                  2.a_ExcReturn - EXC_RETURN value of the exception
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None, the function resets the system
+* Description: Function called by Fault_Handler to save the fault record and reset the system.
+**********************************************************************/
+void Fault_Capture(const uint32 *a_Frame, uint32 a_ExcReturn);
+
+#endif /* FAULT_H_ */
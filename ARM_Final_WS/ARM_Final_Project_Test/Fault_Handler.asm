@@ -0,0 +1,49 @@
+;******************************************************************************
+;
+; Module: Fault
+;
+; File Name: Fault_Handler.asm
+;
+; Description: Entry of the NMI, fault and unexpected interrupt vectors. It finds the stack holding
+;              the exception frame from EXC_RETURN and passes it to Fault_Capture, which saves the
+;              fault record and resets the system.
+;
+; Author: Karima Mahmoud
+;
+;******************************************************************************
+
+        .thumb
+        .text
+        .align  4
+
+        .global Fault_Handler
+        .global IntDefaultHandler
+        .global Fault_Capture
+
+;******************************************************************************
+; Service Name: Fault_Handler
+; Sync/Async: Asynchronous
+; Reentrancy: non reentrant
+; Parameters (in): None
+; Parameters (inout): None
+; Parameters (out): None
+; Return value: None, Fault_Capture resets the system
+; Description: Handler for NMI, Hard Fault, MemManage, Bus and Usage faults, also installed as
+;              IntDefaultHandler for the vectors without a handler.
+;******************************************************************************
+        .thumbfunc Fault_Handler
+        .thumbfunc IntDefaultHandler
+Fault_Handler: .asmfunc
+IntDefaultHandler:
+
+        ; R0 = stacked frame: PSP when EXC_RETURN bit 2 is set, MSP otherwise. R1 = EXC_RETURN
+        TST     LR, #0x04
+        ITE     EQ
+        MRSEQ   R0, MSP
+        MRSNE   R0, PSP
+        MOV     R1, LR
+        B       Fault_Capture
+
+        .endasmfunc
+
+        .end
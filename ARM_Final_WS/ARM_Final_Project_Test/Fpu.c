@@ -0,0 +1,205 @@
+ /******************************************************************************
+ *
+ * Module: FPU
+ *
+ * File Name: Fpu.c
+ *
+ * Description: Source file for the floating-point unit management
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "Fpu.h"
+#include "NVIC.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* CP10 and CP11 full access fields of the Coprocessor Access Control register */
+#define FPU_CPAC_FULL_ACCESS_MASK            0x00F00000
+
+/* Floating-Point Context Control register */
+#define FPU_FPCC_ASPEN_MASK                  0x80000000   /* Automatic FP state preservation */
+#define FPU_FPCC_LSPEN_MASK                  0x40000000   /* Lazy state preservation */
+#define FPU_FPCC_LSPACT_MASK                 0x00000001   /* A reserved FP frame is not filled yet */
+
+/* State returned by Fpu_IsrEnter: the CP10 and CP11 access bits of the interrupted code in their CPAC
+ * positions and this bit, set when the entry reserved a lazy FP frame */
+#define FPU_STATE_RESERVED_MASK              0x00000001
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+static Fpu_StatsType g_Stats;
+
+#if (FPU_MEASURE_STACKING == TRUE)
+/* Instrumented ISRs running, and the pending lazy frame (FPCAR, 0 if none) seen by each of them */
+static uint32 g_Nesting = 0;
+static uint32 g_NestingFpcar[FPU_MAX_NESTING];
+#endif
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Fpu_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to enable the FPU with the FPU_STACKING_POLICY stacking policy and clear the counts.
+**********************************************************************/
+void Fpu_Init(void)
+{
+    g_Stats.IsrEntries = 0;
+    g_Stats.FpContextEntries = 0;
+    g_Stats.LazySaves = 0;
+
+    Fpu_SetStackingPolicy(FPU_STACKING_POLICY);
+}
+
+/*********************************************************************
+* Service Name: Fpu_SetStackingPolicy
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Policy - FP context stacking on exception entry
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to enable the FPU and select the stacking policy, the automatic FP state
+*              preservation is always kept since the kernel context switch relies on it.
+**********************************************************************/
+void Fpu_SetStackingPolicy(Fpu_StackingPolicyType Policy)
+{
+    NVIC_CPAC_REG |= FPU_CPAC_FULL_ACCESS_MASK;
+
+    if(Policy == FPU_STACKING_LAZY)
+    {
+        NVIC_FPCC_REG |= (FPU_FPCC_ASPEN_MASK | FPU_FPCC_LSPEN_MASK);
+    }
+    else
+    {
+        NVIC_FPCC_REG = (NVIC_FPCC_REG | FPU_FPCC_ASPEN_MASK) & ~(FPU_FPCC_LSPEN_MASK);
+    }
+
+    Data_Sync_Barrier();
+    Instruction_Sync_Barrier();
+}
+
+/*********************************************************************
+* Service Name: Fpu_IsrEnter
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: State to be passed to Fpu_IsrExit: the FPU access of the interrupted code and whether
+*               this entry reserved a lazy FP frame
+* Description: Function called by FPU_ISR_ENTER, it disables the FPU when FPU_NO_FP_IN_ISR is TRUE.
+**********************************************************************/
+uint32 Fpu_IsrEnter(void)
+{
+    /* CP10 and CP11 access of the interrupted code, an ISR preempting another one finds it disabled */
+    uint32 State = NVIC_CPAC_REG & FPU_CPAC_FULL_ACCESS_MASK;
+#if (FPU_MEASURE_STACKING == TRUE)
+    uint32 IntState = _disable_IRQ();
+    uint32 Depth = g_Nesting;
+    uint32 Fpcar = 0;
+
+    /* LSPACT is set when an entry reserved a lazy FP frame that is not filled yet. The frame of a
+     * preempted instrumented ISR is still pending when that ISR did not use the FPU, and this entry
+     * reserved nothing then: FPCAR, the address of the pending frame, did not change */
+    if(NVIC_FPCC_REG & FPU_FPCC_LSPACT_MASK)
+    {
+        Fpcar = NVIC_FPCA_REG;
+        if((Depth == 0) || (Depth > FPU_MAX_NESTING) || (Fpcar != g_NestingFpcar[Depth - 1]))
+        {
+            State |= FPU_STATE_RESERVED_MASK;
+        }
+    }
+    if(Depth < FPU_MAX_NESTING)
+    {
+        g_NestingFpcar[Depth] = Fpcar;
+    }
+    g_Nesting = Depth + 1;
+    _restore_interrupts(IntState);
+#endif
+
+#if (FPU_NO_FP_IN_ISR == TRUE)
+    NVIC_CPAC_REG &= ~(FPU_CPAC_FULL_ACCESS_MASK);
+    Instruction_Sync_Barrier();
+#endif
+
+    return State;
+}
+
+/*********************************************************************
+* Service Name: Fpu_IsrExit
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): a_State - Value returned by Fpu_IsrEnter
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function called by FPU_ISR_EXIT, it counts the entry and gives back the FPU access of the
+*              interrupted code.
+**********************************************************************/
+void Fpu_IsrExit(uint32 a_State)
+{
+#if (FPU_MEASURE_STACKING == TRUE)
+    uint32 IntState;
+#endif
+
+#if (FPU_NO_FP_IN_ISR == TRUE)
+    /* Thread code gets the FPU back for the exception return, which restores the FP registers of a
+     * reserved frame. A preempted ISR had no FP context and keeps the FPU disabled */
+    NVIC_CPAC_REG = (NVIC_CPAC_REG & ~(FPU_CPAC_FULL_ACCESS_MASK)) | (a_State & FPU_CPAC_FULL_ACCESS_MASK);
+    Instruction_Sync_Barrier();
+#endif
+
+#if (FPU_MEASURE_STACKING == TRUE)
+    /* ISRs of any priority update the counts */
+    IntState = _disable_IRQ();
+    g_Nesting--;
+    g_Stats.IsrEntries++;
+    if(a_State & FPU_STATE_RESERVED_MASK)
+    {
+        g_Stats.FpContextEntries++;
+
+        /* An FP instruction of the ISR, or of an ISR preempting it, filled the reserved frame and
+         * cleared LSPACT */
+        if((NVIC_FPCC_REG & FPU_FPCC_LSPACT_MASK) == 0)
+        {
+            g_Stats.LazySaves++;
+        }
+    }
+    _restore_interrupts(IntState);
+#endif
+}
+
+/*********************************************************************
+* Service Name: Fpu_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Stats - Copy of the FP stacking counts
+* Return value: None
+* Description: Function to read the FP stacking counts of the instrumented ISRs.
+**********************************************************************/
+void Fpu_GetStats(Fpu_StatsType *a_Stats)
+{
+    uint32 IntState = _disable_IRQ();
+    *a_Stats = g_Stats;
+    _restore_interrupts(IntState);
+}
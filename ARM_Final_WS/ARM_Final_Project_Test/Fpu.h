@@ -0,0 +1,155 @@
+ /******************************************************************************
+ *
+ * Module: FPU
+ *
+ * File Name: Fpu.h
+ *
+ * Description: header file for the floating-point unit management. It selects how the FP context of
+ *              the interrupted code is stacked on exception entry, optionally forbids the FPU in the
+ *              ISRs and counts the ISR entries that carried or saved an FP context.
+ *
+ *              An ISR calls FPU_ISR_ENTER first and FPU_ISR_EXIT last. With the lazy policy an entry
+ *              from code with an active FP context only reserves the 18 FP words in the frame, they are
+ *              written if the ISR executes an FP instruction (counted as a lazy save). With the always
+ *              policy the same entries write them every time. The ISR latency in each policy is
+ *              measured on the board by building with FPU_STACKING_POLICY set to each value, or by
+ *              switching it with Fpu_SetStackingPolicy, and reading the latency histograms of
+ *              IsrProfiler_Trigger. No figures are recorded here, they depend on the FP usage of the
+ *              interrupted code.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef FPU_H_
+#define FPU_H_
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Stacking policy selected by Fpu_Init (Fpu_StackingPolicyType) */
+#ifndef FPU_STACKING_POLICY
+#define FPU_STACKING_POLICY                  FPU_STACKING_LAZY
+#endif
+
+/* The ISRs disable the FPU while they run when TRUE, an FP instruction in an ISR then raises a
+ * Usage Fault (NOCP) caught by the Fault module */
+#ifndef FPU_NO_FP_IN_ISR
+#define FPU_NO_FP_IN_ISR                     FALSE
+#endif
+
+/* FPU_ISR_ENTER/EXIT count the FP context entries and the lazy saves when TRUE */
+#ifndef FPU_MEASURE_STACKING
+#define FPU_MEASURE_STACKING                 FALSE
+#endif
+
+/* Deepest nesting of the instrumented ISRs, one per priority level */
+#define FPU_MAX_NESTING                      8
+
+#if ((FPU_NO_FP_IN_ISR == TRUE) || (FPU_MEASURE_STACKING == TRUE))
+
+/* Start of an ISR, to be placed after the declarations of the ISR */
+#define FPU_ISR_ENTER()                      uint32 Fpu_IsrState = Fpu_IsrEnter()
+
+/* End of an ISR started with FPU_ISR_ENTER, the FPU must be enabled again before the exception return */
+#define FPU_ISR_EXIT()                       Fpu_IsrExit(Fpu_IsrState)
+
+#else
+
+#define FPU_ISR_ENTER()
+#define FPU_ISR_EXIT()
+
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef enum
+{
+    FPU_STACKING_LAZY,              /* Space reserved on entry, registers saved on the first FP instruction (reset default) */
+    FPU_STACKING_ALWAYS             /* Registers saved on every entry from code with an active FP context */
+}Fpu_StackingPolicyType;
+
+typedef struct
+{
+    uint32 IsrEntries;              /* ISRs run between FPU_ISR_ENTER and FPU_ISR_EXIT */
+    uint32 FpContextEntries;        /* Entries that reserved a lazy FP frame (lazy policy only), a frame
+                                     * reserved by a preempted instrumented ISR is not counted again */
+    uint32 LazySaves;               /* Reserved frames the ISR filled by executing an FP instruction */
+}Fpu_StatsType;
+
+/*******************************************************************************
+ *                                Functions Prototypes                          *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Fpu_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to enable the FPU with the FPU_STACKING_POLICY stacking policy and clear the counts.
+**********************************************************************/
+void Fpu_Init(void);
+
+/*********************************************************************
+* Service Name: Fpu_SetStackingPolicy
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Policy - FP context stacking on exception entry
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to enable the FPU and select the stacking policy, the automatic FP state
+*              preservation is always kept since the kernel context switch relies on it.
+**********************************************************************/
+void Fpu_SetStackingPolicy(Fpu_StackingPolicyType Policy);
+
+/*********************************************************************
+* Service Name: Fpu_IsrEnter
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: State to be passed to Fpu_IsrExit: the FPU access of the interrupted code and whether
+*               this entry reserved a lazy FP frame
+* Description: Function called by FPU_ISR_ENTER, it disables the FPU when FPU_NO_FP_IN_ISR is TRUE.
+**********************************************************************/
+uint32 Fpu_IsrEnter(void);
+
+/*********************************************************************
+* Service Name: Fpu_IsrExit
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): a_State - Value returned by Fpu_IsrEnter
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function called by FPU_ISR_EXIT, it counts the entry and gives back the FPU access of the
+*              interrupted code.
+**********************************************************************/
+void Fpu_IsrExit(uint32 a_State);
+
+/*********************************************************************
+* Service Name: Fpu_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Stats - Copy of the FP stacking counts
+* Return value: None
+* Description: Function to read the FP stacking counts of the instrumented ISRs.
+**********************************************************************/
+void Fpu_GetStats(Fpu_StatsType *a_Stats);
+
+#endif /* FPU_H_ */
@@ -0,0 +1,625 @@
+ /******************************************************************************
+ *
+ * Module: GPIO
+ *
+ * File Name: Gpio.c
+ *
+ * Description: Source file for the GPIO driver of ports A to F
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "Gpio.h"
+#include "NVIC.h"
+#include "BitBand.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Register of a port at an offset from its base address */
+#define GPIO_REG(BASE, OFFSET)               (*((volatile uint32 *)((BASE) + (OFFSET))))
+
+#define GPIO_DIR_OFFSET                      0x400
+#define GPIO_IS_OFFSET                       0x404
+#define GPIO_IBE_OFFSET                      0x408
+#define GPIO_IEV_OFFSET                      0x40C
+#define GPIO_IM_OFFSET                       0x410
+#define GPIO_MIS_OFFSET                      0x418
+#define GPIO_ICR_OFFSET                      0x41C
+#define GPIO_AFSEL_OFFSET                    0x420
+#define GPIO_PUR_OFFSET                      0x510
+#define GPIO_PDR_OFFSET                      0x514
+#define GPIO_DEN_OFFSET                      0x51C
+#define GPIO_LOCK_OFFSET                     0x520
+#define GPIO_CR_OFFSET                       0x524
+#define GPIO_AMSEL_OFFSET                    0x528
+#define GPIO_PCTL_OFFSET                     0x52C
+
+/* Value unlocking the commit register of PD7 and PF0 */
+#define GPIO_LOCK_KEY                        0x4C4F434B
+
+/* Accesses measured back to back by Gpio_Benchmark */
+#define GPIO_BENCHMARK_ACCESSES              8
+
+/* PC0 to PC3 are the JTAG pins, reconfiguring them locks the debugger out */
+#define GPIO_PORTC_JTAG_PINS_MASK            0x0F
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Gpio_EnableInterruptPin and Gpio_DisableInterruptPin write the IM bits through their bit-band alias */
+BITBAND_STATIC_CHECK(GPIO_PORTA_BASE_ADDRESS + GPIO_IM_OFFSET, Gpio_PortAImCheck);
+BITBAND_STATIC_CHECK(GPIO_PORTB_BASE_ADDRESS + GPIO_IM_OFFSET, Gpio_PortBImCheck);
+BITBAND_STATIC_CHECK(GPIO_PORTC_BASE_ADDRESS + GPIO_IM_OFFSET, Gpio_PortCImCheck);
+BITBAND_STATIC_CHECK(GPIO_PORTD_BASE_ADDRESS + GPIO_IM_OFFSET, Gpio_PortDImCheck);
+BITBAND_STATIC_CHECK(GPIO_PORTE_BASE_ADDRESS + GPIO_IM_OFFSET, Gpio_PortEImCheck);
+BITBAND_STATIC_CHECK(GPIO_PORTF_BASE_ADDRESS + GPIO_IM_OFFSET, Gpio_PortFImCheck);
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+/* Base addresses of the ports on the selected aperture */
+static const uint32 g_PortBase[GPIO_PORTS_NUM] =
+{
+    GPIO_PORTA_BASE_ADDRESS,
+    GPIO_PORTB_BASE_ADDRESS,
+    GPIO_PORTC_BASE_ADDRESS,
+    GPIO_PORTD_BASE_ADDRESS,
+    GPIO_PORTE_BASE_ADDRESS,
+    GPIO_PORTF_BASE_ADDRESS
+};
+
+#if (GPIO_BENCHMARK_ENABLE == TRUE)
+
+static const uint32 g_PortApbBase[GPIO_PORTS_NUM] =
+{
+    GPIO_PORTA_APB_BASE_ADDRESS,
+    GPIO_PORTB_APB_BASE_ADDRESS,
+    GPIO_PORTC_APB_BASE_ADDRESS,
+    GPIO_PORTD_APB_BASE_ADDRESS,
+    GPIO_PORTE_APB_BASE_ADDRESS,
+    GPIO_PORTF_APB_BASE_ADDRESS
+};
+
+static const uint32 g_PortAhbBase[GPIO_PORTS_NUM] =
+{
+    GPIO_PORTA_AHB_BASE_ADDRESS,
+    GPIO_PORTB_AHB_BASE_ADDRESS,
+    GPIO_PORTC_AHB_BASE_ADDRESS,
+    GPIO_PORTD_AHB_BASE_ADDRESS,
+    GPIO_PORTE_AHB_BASE_ADDRESS,
+    GPIO_PORTF_AHB_BASE_ADDRESS
+};
+
+#endif
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+#if (GPIO_BENCHMARK_ENABLE == TRUE)
+
+/* Measure back-to-back accesses to the DATA alias of one pin, the port must be on the aperture of Base */
+static void Gpio_MeasureBus(uint32 Base, uint8 Pin, uint32 a_CoreClockHz, Gpio_BusBenchmarkType *a_Result)
+{
+    volatile uint32 *Data = &GPIO_DATA_ALIAS(Base, 1 << Pin);
+    uint32 Overhead;
+    uint32 Start;
+    uint32 Cycles;
+    uint32 Value;
+
+    /* Cost of reading the cycle counter twice */
+    Start = DWT_CYCCNT_REG;
+    Overhead = DWT_CYCCNT_REG - Start;
+
+    Start = DWT_CYCCNT_REG;
+    *Data = GPIO_ALL_PINS_MASK;
+    *Data = 0;
+    *Data = GPIO_ALL_PINS_MASK;
+    *Data = 0;
+    *Data = GPIO_ALL_PINS_MASK;
+    *Data = 0;
+    *Data = GPIO_ALL_PINS_MASK;
+    *Data = 0;
+    Cycles = DWT_CYCCNT_REG - Start - Overhead;
+    a_Result->WriteCycles = Cycles / GPIO_BENCHMARK_ACCESSES;
+
+    /* A period is one high and one low store */
+    a_Result->ToggleHz = (Cycles != 0) ? (((a_CoreClockHz / 2) * GPIO_BENCHMARK_ACCESSES) / Cycles) : 0;
+
+    Start = DWT_CYCCNT_REG;
+    Value = *Data;
+    Value = *Data;
+    Value = *Data;
+    Value = *Data;
+    Value = *Data;
+    Value = *Data;
+    Value = *Data;
+    Value = *Data;
+    Cycles = DWT_CYCCNT_REG - Start - Overhead;
+    a_Result->ReadCycles = Cycles / GPIO_BENCHMARK_ACCESSES;
+
+    (void)Value;
+}
+
+#endif
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Gpio_ConfigPins
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Mask - Pins to be configured
+*                  3.Direction - Input or output
+*                  4.Pull - Internal pull resistor
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pins are configured, E_NOT_OK for an invalid port or the JTAG pins PC0 to PC3
+* Description: Function to enable the clock of the port and configure pins as digital GPIO. The locked
+*              pins PD7 and PF0 are unlocked, the outputs keep their current level.
+**********************************************************************/
+Std_ReturnType Gpio_ConfigPins(Gpio_PortType Port, uint8 Mask, Gpio_DirectionType Direction, Gpio_PullType Pull)
+{
+    uint32 Base;
+    uint32 PctlMask = 0;
+    uint8 Pin;
+    NVIC_CriticalStateType IntState;
+
+    if((Port >= GPIO_PORTS_NUM) || ((Port == GPIO_PORTC) && (Mask & GPIO_PORTC_JTAG_PINS_MASK)))
+    {
+        return E_NOT_OK;
+    }
+
+    Base = g_PortBase[Port];
+
+    for(Pin = 0; Pin < 8; Pin++)
+    {
+        if(Mask & (1 << Pin))
+        {
+            PctlMask |= (0xFUL << (Pin * 4));
+        }
+    }
+
+    /* The registers are shared with the other pins of the port and the clock register with the other ports */
+    IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    /* Enable clock for the port and wait for clock to start */
+    SYSCTL_RCGCGPIO_REG |= (1UL << Port);
+    while(!(SYSCTL_PRGPIO_REG & (1UL << Port)));
+
+    /* Select the aperture of the base addresses in use */
+#if (GPIO_USE_AHB == TRUE)
+    SYSCTL_GPIOHBCTL_REG |= (1UL << Port);
+#else
+    SYSCTL_GPIOHBCTL_REG &= ~(1UL << Port);
+#endif
+
+    GPIO_REG(Base, GPIO_LOCK_OFFSET)   = GPIO_LOCK_KEY;   /* Unlock the commit register */
+    GPIO_REG(Base, GPIO_CR_OFFSET)    |= Mask;            /* Enable changes on the pins */
+    GPIO_REG(Base, GPIO_AMSEL_OFFSET) &= ~((uint32)Mask); /* Disable Analog on the pins */
+    GPIO_REG(Base, GPIO_PCTL_OFFSET)  &= ~PctlMask;       /* Clear PMCx bits to use the pins as GPIO */
+    GPIO_REG(Base, GPIO_AFSEL_OFFSET) &= ~((uint32)Mask); /* Disable alternative function on the pins */
+
+    if(Direction == GPIO_OUTPUT)
+    {
+        GPIO_REG(Base, GPIO_DIR_OFFSET) |= Mask;
+    }
+    else
+    {
+        GPIO_REG(Base, GPIO_DIR_OFFSET) &= ~((uint32)Mask);
+    }
+
+    GPIO_REG(Base, GPIO_PUR_OFFSET) &= ~((uint32)Mask);
+    GPIO_REG(Base, GPIO_PDR_OFFSET) &= ~((uint32)Mask);
+    if(Pull == GPIO_PULL_UP)
+    {
+        GPIO_REG(Base, GPIO_PUR_OFFSET) |= Mask;
+    }
+    else if(Pull == GPIO_PULL_DOWN)
+    {
+        GPIO_REG(Base, GPIO_PDR_OFFSET) |= Mask;
+    }
+
+    GPIO_REG(Base, GPIO_DEN_OFFSET)   |= Mask;            /* Enable Digital I/O on the pins */
+    GPIO_REG(Base, GPIO_LOCK_OFFSET)   = 0;               /* Lock the commit register again */
+
+    NVIC_ExitCritical(IntState);
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Gpio_ConfigInterrupt
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Mask - Input pins interrupting the port IRQ
+*                  3.Edge - Edges detected
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the interrupt is configured, E_NOT_OK for an invalid port
+* Description: Function to enable the edge interrupt of pins configured by Gpio_ConfigPins, the port IRQ
+*              is enabled by NVIC_Init.
+**********************************************************************/
+Std_ReturnType Gpio_ConfigInterrupt(Gpio_PortType Port, uint8 Mask, Gpio_EdgeType Edge)
+{
+    uint32 Base;
+    NVIC_CriticalStateType IntState;
+
+    if(Port >= GPIO_PORTS_NUM)
+    {
+        return E_NOT_OK;
+    }
+
+    Base = g_PortBase[Port];
+
+    IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    /* Changing the sense registers may raise a false interrupt, mask the pins meanwhile */
+    GPIO_REG(Base, GPIO_IM_OFFSET) &= ~((uint32)Mask);
+    GPIO_REG(Base, GPIO_IS_OFFSET) &= ~((uint32)Mask);    /* Detect edges */
+
+    if(Edge == GPIO_EDGE_BOTH)
+    {
+        GPIO_REG(Base, GPIO_IBE_OFFSET) |= Mask;
+    }
+    else
+    {
+        GPIO_REG(Base, GPIO_IBE_OFFSET) &= ~((uint32)Mask);
+        if(Edge == GPIO_EDGE_RISING)
+        {
+            GPIO_REG(Base, GPIO_IEV_OFFSET) |= Mask;
+        }
+        else
+        {
+            GPIO_REG(Base, GPIO_IEV_OFFSET) &= ~((uint32)Mask);
+        }
+    }
+
+    GPIO_REG(Base, GPIO_ICR_OFFSET)  = Mask;              /* Clear the trigger flags */
+    GPIO_REG(Base, GPIO_IM_OFFSET)  |= Mask;              /* Enable the interrupt on the pins */
+
+    NVIC_ExitCritical(IntState);
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Gpio_EnableInterruptPin
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Pin - Pin number (0 .. 7)
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pin is changed, E_NOT_OK for an invalid port or pin
+* Description: Function to unmask the interrupt of one pin configured by Gpio_ConfigInterrupt, an edge
+*              latched while it was masked interrupts at once. One store to the bit-band alias.
+**********************************************************************/
+Std_ReturnType Gpio_EnableInterruptPin(Gpio_PortType Port, uint8 Pin)
+{
+    if((Port >= GPIO_PORTS_NUM) || (Pin > 7))
+    {
+        return E_NOT_OK;
+    }
+
+    BITBAND_PERIPH(GPIO_REG(g_PortBase[Port], GPIO_IM_OFFSET), Pin) = 1;
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Gpio_DisableInterruptPin
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Pin - Pin number (0 .. 7)
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pin is changed, E_NOT_OK for an invalid port or pin
+* Description: Function to mask the interrupt of one pin, its edges are still latched. One store to
+*              the bit-band alias, the other pins of the port are not affected.
+**********************************************************************/
+Std_ReturnType Gpio_DisableInterruptPin(Gpio_PortType Port, uint8 Pin)
+{
+    if((Port >= GPIO_PORTS_NUM) || (Pin > 7))
+    {
+        return E_NOT_OK;
+    }
+
+    BITBAND_PERIPH(GPIO_REG(g_PortBase[Port], GPIO_IM_OFFSET), Pin) = 0;
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Gpio_GetInterruptStatus
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Port - GPIO port
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pins with a pending enabled interrupt, 0 for an invalid port
+* Description: Function to read the masked interrupt status of a port.
+**********************************************************************/
+uint8 Gpio_GetInterruptStatus(Gpio_PortType Port)
+{
+    if(Port >= GPIO_PORTS_NUM)
+    {
+        return 0;
+    }
+
+    return (uint8)GPIO_REG(g_PortBase[Port], GPIO_MIS_OFFSET);
+}
+
+/*********************************************************************
+* Service Name: Gpio_ClearInterrupt
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Mask - Pins to acknowledge
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pins are acknowledged, E_NOT_OK for an invalid port
+* Description: Function to acknowledge the interrupt of pins with one store, the other pins keep theirs.
+**********************************************************************/
+Std_ReturnType Gpio_ClearInterrupt(Gpio_PortType Port, uint8 Mask)
+{
+    if(Port >= GPIO_PORTS_NUM)
+    {
+        return E_NOT_OK;
+    }
+
+    /* Write 1 to clear, the 0 bits have no effect */
+    GPIO_REG(g_PortBase[Port], GPIO_ICR_OFFSET) = Mask;
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Gpio_ReadPort
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Port - GPIO port
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Level of the 8 pins, 0 for an invalid port
+* Description: Function to read all the pins of a port.
+**********************************************************************/
+uint8 Gpio_ReadPort(Gpio_PortType Port)
+{
+    if(Port >= GPIO_PORTS_NUM)
+    {
+        return 0;
+    }
+
+    return GPIO_READ_PINS(g_PortBase[Port], GPIO_ALL_PINS_MASK);
+}
+
+/*********************************************************************
+* Service Name: Gpio_WritePort
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Value - Level of the 8 pins
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pins are written, E_NOT_OK for an invalid port
+* Description: Function to write all the output pins of a port.
+**********************************************************************/
+Std_ReturnType Gpio_WritePort(Gpio_PortType Port, uint8 Value)
+{
+    if(Port >= GPIO_PORTS_NUM)
+    {
+        return E_NOT_OK;
+    }
+
+    GPIO_WRITE_PINS(g_PortBase[Port], GPIO_ALL_PINS_MASK, Value);
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Gpio_ReadPins
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Mask - Pins to read
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Level of the pins of Mask with the other bits 0, 0 for an invalid port
+* Description: Function to read some pins of a port with one load.
+**********************************************************************/
+uint8 Gpio_ReadPins(Gpio_PortType Port, uint8 Mask)
+{
+    if(Port >= GPIO_PORTS_NUM)
+    {
+        return 0;
+    }
+
+    return GPIO_READ_PINS(g_PortBase[Port], Mask);
+}
+
+/*********************************************************************
+* Service Name: Gpio_WritePins
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Mask - Pins to write
+*                  3.Value - Level of the pins, the bits outside Mask are ignored
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pins are written, E_NOT_OK for an invalid port
+* Description: Function to write some pins of a port with one store, the other pins are not changed.
+**********************************************************************/
+Std_ReturnType Gpio_WritePins(Gpio_PortType Port, uint8 Mask, uint8 Value)
+{
+    if(Port >= GPIO_PORTS_NUM)
+    {
+        return E_NOT_OK;
+    }
+
+    GPIO_WRITE_PINS(g_PortBase[Port], Mask, Value);
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Gpio_TogglePins
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Mask - Pins to toggle
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pins are inverted, E_NOT_OK for an invalid port
+* Description: Function to invert some output pins of a port, the other pins are not changed.
+**********************************************************************/
+Std_ReturnType Gpio_TogglePins(Gpio_PortType Port, uint8 Mask)
+{
+    volatile uint32 *Data;
+
+    if(Port >= GPIO_PORTS_NUM)
+    {
+        return E_NOT_OK;
+    }
+
+    Data = &GPIO_DATA_ALIAS(g_PortBase[Port], Mask);
+
+    /* Load and store through the alias of Mask, a write to another pin in between is kept */
+    *Data = ~(*Data);
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Gpio_ReadPin
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Pin - Pin number (0 .. 7)
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: LOGIC_HIGH or LOGIC_LOW, LOGIC_LOW for an invalid port or pin
+* Description: Function to read one pin.
+**********************************************************************/
+uint8 Gpio_ReadPin(Gpio_PortType Port, uint8 Pin)
+{
+    if((Port >= GPIO_PORTS_NUM) || (Pin > 7))
+    {
+        return LOGIC_LOW;
+    }
+
+    return (GPIO_READ_PINS(g_PortBase[Port], 1 << Pin) != 0) ? LOGIC_HIGH : LOGIC_LOW;
+}
+
+/*********************************************************************
+* Service Name: Gpio_WritePin
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Pin - Pin number (0 .. 7)
+*                  3.Level - LOGIC_HIGH or LOGIC_LOW
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pin is written, E_NOT_OK for an invalid port or pin
+* Description: Function to write one output pin with one store.
+**********************************************************************/
+Std_ReturnType Gpio_WritePin(Gpio_PortType Port, uint8 Pin, uint8 Level)
+{
+    if((Port >= GPIO_PORTS_NUM) || (Pin > 7))
+    {
+        return E_NOT_OK;
+    }
+
+    /* All the bits are written, the alias only lets the bit of the pin through */
+    GPIO_WRITE_PINS(g_PortBase[Port], 1 << Pin, (Level == LOGIC_HIGH) ? GPIO_ALL_PINS_MASK : 0);
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Gpio_TogglePin
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Pin - Pin number (0 .. 7)
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pin is inverted, E_NOT_OK for an invalid port or pin
+* Description: Function to invert one output pin.
+**********************************************************************/
+Std_ReturnType Gpio_TogglePin(Gpio_PortType Port, uint8 Pin)
+{
+    if(Pin > 7)
+    {
+        return E_NOT_OK;
+    }
+
+    return Gpio_TogglePins(Port, 1 << Pin);
+}
+
+#if (GPIO_BENCHMARK_ENABLE == TRUE)
+
+/*********************************************************************
+* Service Name: Gpio_Benchmark
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Pin - Output pin toggled by the benchmark (0 .. 7)
+*                  3.a_CoreClockHz - Core clock frequency in Hz
+* Parameters (inout): None
+* Parameters (out): a_Result - Access costs on the APB and AHB apertures
+* Return value: E_OK if the benchmark ran, E_NOT_OK for an invalid port or pin
+* Description: Function to measure the DATA accesses of a configured port on both apertures, the port
+*              is moved back to its selected aperture after. The interrupts are disabled while it runs.
+**********************************************************************/
+Std_ReturnType Gpio_Benchmark(Gpio_PortType Port, uint8 Pin, uint32 a_CoreClockHz, Gpio_BenchmarkType *a_Result)
+{
+    uint32 IntState;
+    uint32 Level;
+
+    if((Port >= GPIO_PORTS_NUM) || (Pin > 7))
+    {
+        return E_NOT_OK;
+    }
+
+    /* No other code may access the port while it moves between the apertures */
+    IntState = _disable_IRQ();
+
+    Level = GPIO_DATA_ALIAS(g_PortBase[Port], 1 << Pin);
+
+    SYSCTL_GPIOHBCTL_REG &= ~(1UL << Port);
+    Data_Sync_Barrier();
+    Gpio_MeasureBus(g_PortApbBase[Port], Pin, a_CoreClockHz, &a_Result->Apb);
+
+    SYSCTL_GPIOHBCTL_REG |= (1UL << Port);
+    Data_Sync_Barrier();
+    Gpio_MeasureBus(g_PortAhbBase[Port], Pin, a_CoreClockHz, &a_Result->Ahb);
+
+#if (GPIO_USE_AHB == FALSE)
+    SYSCTL_GPIOHBCTL_REG &= ~(1UL << Port);
+    Data_Sync_Barrier();
+#endif
+
+    /* Give the pin its level from before the benchmark */
+    GPIO_DATA_ALIAS(g_PortBase[Port], 1 << Pin) = Level;
+
+    _restore_interrupts(IntState);
+
+    return E_OK;
+}
+
+#endif
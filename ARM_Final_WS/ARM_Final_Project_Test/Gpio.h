@@ -0,0 +1,360 @@
+ /******************************************************************************
+ *
+ * Module: GPIO
+ *
+ * File Name: Gpio.h
+ *
+ * Description: header file for the GPIO driver of ports A to F.
+ *
+ *              The pin writes use the address masking of the DATA register: bits 9:2 of the address
+ *              select the pins a store changes, so writing some pins of a port is a single store that
+ *              leaves the other pins untouched. Writers of different pins of the same port never race
+ *              and need no critical section. Reads through the same alias return only the selected
+ *              pins. A toggle reads then writes its own pins, it only races with writers of the same pins.
+ *
+ *              The ports are accessed on the AHB aperture when GPIO_USE_AHB is TRUE, GPIO_PORTx_BASE_ADDRESS
+ *              then follows it. A port is only reachable on its selected aperture, it must be configured
+ *              with Gpio_ConfigPins before any access and the GPIO_PORTx_*_REG registers of
+ *              tm4c123gh6pm_registers.h (APB) must not be used for it.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef GPIO_H_
+#define GPIO_H_
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Access the ports on the Advanced High-Performance Bus instead of the legacy APB when TRUE */
+#ifndef GPIO_USE_AHB
+#define GPIO_USE_AHB                         TRUE
+#endif
+
+/* Gpio_Benchmark compares the APB and AHB accesses when TRUE */
+#ifndef GPIO_BENCHMARK_ENABLE
+#define GPIO_BENCHMARK_ENABLE                FALSE
+#endif
+
+/* Base addresses of the ports on the APB aperture */
+#define GPIO_PORTA_APB_BASE_ADDRESS          0x40004000
+#define GPIO_PORTB_APB_BASE_ADDRESS          0x40005000
+#define GPIO_PORTC_APB_BASE_ADDRESS          0x40006000
+#define GPIO_PORTD_APB_BASE_ADDRESS          0x40007000
+#define GPIO_PORTE_APB_BASE_ADDRESS          0x40024000
+#define GPIO_PORTF_APB_BASE_ADDRESS          0x40025000
+
+/* Base addresses of the ports on the AHB aperture */
+#define GPIO_PORTA_AHB_BASE_ADDRESS          0x40058000
+#define GPIO_PORTB_AHB_BASE_ADDRESS          0x40059000
+#define GPIO_PORTC_AHB_BASE_ADDRESS          0x4005A000
+#define GPIO_PORTD_AHB_BASE_ADDRESS          0x4005B000
+#define GPIO_PORTE_AHB_BASE_ADDRESS          0x4005C000
+#define GPIO_PORTF_AHB_BASE_ADDRESS          0x4005D000
+
+/* Base addresses of the ports on the selected aperture */
+#if (GPIO_USE_AHB == TRUE)
+#define GPIO_PORTA_BASE_ADDRESS              GPIO_PORTA_AHB_BASE_ADDRESS
+#define GPIO_PORTB_BASE_ADDRESS              GPIO_PORTB_AHB_BASE_ADDRESS
+#define GPIO_PORTC_BASE_ADDRESS              GPIO_PORTC_AHB_BASE_ADDRESS
+#define GPIO_PORTD_BASE_ADDRESS              GPIO_PORTD_AHB_BASE_ADDRESS
+#define GPIO_PORTE_BASE_ADDRESS              GPIO_PORTE_AHB_BASE_ADDRESS
+#define GPIO_PORTF_BASE_ADDRESS              GPIO_PORTF_AHB_BASE_ADDRESS
+#else
+#define GPIO_PORTA_BASE_ADDRESS              GPIO_PORTA_APB_BASE_ADDRESS
+#define GPIO_PORTB_BASE_ADDRESS              GPIO_PORTB_APB_BASE_ADDRESS
+#define GPIO_PORTC_BASE_ADDRESS              GPIO_PORTC_APB_BASE_ADDRESS
+#define GPIO_PORTD_BASE_ADDRESS              GPIO_PORTD_APB_BASE_ADDRESS
+#define GPIO_PORTE_BASE_ADDRESS              GPIO_PORTE_APB_BASE_ADDRESS
+#define GPIO_PORTF_BASE_ADDRESS              GPIO_PORTF_APB_BASE_ADDRESS
+#endif
+
+/* Pin masks */
+#define GPIO_PIN0_MASK                       0x01
+#define GPIO_PIN1_MASK                       0x02
+#define GPIO_PIN2_MASK                       0x04
+#define GPIO_PIN3_MASK                       0x08
+#define GPIO_PIN4_MASK                       0x10
+#define GPIO_PIN5_MASK                       0x20
+#define GPIO_PIN6_MASK                       0x40
+#define GPIO_PIN7_MASK                       0x80
+#define GPIO_ALL_PINS_MASK                   0xFF
+
+/* DATA register alias of a port base address that only accesses the pins of MASK */
+#define GPIO_DATA_ALIAS(BASE, MASK)          (*((volatile uint32 *)((BASE) + ((uint32)(MASK) << 2))))
+
+/* Write VALUE to the pins of MASK with one store, for a port and pins known at build time */
+#define GPIO_WRITE_PINS(BASE, MASK, VALUE)   (GPIO_DATA_ALIAS((BASE), (MASK)) = (uint32)(VALUE))
+
+/* Read the pins of MASK, the other bits are 0 */
+#define GPIO_READ_PINS(BASE, MASK)           ((uint8)GPIO_DATA_ALIAS((BASE), (MASK)))
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef enum
+{
+    GPIO_PORTA,
+    GPIO_PORTB,
+    GPIO_PORTC,
+    GPIO_PORTD,
+    GPIO_PORTE,
+    GPIO_PORTF,
+    GPIO_PORTS_NUM
+}Gpio_PortType;
+
+typedef enum
+{
+    GPIO_INPUT,
+    GPIO_OUTPUT
+}Gpio_DirectionType;
+
+typedef enum
+{
+    GPIO_PULL_NONE,
+    GPIO_PULL_UP,
+    GPIO_PULL_DOWN
+}Gpio_PullType;
+
+typedef enum
+{
+    GPIO_EDGE_FALLING,
+    GPIO_EDGE_RISING,
+    GPIO_EDGE_BOTH
+}Gpio_EdgeType;
+
+/* Access costs on one aperture in core cycles, the cycle counter must be enabled by Delay_Init */
+typedef struct
+{
+    uint32 WriteCycles;             /* One store to DATA, averaged over back-to-back stores */
+    uint32 ReadCycles;              /* One load from DATA, averaged over back-to-back loads */
+    uint32 ToggleHz;                /* Highest square wave frequency written by back-to-back stores */
+}Gpio_BusBenchmarkType;
+
+typedef struct
+{
+    Gpio_BusBenchmarkType Apb;
+    Gpio_BusBenchmarkType Ahb;
+}Gpio_BenchmarkType;
+
+/*******************************************************************************
+ *                                Functions Prototypes                          *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Gpio_ConfigPins
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Mask - Pins to be configured
+*                  3.Direction - Input or output
+*                  4.Pull - Internal pull resistor
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pins are configured, E_NOT_OK for an invalid port or the JTAG pins PC0 to PC3
+* Description: Function to enable the clock of the port and configure pins as digital GPIO. The locked
+*              pins PD7 and PF0 are unlocked, the outputs keep their current level.
+**********************************************************************/
+Std_ReturnType Gpio_ConfigPins(Gpio_PortType Port, uint8 Mask, Gpio_DirectionType Direction, Gpio_PullType Pull);
+
+/*********************************************************************
+* Service Name: Gpio_ConfigInterrupt
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Mask - Input pins interrupting the port IRQ
+*                  3.Edge - Edges detected
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the interrupt is configured, E_NOT_OK for an invalid port
+* Description: Function to enable the edge interrupt of pins configured by Gpio_ConfigPins, the port IRQ
+*              is enabled by NVIC_Init.
+**********************************************************************/
+Std_ReturnType Gpio_ConfigInterrupt(Gpio_PortType Port, uint8 Mask, Gpio_EdgeType Edge);
+
+/*********************************************************************
+* Service Name: Gpio_EnableInterruptPin
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Pin - Pin number (0 .. 7)
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pin is changed, E_NOT_OK for an invalid port or pin
+* Description: Function to unmask the interrupt of one pin configured by Gpio_ConfigInterrupt, an edge
+*              latched while it was masked interrupts at once. One store to the bit-band alias.
+**********************************************************************/
+Std_ReturnType Gpio_EnableInterruptPin(Gpio_PortType Port, uint8 Pin);
+
+/*********************************************************************
+* Service Name: Gpio_DisableInterruptPin
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Pin - Pin number (0 .. 7)
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pin is changed, E_NOT_OK for an invalid port or pin
+* Description: Function to mask the interrupt of one pin, its edges are still latched. One store to
+*              the bit-band alias, the other pins of the port are not affected.
+**********************************************************************/
+Std_ReturnType Gpio_DisableInterruptPin(Gpio_PortType Port, uint8 Pin);
+
+/*********************************************************************
+* Service Name: Gpio_GetInterruptStatus
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Port - GPIO port
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pins with a pending enabled interrupt, 0 for an invalid port
+* Description: Function to read the masked interrupt status of a port.
+**********************************************************************/
+uint8 Gpio_GetInterruptStatus(Gpio_PortType Port);
+
+/*********************************************************************
+* Service Name: Gpio_ClearInterrupt
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Mask - Pins to acknowledge
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pins are acknowledged, E_NOT_OK for an invalid port
+* Description: Function to acknowledge the interrupt of pins with one store, the other pins keep theirs.
+**********************************************************************/
+Std_ReturnType Gpio_ClearInterrupt(Gpio_PortType Port, uint8 Mask);
+
+/*********************************************************************
+* Service Name: Gpio_ReadPort
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Port - GPIO port
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Level of the 8 pins, 0 for an invalid port
+* Description: Function to read all the pins of a port.
+**********************************************************************/
+uint8 Gpio_ReadPort(Gpio_PortType Port);
+
+/*********************************************************************
+* Service Name: Gpio_WritePort
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Value - Level of the 8 pins
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pins are written, E_NOT_OK for an invalid port
+* Description: Function to write all the output pins of a port.
+**********************************************************************/
+Std_ReturnType Gpio_WritePort(Gpio_PortType Port, uint8 Value);
+
+/*********************************************************************
+* Service Name: Gpio_ReadPins
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Mask - Pins to read
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Level of the pins of Mask with the other bits 0, 0 for an invalid port
+* Description: Function to read some pins of a port with one load.
+**********************************************************************/
+uint8 Gpio_ReadPins(Gpio_PortType Port, uint8 Mask);
+
+/*********************************************************************
+* Service Name: Gpio_WritePins
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Mask - Pins to write
+*                  3.Value - Level of the pins, the bits outside Mask are ignored
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pins are written, E_NOT_OK for an invalid port
+* Description: Function to write some pins of a port with one store, the other pins are not changed.
+**********************************************************************/
+Std_ReturnType Gpio_WritePins(Gpio_PortType Port, uint8 Mask, uint8 Value);
+
+/*********************************************************************
+* Service Name: Gpio_TogglePins
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Mask - Pins to toggle
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pins are inverted, E_NOT_OK for an invalid port
+* Description: Function to invert some output pins of a port, the other pins are not changed.
+**********************************************************************/
+Std_ReturnType Gpio_TogglePins(Gpio_PortType Port, uint8 Mask);
+
+/*********************************************************************
+* Service Name: Gpio_ReadPin
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Pin - Pin number (0 .. 7)
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: LOGIC_HIGH or LOGIC_LOW, LOGIC_LOW for an invalid port or pin
+* Description: Function to read one pin.
+**********************************************************************/
+uint8 Gpio_ReadPin(Gpio_PortType Port, uint8 Pin);
+
+/*********************************************************************
+* Service Name: Gpio_WritePin
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Pin - Pin number (0 .. 7)
+*                  3.Level - LOGIC_HIGH or LOGIC_LOW
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pin is written, E_NOT_OK for an invalid port or pin
+* Description: Function to write one output pin with one store.
+**********************************************************************/
+Std_ReturnType Gpio_WritePin(Gpio_PortType Port, uint8 Pin, uint8 Level);
+
+/*********************************************************************
+* Service Name: Gpio_TogglePin
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Pin - Pin number (0 .. 7)
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pin is inverted, E_NOT_OK for an invalid port or pin
+* Description: Function to invert one output pin.
+**********************************************************************/
+Std_ReturnType Gpio_TogglePin(Gpio_PortType Port, uint8 Pin);
+
+#if (GPIO_BENCHMARK_ENABLE == TRUE)
+
+/*********************************************************************
+* Service Name: Gpio_Benchmark
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): 1.Port - GPIO port
+*                  2.Pin - Output pin toggled by the benchmark (0 .. 7)
+*                  3.a_CoreClockHz - Core clock frequency in Hz
+* Parameters (inout): None
+* Parameters (out): a_Result - Access costs on the APB and AHB apertures
+* Return value: E_OK if the benchmark ran, E_NOT_OK for an invalid port or pin
+* Description: Function to measure the DATA accesses of a configured port on both apertures, the port
+*              is moved back to its selected aperture after. The interrupts are disabled while it runs.
+**********************************************************************/
+Std_ReturnType Gpio_Benchmark(Gpio_PortType Port, uint8 Pin, uint32 a_CoreClockHz, Gpio_BenchmarkType *a_Result);
+
+#endif
+
+#endif /* GPIO_H_ */
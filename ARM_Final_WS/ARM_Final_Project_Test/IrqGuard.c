@@ -0,0 +1,143 @@
+ /******************************************************************************
+ *
+ * Module: IRQ Guard
+ *
+ * File Name: IrqGuard.c
+ *
+ * Description: Source file for the interrupt storm protection
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "IrqGuard.h"
+#include "NVIC.h"
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Back-off timer call back, runs in the SysTick interrupt */
+static void IrqGuard_BackOffCallBack(void *a_Arg)
+{
+    IrqGuard_Type *Guard = (IrqGuard_Type *)a_Arg;
+
+    /* Drop the activation that was latched while disabled and start a new window */
+    NVIC_ClearPendingIRQ(Guard->IRQ_Num);
+    Guard->WindowStart = SwTimer_GetTicks();
+    Guard->WindowCount = 0;
+    Guard->Masked = FALSE;
+
+    NVIC_EnableIRQ(Guard->IRQ_Num);
+}
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: IrqGuard_Create
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.IRQ_Num - Number of the guarded IRQ from the target vector table
+*                  2.Budget - Activations accepted in one window
+*                  3.WindowTicks - Window length in SysTick ticks
+*                  4.BackOffTicks - Time the IRQ stays disabled after a storm, in SysTick ticks
+* Parameters (inout): Guard - Guard to be initialized
+* Parameters (out): None
+* Return value: E_OK if the guard is created, E_NOT_OK for invalid parameters
+* Description: Function to initialize the guard of one IRQ, SwTimer_Init must be called before.
+**********************************************************************/
+Std_ReturnType IrqGuard_Create(IrqGuard_Type *Guard, uint8 IRQ_Num, uint32 Budget, uint32 WindowTicks,
+                               uint32 BackOffTicks)
+{
+    if((Guard == NULL_PTR) || (IRQ_Num >= NVIC_IRQ_COUNT) || (Budget == 0) || (WindowTicks == 0))
+    {
+        return E_NOT_OK;
+    }
+
+    if(SwTimer_Create(&Guard->BackOffTimer, SWTIMER_ONE_SHOT, BackOffTicks, IrqGuard_BackOffCallBack, Guard) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+
+    Guard->IRQ_Num = IRQ_Num;
+    Guard->Budget = Budget;
+    Guard->WindowTicks = WindowTicks;
+    Guard->WindowStart = SwTimer_GetTicks();
+    Guard->WindowCount = 0;
+    Guard->Masked = FALSE;
+    Guard->Activations = 0;
+    Guard->Storms = 0;
+    Guard->MaxWindowCount = 0;
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: IrqGuard_Activation
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): Guard - Guard of the IRQ
+* Parameters (out): None
+* Return value: TRUE if the activation is within the budget, FALSE if it started a storm
+* Description: Function to be called by the ISR of the guarded IRQ on every activation. When the budget
+*              is exceeded the IRQ is disabled and the back-off timer started, the ISR still has to
+*              acknowledge its peripheral and may skip the rest of its work.
+**********************************************************************/
+boolean IrqGuard_Activation(IrqGuard_Type *Guard)
+{
+    uint32 Now = SwTimer_GetTicks();
+
+    Guard->Activations++;
+
+    if((Now - Guard->WindowStart) >= Guard->WindowTicks)
+    {
+        Guard->WindowStart = Now;
+        Guard->WindowCount = 0;
+    }
+
+    if(++Guard->WindowCount > Guard->MaxWindowCount)
+    {
+        Guard->MaxWindowCount = Guard->WindowCount;
+    }
+
+    if(Guard->WindowCount <= Guard->Budget)
+    {
+        return TRUE;
+    }
+
+    /* Storm: no more activations until the back-off timer expires */
+    NVIC_DisableIRQ(Guard->IRQ_Num);
+    Guard->Masked = TRUE;
+    Guard->Storms++;
+    SwTimer_Start(&Guard->BackOffTimer);
+
+    return FALSE;
+}
+
+/*********************************************************************
+* Service Name: IrqGuard_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Guard - Guard of the IRQ
+* Parameters (inout): None
+* Parameters (out): a_Stats - Copy of the storm statistics
+* Return value: None
+* Description: Function to read the activations and storm counts of one IRQ.
+**********************************************************************/
+void IrqGuard_GetStats(const IrqGuard_Type *Guard, IrqGuard_StatsType *a_Stats)
+{
+    NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    a_Stats->Activations = Guard->Activations;
+    a_Stats->Storms = Guard->Storms;
+    a_Stats->MaxWindowCount = Guard->MaxWindowCount;
+    a_Stats->Masked = Guard->Masked;
+
+    NVIC_ExitCritical(IntState);
+}
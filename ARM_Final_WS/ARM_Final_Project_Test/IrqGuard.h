@@ -0,0 +1,97 @@
+ /******************************************************************************
+ *
+ * Module: IRQ Guard
+ *
+ * File Name: IrqGuard.h
+ *
+ * Description: header file for the interrupt storm protection. The ISR of a guarded IRQ reports every
+ *              activation, an IRQ that exceeds its budget of activations in a window of SysTick ticks
+ *              is disabled in the NVIC and enabled again by a software timer after a back-off time.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef IRQGUARD_H_
+#define IRQGUARD_H_
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "std_types.h"
+#include "SwTimer.h"
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Guard of one IRQ, allocated by the user */
+typedef struct
+{
+    uint8 IRQ_Num;
+    uint32 Budget;                  /* Activations accepted in one window */
+    uint32 WindowTicks;
+    uint32 WindowStart;             /* SwTimer tick of the start of the running window */
+    uint32 WindowCount;             /* Activations in the running window */
+    volatile boolean Masked;        /* The IRQ is disabled until the back-off timer expires */
+    SwTimer_Type BackOffTimer;
+    uint32 Activations;
+    uint32 Storms;                  /* Number of times the IRQ was disabled */
+    uint32 MaxWindowCount;
+}IrqGuard_Type;
+
+typedef struct
+{
+    uint32 Activations;             /* Activations reported, the ones above the budget included */
+    uint32 Storms;                  /* Number of times the IRQ was disabled */
+    uint32 MaxWindowCount;          /* Highest number of activations seen in one window */
+    boolean Masked;                 /* The IRQ is disabled now */
+}IrqGuard_StatsType;
+
+/*******************************************************************************
+ *                                Functions Prototypes                          *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: IrqGuard_Create
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.IRQ_Num - Number of the guarded IRQ from the target vector table
+*                  2.Budget - Activations accepted in one window
+*                  3.WindowTicks - Window length in SysTick ticks
+*                  4.BackOffTicks - Time the IRQ stays disabled after a storm, in SysTick ticks
+* Parameters (inout): Guard - Guard to be initialized
+* Parameters (out): None
+* Return value: E_OK if the guard is created, E_NOT_OK for invalid parameters
+* Description: Function to initialize the guard of one IRQ, SwTimer_Init must be called before.
+**********************************************************************/
+Std_ReturnType IrqGuard_Create(IrqGuard_Type *Guard, uint8 IRQ_Num, uint32 Budget, uint32 WindowTicks,
+                               uint32 BackOffTicks);
+
+/*********************************************************************
+* Service Name: IrqGuard_Activation
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): Guard - Guard of the IRQ
+* Parameters (out): None
+* Return value: TRUE if the activation is within the budget, FALSE if it started a storm
+* Description: Function to be called by the ISR of the guarded IRQ on every activation. When the budget
+*              is exceeded the IRQ is disabled and the back-off timer started, the ISR still has to
+*              acknowledge its peripheral and may skip the rest of its work.
+**********************************************************************/
+boolean IrqGuard_Activation(IrqGuard_Type *Guard);
+
+/*********************************************************************
+* Service Name: IrqGuard_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Guard - Guard of the IRQ
+* Parameters (inout): None
+* Parameters (out): a_Stats - Copy of the storm statistics
+* Return value: None
+* Description: Function to read the activations and storm counts of one IRQ.
+**********************************************************************/
+void IrqGuard_GetStats(const IrqGuard_Type *Guard, IrqGuard_StatsType *a_Stats);
+
+#endif /* IRQGUARD_H_ */
@@ -0,0 +1,266 @@
+ /******************************************************************************
+ *
+ * Module: ISR Profiler
+ *
+ * File Name: IsrProfiler.c
+ *
+ * Description: Source file for the interrupt profiler
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "IsrProfiler.h"
+
+#if (ISR_PROFILER_ENABLE == TRUE)
+
+#include "NVIC.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+static IsrProfiler_StatsType g_Stats[ISR_PROFILER_IDS];
+
+/* Cycle counter value when the IRQ of each ISR was pended by IsrProfiler_Trigger */
+static uint32 g_TriggerCycles[ISR_PROFILER_IDS];
+static volatile boolean g_Triggered[ISR_PROFILER_IDS];
+
+static uint32 g_PairCycles = 0;
+static uint32 g_BiasCycles = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Add one measurement to a distribution */
+static void IsrProfiler_Record(IsrProfiler_HistogramType *Histogram, uint32 Cycles)
+{
+    /* Number of significant bits of Cycles, the count of leading zeros of 0 is 32 */
+    uint32 Bin = 32 - _norm(Cycles);
+
+    if(Bin >= ISR_PROFILER_HISTOGRAM_BINS)
+    {
+        Bin = ISR_PROFILER_HISTOGRAM_BINS - 1;
+    }
+    Histogram->Histogram[Bin]++;
+
+    Histogram->Count++;
+    Histogram->TotalCycles += Cycles;
+    if(Cycles < Histogram->MinCycles)
+    {
+        Histogram->MinCycles = Cycles;
+    }
+    if(Cycles > Histogram->MaxCycles)
+    {
+        Histogram->MaxCycles = Cycles;
+    }
+}
+
+/* Empty a distribution, MinCycles starts at the largest value so the first measurement replaces it */
+static void IsrProfiler_Clear(IsrProfiler_HistogramType *Histogram)
+{
+    uint8 Bin;
+
+    Histogram->Count = 0;
+    Histogram->MinCycles = 0xFFFFFFFFUL;
+    Histogram->MaxCycles = 0;
+    Histogram->MeanCycles = 0;
+    Histogram->TotalCycles = 0;
+    for(Bin = 0; Bin < ISR_PROFILER_HISTOGRAM_BINS; Bin++)
+    {
+        Histogram->Histogram[Bin] = 0;
+    }
+}
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: IsrProfiler_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to measure the profiler overhead and clear the statistics. Delay_Init must be
+*              called before.
+**********************************************************************/
+void IsrProfiler_Init(void)
+{
+    uint32 IntState;
+    uint32 EnterCycles;
+
+    IsrProfiler_Reset();
+
+    /* Empty ENTER/EXIT pair on the first ID, with the interrupts disabled so it is not preempted */
+    IntState = _disable_IRQ();
+    EnterCycles = DWT_CYCCNT_REG;
+    IsrProfiler_Exit((IsrProfiler_IdType)0, IsrProfiler_Enter((IsrProfiler_IdType)0));
+    g_PairCycles = DWT_CYCCNT_REG - EnterCycles;
+    _restore_interrupts(IntState);
+
+    g_BiasCycles = g_Stats[0].Execution.MinCycles;
+
+    IsrProfiler_Reset();
+}
+
+/*********************************************************************
+* Service Name: IsrProfiler_Enter
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Id - Profiled ISR
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Cycle counter value at the start of the ISR
+* Description: Function called by ISR_PROFILER_ENTER, it records the latency of a triggered interrupt.
+**********************************************************************/
+uint32 IsrProfiler_Enter(IsrProfiler_IdType Id)
+{
+    uint32 EnterCycles = DWT_CYCCNT_REG;
+
+    if(g_Triggered[Id])
+    {
+        g_Triggered[Id] = FALSE;
+        IsrProfiler_Record(&g_Stats[Id].Latency, EnterCycles - g_TriggerCycles[Id]);
+
+        /* Start the execution time after the latency update */
+        EnterCycles = DWT_CYCCNT_REG;
+    }
+
+    return EnterCycles;
+}
+
+/*********************************************************************
+* Service Name: IsrProfiler_Exit
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): 1.Id - Profiled ISR
+*                  2.a_EnterCycles - Value returned by IsrProfiler_Enter
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function called by ISR_PROFILER_EXIT to record the execution time of the ISR.
+**********************************************************************/
+void IsrProfiler_Exit(IsrProfiler_IdType Id, uint32 a_EnterCycles)
+{
+    IsrProfiler_Record(&g_Stats[Id].Execution, DWT_CYCCNT_REG - a_EnterCycles);
+}
+
+/*********************************************************************
+* Service Name: IsrProfiler_Trigger
+* Sync/Async: Asynchronous
+* Reentrancy: non reentrant
+* Parameters (in): 1.Id - Profiled ISR
+*                  2.IRQ_Num - IRQ served by this ISR
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to pend the IRQ from software and measure the time until its ISR starts.
+*              The IRQ must be enabled, the latency is recorded by the next ISR_PROFILER_ENTER.
+**********************************************************************/
+void IsrProfiler_Trigger(IsrProfiler_IdType Id, uint8 IRQ_Num)
+{
+    g_TriggerCycles[Id] = DWT_CYCCNT_REG;
+    g_Triggered[Id] = TRUE;
+    NVIC_SetPendingIRQ(IRQ_Num);
+}
+
+/*********************************************************************
+* Service Name: IsrProfiler_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Id - Profiled ISR
+* Parameters (inout): None
+* Parameters (out): a_Stats - Copy of the measurements with the mean values filled
+* Return value: None
+* Description: Function to read the measurements of one ISR.
+**********************************************************************/
+void IsrProfiler_GetStats(IsrProfiler_IdType Id, IsrProfiler_StatsType *a_Stats)
+{
+    /* The profiled ISRs may run above the services ceiling, the copy is made with all of them masked */
+    uint32 IntState = _disable_IRQ();
+    *a_Stats = g_Stats[Id];
+    _restore_interrupts(IntState);
+
+    if(a_Stats->Execution.Count != 0)
+    {
+        a_Stats->Execution.MeanCycles = (uint32)(a_Stats->Execution.TotalCycles / a_Stats->Execution.Count);
+    }
+    if(a_Stats->Latency.Count != 0)
+    {
+        a_Stats->Latency.MeanCycles = (uint32)(a_Stats->Latency.TotalCycles / a_Stats->Latency.Count);
+    }
+}
+
+/*********************************************************************
+* Service Name: IsrProfiler_GetOverhead
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): 1.a_PairCycles - Cycles added to an ISR by an ENTER/EXIT pair
+*                   2.a_BiasCycles - Cycles of the pair included in every execution time
+* Return value: None
+* Description: Function to read the profiler overhead measured by IsrProfiler_Init.
+**********************************************************************/
+void IsrProfiler_GetOverhead(uint32 *a_PairCycles, uint32 *a_BiasCycles)
+{
+    *a_PairCycles = g_PairCycles;
+    *a_BiasCycles = g_BiasCycles;
+}
+
+/*********************************************************************
+* Service Name: IsrProfiler_Dump
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): DumpFunc - Function receiving the measurements of every profiled ISR
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to report the measurements of all the ISRs, e.g. to print them.
+**********************************************************************/
+void IsrProfiler_Dump(IsrProfiler_DumpFuncType DumpFunc)
+{
+    IsrProfiler_StatsType Stats;
+    uint8 Id;
+
+    for(Id = 0; Id < ISR_PROFILER_IDS; Id++)
+    {
+        IsrProfiler_GetStats((IsrProfiler_IdType)Id, &Stats);
+        DumpFunc((IsrProfiler_IdType)Id, &Stats);
+    }
+}
+
+/*********************************************************************
+* Service Name: IsrProfiler_Reset
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clear the measurements of all the ISRs.
+**********************************************************************/
+void IsrProfiler_Reset(void)
+{
+    uint8 Id;
+    uint32 IntState;
+
+    for(Id = 0; Id < ISR_PROFILER_IDS; Id++)
+    {
+        IntState = _disable_IRQ();
+        IsrProfiler_Clear(&g_Stats[Id].Execution);
+        IsrProfiler_Clear(&g_Stats[Id].Latency);
+        g_Triggered[Id] = FALSE;
+        _restore_interrupts(IntState);
+    }
+}
+
+#endif /* ISR_PROFILER_ENABLE */
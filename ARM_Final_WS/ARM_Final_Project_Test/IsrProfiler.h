@@ -0,0 +1,198 @@
+ /******************************************************************************
+ *
+ * Module: ISR Profiler
+ *
+ * File Name: IsrProfiler.h
+ *
+ * Description: header file for the interrupt profiler. A profiled ISR calls ISR_PROFILER_ENTER first
+ *              and ISR_PROFILER_EXIT last, the profiler keeps the execution time and the pending to
+ *              entry latency of every ISR in core cycles (min, max, mean and a log2 histogram).
+ *              Nothing is compiled when ISR_PROFILER_ENABLE is FALSE.
+ *
+ *              Enabled overhead: ISR_PROFILER_ENTER is one call reading the cycle counter and
+ *              ISR_PROFILER_EXIT one call updating the statistics. The cycles of an empty ENTER/EXIT
+ *              pair and the part of it included in every execution time are measured by
+ *              IsrProfiler_Init and read with IsrProfiler_GetOverhead.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef ISRPROFILER_H_
+#define ISRPROFILER_H_
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* The profiler is compiled in when TRUE, the ISR_PROFILER_ENTER/EXIT macros expand to nothing when FALSE */
+#ifndef ISR_PROFILER_ENABLE
+#define ISR_PROFILER_ENABLE                  FALSE
+#endif
+
+/* Histogram bin n counts the measurements of n significant bits (2^(n-1) .. 2^n - 1 cycles),
+ * bin 0 counts the 0 cycle measurements and the last bin everything longer */
+#define ISR_PROFILER_HISTOGRAM_BINS          16
+
+#if (ISR_PROFILER_ENABLE == TRUE)
+
+/* Start of the profiled part of an ISR, to be placed after the declarations of the ISR */
+#define ISR_PROFILER_ENTER(ID)               uint32 IsrProfiler_EnterCycles = IsrProfiler_Enter(ID)
+
+/* End of the profiled part of an ISR started with ISR_PROFILER_ENTER */
+#define ISR_PROFILER_EXIT(ID)                IsrProfiler_Exit((ID), IsrProfiler_EnterCycles)
+
+#else
+
+#define ISR_PROFILER_ENTER(ID)
+#define ISR_PROFILER_EXIT(ID)
+
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Profiled ISRs, add one ID per ISR before ISR_PROFILER_IDS */
+typedef enum
+{
+    ISR_PROFILER_SYSTICK,
+    ISR_PROFILER_GPIO_PORTF,
+    ISR_PROFILER_IDS
+}IsrProfiler_IdType;
+
+/* Distribution of one measurement in core cycles */
+typedef struct
+{
+    uint32 Count;
+    uint32 MinCycles;
+    uint32 MaxCycles;
+    uint32 MeanCycles;              /* Filled by IsrProfiler_GetStats */
+    uint64 TotalCycles;
+    uint32 Histogram[ISR_PROFILER_HISTOGRAM_BINS];
+}IsrProfiler_HistogramType;
+
+/* Measurements of one ISR, the cycle counter must be enabled by Delay_Init */
+typedef struct
+{
+    IsrProfiler_HistogramType Execution;    /* From ISR_PROFILER_ENTER to ISR_PROFILER_EXIT */
+    IsrProfiler_HistogramType Latency;      /* From IsrProfiler_Trigger to ISR_PROFILER_ENTER */
+}IsrProfiler_StatsType;
+
+typedef void (*IsrProfiler_DumpFuncType)(IsrProfiler_IdType Id, const IsrProfiler_StatsType *a_Stats);
+
+#if (ISR_PROFILER_ENABLE == TRUE)
+
+/*******************************************************************************
+ *                                Functions Prototypes                          *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: IsrProfiler_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to measure the profiler overhead and clear the statistics. Delay_Init must be
+*              called before.
+**********************************************************************/
+void IsrProfiler_Init(void);
+
+/*********************************************************************
+* Service Name: IsrProfiler_Enter
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Id - Profiled ISR
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Cycle counter value at the start of the ISR
+* Description: Function called by ISR_PROFILER_ENTER, it records the latency of a triggered interrupt.
+**********************************************************************/
+uint32 IsrProfiler_Enter(IsrProfiler_IdType Id);
+
+/*********************************************************************
+* Service Name: IsrProfiler_Exit
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): 1.Id - Profiled ISR
+*                  2.a_EnterCycles - Value returned by IsrProfiler_Enter
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function called by ISR_PROFILER_EXIT to record the execution time of the ISR.
+**********************************************************************/
+void IsrProfiler_Exit(IsrProfiler_IdType Id, uint32 a_EnterCycles);
+
+/*********************************************************************
+* Service Name: IsrProfiler_Trigger
+* Sync/Async: Asynchronous
+* Reentrancy: non reentrant
+* Parameters (in): 1.Id - Profiled ISR
+*                  2.IRQ_Num - IRQ served by this ISR
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to pend the IRQ from software and measure the time until its ISR starts.
+*              The IRQ must be enabled, the latency is recorded by the next ISR_PROFILER_ENTER.
+**********************************************************************/
+void IsrProfiler_Trigger(IsrProfiler_IdType Id, uint8 IRQ_Num);
+
+/*********************************************************************
+* Service Name: IsrProfiler_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Id - Profiled ISR
+* Parameters (inout): None
+* Parameters (out): a_Stats - Copy of the measurements with the mean values filled
+* Return value: None
+* Description: Function to read the measurements of one ISR.
+**********************************************************************/
+void IsrProfiler_GetStats(IsrProfiler_IdType Id, IsrProfiler_StatsType *a_Stats);
+
+/*********************************************************************
+* Service Name: IsrProfiler_GetOverhead
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): 1.a_PairCycles - Cycles added to an ISR by an ENTER/EXIT pair
+*                   2.a_BiasCycles - Cycles of the pair included in every execution time
+* Return value: None
+* Description: Function to read the profiler overhead measured by IsrProfiler_Init.
+**********************************************************************/
+void IsrProfiler_GetOverhead(uint32 *a_PairCycles, uint32 *a_BiasCycles);
+
+/*********************************************************************
+* Service Name: IsrProfiler_Dump
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): DumpFunc - Function receiving the measurements of every profiled ISR
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to report the measurements of all the ISRs, e.g. to print them.
+**********************************************************************/
+void IsrProfiler_Dump(IsrProfiler_DumpFuncType DumpFunc);
+
+/*********************************************************************
+* Service Name: IsrProfiler_Reset
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clear the measurements of all the ISRs.
+**********************************************************************/
+void IsrProfiler_Reset(void);
+
+#endif
+
+#endif /* ISRPROFILER_H_ */
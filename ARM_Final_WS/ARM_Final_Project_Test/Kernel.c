@@ -0,0 +1,401 @@
+ /******************************************************************************
+ *
+ * Module: Kernel
+ *
+ * File Name: Kernel.c
+ *
+ * Description: Source file for the preemptive priority kernel
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "Kernel.h"
+#include "NVIC.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* PENDSVSET bit in the Interrupt Control and State register, writing 0 to the other bits has no effect */
+#define KERNEL_PENDSVSET_MASK                0x10000000
+
+/* Bit of a priority in the ready mask, priority 0 is bit 31 so the count of leading zeros
+ * of the ready mask is the highest ready priority */
+#define KERNEL_READY_BIT(PRIORITY)           (0x80000000UL >> (PRIORITY))
+
+/* Initial thread frame: xPSR with the Thumb bit and EXC_RETURN to thread mode on the PSP
+ * with a basic (no FP) frame */
+#define KERNEL_INITIAL_XPSR                  0x01000000
+#define KERNEL_INITIAL_EXC_RETURN            0xFFFFFFFD
+
+#if (KERNEL_PRIORITIES > 32)
+#error "KERNEL_PRIORITIES must be at most 32"
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Context switch time updated by the PendSV handler, the layout is used by Kernel_PendSV.asm */
+typedef struct
+{
+    uint32 Count;
+    uint32 LastCycles;
+    uint32 MaxCycles;
+}Kernel_SwitchTimeType;
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+/* Running thread and thread to switch to, used by Kernel_PendSV.asm. g_KernelNext is set by
+ * Kernel_Start and g_KernelCurrent by the first context switch */
+Kernel_ThreadType *volatile g_KernelCurrent = NULL_PTR;
+Kernel_ThreadType *volatile g_KernelNext = NULL_PTR;
+
+Kernel_SwitchTimeType g_KernelSwitchTime;
+
+static Kernel_ThreadType *g_KernelThreads[KERNEL_PRIORITIES];
+
+/* Bit set for every priority with a ready thread */
+static volatile uint32 g_KernelReadyMask = 0;
+
+static uint32 g_LastSignalLatency = 0;
+static uint32 g_MaxSignalLatency = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Pend a context switch if the highest ready thread is not the running one.
+ * Called inside a critical section */
+static void Kernel_Schedule(void)
+{
+    Kernel_ThreadType *Next;
+
+    if(g_KernelNext == NULL_PTR)
+    {
+        /* Not started yet */
+        return;
+    }
+
+    Next = g_KernelThreads[_norm(g_KernelReadyMask)];
+    g_KernelNext = Next;
+    if(Next != g_KernelCurrent)
+    {
+        NVIC_SYSTEM_INTCTRL = KERNEL_PENDSVSET_MASK;
+    }
+}
+
+/* Remove the running thread from the ready mask and switch to the next one once the
+ * critical section ends. Called inside a critical section */
+static void Kernel_Block(Kernel_ThreadType *Thread, Kernel_ThreadStateType State)
+{
+    Thread->State = State;
+    g_KernelReadyMask &= ~KERNEL_READY_BIT(Thread->Priority);
+    Kernel_Schedule();
+}
+
+/* Make a blocked thread ready. Called inside a critical section */
+static void Kernel_MakeReady(Kernel_ThreadType *Thread)
+{
+    Thread->State = KERNEL_THREAD_READY;
+    g_KernelReadyMask |= KERNEL_READY_BIT(Thread->Priority);
+    Kernel_Schedule();
+}
+
+/* Sleep timer call back, runs in the SysTick interrupt */
+static void Kernel_SleepCallBack(void *a_Arg)
+{
+    Kernel_ThreadType *Thread = (Kernel_ThreadType *)a_Arg;
+    NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    if(Thread->State == KERNEL_THREAD_SLEEPING)
+    {
+        Kernel_MakeReady(Thread);
+    }
+
+    NVIC_ExitCritical(IntState);
+}
+
+/* Return address of every thread function, a thread that returns is never scheduled again */
+static void Kernel_ThreadExit(void)
+{
+    NVIC_CriticalStateType IntState;
+
+    /* Blocking the idle thread would leave the ready mask empty and Kernel_Schedule would read
+     * g_KernelThreads[_norm(0)], past the end of the table. Its return is a bug: trap on an undefined
+     * instruction so the fault capture records where it happened */
+    if(g_KernelCurrent->Priority == KERNEL_IDLE_PRIORITY)
+    {
+        __asm(" UDF #0");
+    }
+
+    IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+    Kernel_Block(g_KernelCurrent, KERNEL_THREAD_EXITED);
+    NVIC_ExitCritical(IntState);
+
+    while(1);
+}
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Kernel_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clear the thread table. SwTimer_Init must be called before, the PendSV
+*              priority is set by NVIC_Init (NVIC_CFG_EXCEPTION_TABLE).
+**********************************************************************/
+void Kernel_Init(void)
+{
+    uint8 Priority;
+
+    for(Priority = 0; Priority < KERNEL_PRIORITIES; Priority++)
+    {
+        g_KernelThreads[Priority] = NULL_PTR;
+    }
+    g_KernelReadyMask = 0;
+    g_KernelCurrent = NULL_PTR;
+    g_KernelNext = NULL_PTR;
+}
+
+/*********************************************************************
+* Service Name: Kernel_CreateThread
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Priority - Thread priority (0 .. KERNEL_IDLE_PRIORITY), one thread per priority
+*                  2.ThreadFunc - Thread function
+*                  3.Arg - User argument passed to the thread function
+*                  4.Stack - Thread stack
+*                  5.StackWords - Size of the stack in words (at least KERNEL_MIN_STACK_WORDS)
+* Parameters (inout): Thread - Thread control block to be initialized
+* Parameters (out): None
+* Return value: E_OK if the thread is created ready, E_NOT_OK for invalid parameters or a used priority
+* Description: Function to create a ready thread, it preempts the caller if it has a higher priority.
+**********************************************************************/
+Std_ReturnType Kernel_CreateThread(Kernel_ThreadType *Thread, uint8 Priority, Kernel_ThreadFuncType ThreadFunc,
+                                   void *Arg, uint32 *Stack, uint32 StackWords)
+{
+    uint32 *StackPointer;
+    uint8 Register;
+    NVIC_CriticalStateType IntState;
+
+    if((Thread == NULL_PTR) || (ThreadFunc == NULL_PTR) || (Stack == NULL_PTR) ||
+       (Priority >= KERNEL_PRIORITIES) || (StackWords < KERNEL_MIN_STACK_WORDS))
+    {
+        return E_NOT_OK;
+    }
+
+    /* The exception frame must be 8-byte aligned */
+    StackPointer = (uint32 *)((uint32)(Stack + StackWords) & ~0x07UL);
+
+    /* Frame stacked by the hardware: xPSR, PC, LR, R12, R3 - R0 */
+    *(--StackPointer) = KERNEL_INITIAL_XPSR;
+    *(--StackPointer) = (uint32)ThreadFunc & ~0x01UL;
+    *(--StackPointer) = (uint32)Kernel_ThreadExit;
+    *(--StackPointer) = 0;                      /* R12 */
+    *(--StackPointer) = 0;                      /* R3 */
+    *(--StackPointer) = 0;                      /* R2 */
+    *(--StackPointer) = 0;                      /* R1 */
+    *(--StackPointer) = (uint32)Arg;            /* R0 */
+
+    /* Frame saved by the PendSV handler: EXC_RETURN, R11 - R4 */
+    *(--StackPointer) = KERNEL_INITIAL_EXC_RETURN;
+    for(Register = 0; Register < 8; Register++)
+    {
+        *(--StackPointer) = 0;
+    }
+
+    Thread->StackPointer = StackPointer;
+    Thread->Priority = Priority;
+    Thread->SignalPending = FALSE;
+    Thread->SignalCycles = 0;
+    SwTimer_Create(&Thread->SleepTimer, SWTIMER_ONE_SHOT, 1, Kernel_SleepCallBack, Thread);
+
+    IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    if(g_KernelThreads[Priority] != NULL_PTR)
+    {
+        NVIC_ExitCritical(IntState);
+        return E_NOT_OK;
+    }
+    g_KernelThreads[Priority] = Thread;
+    Kernel_MakeReady(Thread);
+
+    NVIC_ExitCritical(IntState);
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Kernel_Start
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_NOT_OK if there is no idle thread, otherwise the function does not return
+* Description: Function to enable the interrupts and switch to the highest priority thread. The main
+*              stack is used by the exception handlers from then on.
+**********************************************************************/
+Std_ReturnType Kernel_Start(void)
+{
+    if(g_KernelThreads[KERNEL_IDLE_PRIORITY] == NULL_PTR)
+    {
+        return E_NOT_OK;
+    }
+
+    Disable_Exceptions();
+
+    /* The PendSV handler skips saving the context while g_KernelCurrent is NULL */
+    g_KernelNext = g_KernelThreads[_norm(g_KernelReadyMask)];
+    NVIC_SYSTEM_INTCTRL = KERNEL_PENDSVSET_MASK;
+
+    Enable_Exceptions();
+
+    /* Not reached, PendSV returns to the first thread */
+    while(1);
+}
+
+/*********************************************************************
+* Service Name: Kernel_Sleep
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Ticks - Number of SysTick ticks to sleep
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK after the sleep, E_NOT_OK if called from the idle thread or for 0 ticks
+* Description: Function to block the running thread for the given number of ticks.
+**********************************************************************/
+Std_ReturnType Kernel_Sleep(uint32 Ticks)
+{
+    Kernel_ThreadType *Thread;
+    NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    Thread = g_KernelCurrent;
+    if((Thread == NULL_PTR) || (Thread->Priority == KERNEL_IDLE_PRIORITY) || (Ticks == 0) ||
+       (SwTimer_Restart(&Thread->SleepTimer, Ticks) != E_OK))
+    {
+        NVIC_ExitCritical(IntState);
+        return E_NOT_OK;
+    }
+
+    Kernel_Block(Thread, KERNEL_THREAD_SLEEPING);
+
+    /* PendSV switches away as soon as the interrupts are enabled */
+    NVIC_ExitCritical(IntState);
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Kernel_WaitSignal
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK when signaled, E_NOT_OK if called from the idle thread
+* Description: Function to block the running thread until Kernel_Signal is called for it. A signal sent
+*              while the thread was not waiting is kept and the next wait returns at once.
+**********************************************************************/
+Std_ReturnType Kernel_WaitSignal(void)
+{
+    Kernel_ThreadType *Thread;
+    uint32 Latency;
+    NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    Thread = g_KernelCurrent;
+    if((Thread == NULL_PTR) || (Thread->Priority == KERNEL_IDLE_PRIORITY))
+    {
+        NVIC_ExitCritical(IntState);
+        return E_NOT_OK;
+    }
+
+    if(Thread->SignalPending)
+    {
+        Thread->SignalPending = FALSE;
+        NVIC_ExitCritical(IntState);
+        return E_OK;
+    }
+
+    Kernel_Block(Thread, KERNEL_THREAD_WAITING);
+
+    /* PendSV switches away as soon as the interrupts are enabled */
+    NVIC_ExitCritical(IntState);
+
+    /* Signaled and running again */
+    Latency = DWT_CYCCNT_REG - Thread->SignalCycles;
+
+    IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+    g_LastSignalLatency = Latency;
+    if(Latency > g_MaxSignalLatency)
+    {
+        g_MaxSignalLatency = Latency;
+    }
+    NVIC_ExitCritical(IntState);
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Kernel_Signal
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): Thread - Thread to be signaled
+* Parameters (out): None
+* Return value: None
+* Description: Function to wake a thread blocked in Kernel_WaitSignal, can be called from ISRs.
+**********************************************************************/
+void Kernel_Signal(Kernel_ThreadType *Thread)
+{
+    NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    if(Thread->State == KERNEL_THREAD_WAITING)
+    {
+        Thread->SignalCycles = DWT_CYCCNT_REG;
+        Kernel_MakeReady(Thread);
+    }
+    else
+    {
+        Thread->SignalPending = TRUE;
+    }
+
+    NVIC_ExitCritical(IntState);
+}
+
+/*********************************************************************
+* Service Name: Kernel_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Stats - Copy of the measurements
+* Return value: None
+* Description: Function to read the context switch and interrupt-to-thread latency measurements.
+**********************************************************************/
+void Kernel_GetStats(Kernel_StatsType *a_Stats)
+{
+    NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    a_Stats->ContextSwitches = g_KernelSwitchTime.Count;
+    a_Stats->LastSwitchCycles = g_KernelSwitchTime.LastCycles;
+    a_Stats->MaxSwitchCycles = g_KernelSwitchTime.MaxCycles;
+    a_Stats->LastSignalLatencyCycles = g_LastSignalLatency;
+    a_Stats->MaxSignalLatencyCycles = g_MaxSignalLatency;
+
+    NVIC_ExitCritical(IntState);
+}
@@ -0,0 +1,170 @@
+ /******************************************************************************
+ *
+ * Module: Kernel
+ *
+ * File Name: Kernel.h
+ *
+ * Description: header file for the preemptive priority kernel. Each priority holds one thread,
+ *              the highest ready priority always runs. The context switch is done by the PendSV
+ *              handler in Kernel_PendSV.asm and the thread sleeps are software timers driven
+ *              by the SysTick tick.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef KERNEL_H_
+#define KERNEL_H_
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "std_types.h"
+#include "SwTimer.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Number of thread priorities, 0 is the highest priority */
+#define KERNEL_PRIORITIES                    32
+
+/* The thread at the lowest priority is the idle thread, it must always be ready. Its function must not
+ * return, the return traps into the fault capture */
+#define KERNEL_IDLE_PRIORITY                 (KERNEL_PRIORITIES - 1)
+
+/* Smallest accepted thread stack: the initial frame (17 words) plus room for the worst case
+ * exception frame with the FP registers (26 words) and the saved S16-S31 (16 words) */
+#define KERNEL_MIN_STACK_WORDS               96
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef void (*Kernel_ThreadFuncType)(void *a_Arg);
+
+typedef enum
+{
+    KERNEL_THREAD_READY,
+    KERNEL_THREAD_WAITING,          /* Blocked in Kernel_WaitSignal */
+    KERNEL_THREAD_SLEEPING,         /* Blocked in Kernel_Sleep */
+    KERNEL_THREAD_EXITED            /* The thread function returned */
+}Kernel_ThreadStateType;
+
+/* Thread control block, allocated by the user */
+typedef struct
+{
+    uint32 *StackPointer;           /* Saved PSP, must stay the first field (used by Kernel_PendSV.asm) */
+    uint8 Priority;
+    volatile Kernel_ThreadStateType State;
+    volatile boolean SignalPending; /* Kernel_Signal called while the thread was not waiting */
+    uint32 SignalCycles;            /* Cycle counter value when the thread was signaled */
+    SwTimer_Type SleepTimer;
+}Kernel_ThreadType;
+
+/* Measurements in core cycles, the cycle counter must be enabled by Delay_Init */
+typedef struct
+{
+    uint32 ContextSwitches;
+    uint32 LastSwitchCycles;        /* PendSV time from the deferred work end to the exception return */
+    uint32 MaxSwitchCycles;
+    uint32 LastSignalLatencyCycles; /* From Kernel_Signal in an ISR to the signaled thread running */
+    uint32 MaxSignalLatencyCycles;
+}Kernel_StatsType;
+
+/*******************************************************************************
+ *                                Functions Prototypes                          *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Kernel_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clear the thread table. SwTimer_Init must be called before, the PendSV
+*              priority is set by NVIC_Init (NVIC_CFG_EXCEPTION_TABLE).
+**********************************************************************/
+void Kernel_Init(void);
+
+/*********************************************************************
+* Service Name: Kernel_CreateThread
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Priority - Thread priority (0 .. KERNEL_IDLE_PRIORITY), one thread per priority
+*                  2.ThreadFunc - Thread function
+*                  3.Arg - User argument passed to the thread function
+*                  4.Stack - Thread stack
+*                  5.StackWords - Size of the stack in words (at least KERNEL_MIN_STACK_WORDS)
+* Parameters (inout): Thread - Thread control block to be initialized
+* Parameters (out): None
+* Return value: E_OK if the thread is created ready, E_NOT_OK for invalid parameters or a used priority
+* Description: Function to create a ready thread, it preempts the caller if it has a higher priority.
+**********************************************************************/
+Std_ReturnType Kernel_CreateThread(Kernel_ThreadType *Thread, uint8 Priority, Kernel_ThreadFuncType ThreadFunc,
+                                   void *Arg, uint32 *Stack, uint32 StackWords);
+
+/*********************************************************************
+* Service Name: Kernel_Start
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_NOT_OK if there is no idle thread, otherwise the function does not return
+* Description: Function to enable the interrupts and switch to the highest priority thread. The main
+*              stack is used by the exception handlers from then on.
+**********************************************************************/
+Std_ReturnType Kernel_Start(void);
+
+/*********************************************************************
+* Service Name: Kernel_Sleep
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Ticks - Number of SysTick ticks to sleep
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK after the sleep, E_NOT_OK if called from the idle thread or for 0 ticks
+* Description: Function to block the running thread for the given number of ticks.
+**********************************************************************/
+Std_ReturnType Kernel_Sleep(uint32 Ticks);
+
+/*********************************************************************
+* Service Name: Kernel_WaitSignal
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK when signaled, E_NOT_OK if called from the idle thread
+* Description: Function to block the running thread until Kernel_Signal is called for it. A signal sent
+*              while the thread was not waiting is kept and the next wait returns at once.
+**********************************************************************/
+Std_ReturnType Kernel_WaitSignal(void);
+
+/*********************************************************************
+* Service Name: Kernel_Signal
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): Thread - Thread to be signaled
+* Parameters (out): None
+* Return value: None
+* Description: Function to wake a thread blocked in Kernel_WaitSignal, can be called from ISRs.
+**********************************************************************/
+void Kernel_Signal(Kernel_ThreadType *Thread);
+
+/*********************************************************************
+* Service Name: Kernel_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Stats - Copy of the measurements
+* Return value: None
+* Description: Function to read the context switch and interrupt-to-thread latency measurements.
+**********************************************************************/
+void Kernel_GetStats(Kernel_StatsType *a_Stats);
+
+#endif /* KERNEL_H_ */
@@ -0,0 +1,118 @@
+;******************************************************************************
+;
+; Module: Kernel
+;
+; File Name: Kernel_PendSV.asm
+;
+; Description: PendSV exception handler. It runs the deferred work, then switches from
+;              g_KernelCurrent to g_KernelNext. The callee saved registers R4 - R11 and
+;              EXC_RETURN are saved on the thread stack, S16 - S31 only when the thread has an
+;              active FP context (EXC_RETURN bit 4 clear), the hardware lazy stacking takes
+;              care of S0 - S15 and FPSCR.
+;
+;              Switch time: figures computed from the Cortex-M4 instruction timings for the
+;              instructions below (LDR 2 cycles, STR 1, LDM/STM 1 + N, VLDM/VSTM 1 + N, a skipped
+;              IT instruction 1), zero flash wait states. They are NOT measured, the measured values
+;              are read with Kernel_GetStats on the board.
+;              - Window recorded in g_KernelSwitchTime (switch start to end time reads):
+;                about 45 cycles between two threads without an FP context, about 77 cycles when
+;                both threads have one (S16 - S31 saved and restored, 16 cycles each way).
+;              - Not in the window: exception entry (12 cycles, 6 when tail-chained), the call
+;                of Deferred_Run with an empty queue, exception return (10 cycles) and the lazy
+;                stacking of S0 - S15 and FPSCR (17 cycles) when the switched-out thread used the FPU.
+;
+; Author: Karima Mahmoud
+;
+;******************************************************************************
+
+        .thumb
+        .text
+        .align  4
+
+        .global PendSV_Handler
+        .global Deferred_Run
+        .global g_KernelCurrent
+        .global g_KernelNext
+        .global g_KernelSwitchTime
+
+; Addresses used by the handler
+KernelCurrentAddr   .word   g_KernelCurrent
+KernelNextAddr      .word   g_KernelNext
+KernelSwitchAddr    .word   g_KernelSwitchTime
+DwtCyccntAddr       .word   0xE0001004
+
+;******************************************************************************
+; Service Name: PendSV_Handler
+; Sync/Async: Asynchronous
+; Reentrancy: non reentrant
+; Parameters (in): None
+; Parameters (inout): None
+; Parameters (out): None
+; Return value: None
+; Description: Handler for PendSV exception used to execute the deferred work and to switch
+;              the running thread.
+;******************************************************************************
+        .thumbfunc PendSV_Handler
+PendSV_Handler: .asmfunc
+
+        ; Deferred work first, R0 keeps the main stack 8-byte aligned
+        PUSH    {R0, LR}
+        BL      Deferred_Run
+        POP     {R0, LR}
+
+        ; R2 = switch start time, R3 = cycle counter address, both kept until the end
+        LDR     R3, DwtCyccntAddr
+        LDR     R2, [R3]
+
+        ; R0 = running thread, R1 = next thread, swapped with interrupts disabled
+        CPSID   I
+        LDR     R12, KernelNextAddr
+        LDR     R1, [R12]
+        LDR     R12, KernelCurrentAddr
+        LDR     R0, [R12]
+        CMP     R0, R1
+        BEQ     PendSV_NoSwitch
+        STR     R1, [R12]
+        CPSIE   I
+
+        ; No context to save on the first switch from main
+        CBZ     R0, PendSV_Restore
+
+        ; Save the running thread context on its stack
+        MRS     R12, PSP
+        TST     LR, #0x10
+        IT      EQ
+        VSTMDBEQ R12!, {S16-S31}
+        STMDB   R12!, {R4-R11, LR}
+        STR     R12, [R0]
+
+PendSV_Restore:
+        ; Restore the next thread context from its stack
+        LDR     R12, [R1]
+        LDMIA   R12!, {R4-R11, LR}
+        TST     LR, #0x10
+        IT      EQ
+        VLDMIAEQ R12!, {S16-S31}
+        MSR     PSP, R12
+
+        ; g_KernelSwitchTime: Count, LastCycles, MaxCycles
+        LDR     R1, [R3]
+        SUBS    R1, R1, R2
+        LDR     R12, KernelSwitchAddr
+        LDR     R0, [R12]
+        ADDS    R0, R0, #1
+        STR     R0, [R12]
+        STR     R1, [R12, #4]
+        LDR     R0, [R12, #8]
+        CMP     R1, R0
+        IT      HI
+        STRHI   R1, [R12, #8]
+        BX      LR
+
+PendSV_NoSwitch:
+        CPSIE   I
+        BX      LR
+
+        .endasmfunc
+
+        .end
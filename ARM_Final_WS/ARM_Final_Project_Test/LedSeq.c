@@ -0,0 +1,241 @@
+ /******************************************************************************
+ *
+ * Module: LED Sequencer
+ *
+ * File Name: LedSeq.c
+ *
+ * Description: Source file for the table-driven LED sequence engine
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "LedSeq.h"
+#include "SwTimer.h"
+#include "NVIC.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Bit of a layer in the playing mask, the count of leading zeros gives the highest playing layer */
+#define LEDSEQ_LAYER_BIT(LAYER)              (1UL << (LAYER))
+
+#if (LEDSEQ_LAYERS > 32)
+#error "LEDSEQ_LAYERS must be at most 32"
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef struct
+{
+    const LedSeq_PatternType *Pattern;  /* NULL_PTR when stopped */
+    SwTimer_Type Timer;                 /* Expires at the end of the current step */
+    uint8 Layer;
+    uint8 Step;
+    uint8 Played;                       /* Repetitions completed */
+}LedSeq_LayerType;
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+static LedSeq_LayerType g_Layers[LEDSEQ_LAYERS];
+
+/* Layers playing a pattern */
+static uint32 g_PlayingMask = 0;
+
+static Gpio_PortType g_Port;
+static uint8 g_Mask;
+static uint32 g_TickPeriodMs;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Ticks of a step, at least one */
+static uint32 LedSeq_StepTicks(const LedSeq_StepType *Step)
+{
+    uint32 Ticks = (Step->DurationMs + g_TickPeriodMs - 1) / g_TickPeriodMs;
+
+    return (Ticks != 0) ? Ticks : 1;
+}
+
+/* Drive the pins from the highest playing layer. Called inside a critical section */
+static void LedSeq_Output(void)
+{
+    const LedSeq_LayerType *Top;
+
+    if(g_PlayingMask == 0)
+    {
+        Gpio_WritePins(g_Port, g_Mask, 0);
+    }
+    else
+    {
+        Top = &g_Layers[31 - _norm(g_PlayingMask)];
+        Gpio_WritePins(g_Port, g_Mask, Top->Pattern->Steps[Top->Step].Pins);
+    }
+}
+
+/* Step timer call back, runs in the SysTick interrupt at the end of a step of a layer */
+static void LedSeq_StepCallBack(void *a_Arg)
+{
+    LedSeq_LayerType *Layer = (LedSeq_LayerType *)a_Arg;
+    const LedSeq_PatternType *Pattern = Layer->Pattern;
+
+    if(Pattern == NULL_PTR)
+    {
+        return;
+    }
+
+    if(++Layer->Step == Pattern->StepCount)
+    {
+        Layer->Step = 0;
+        if((Pattern->Repeat != LEDSEQ_REPEAT_FOREVER) && (++Layer->Played >= Pattern->Repeat))
+        {
+            /* Last repetition over, the layer below shows again */
+            Layer->Pattern = NULL_PTR;
+            g_PlayingMask &= ~LEDSEQ_LAYER_BIT(Layer->Layer);
+            LedSeq_Output();
+            return;
+        }
+    }
+
+    SwTimer_Restart(&Layer->Timer, LedSeq_StepTicks(&Pattern->Steps[Layer->Step]));
+
+    /* A hidden layer only keeps its timing */
+    if((g_PlayingMask >> Layer->Layer) == 1)
+    {
+        LedSeq_Output();
+    }
+}
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: LedSeq_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): 1.Port - Port of the LEDs
+*                  2.Mask - LED pins driven by the sequencer, configured as outputs
+*                  3.TickPeriodMs - Period of the SysTick ticks driving the software timers
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the sequencer is initialized, E_NOT_OK for invalid parameters
+* Description: Function to stop all the layers and turn off the LEDs, SwTimer_Init must be called before.
+**********************************************************************/
+Std_ReturnType LedSeq_Init(Gpio_PortType Port, uint8 Mask, uint32 TickPeriodMs)
+{
+    uint8 Layer;
+
+    if((Port >= GPIO_PORTS_NUM) || (TickPeriodMs == 0))
+    {
+        return E_NOT_OK;
+    }
+
+    g_Port = Port;
+    g_Mask = Mask;
+    g_TickPeriodMs = TickPeriodMs;
+    g_PlayingMask = 0;
+
+    for(Layer = 0; Layer < LEDSEQ_LAYERS; Layer++)
+    {
+        g_Layers[Layer].Pattern = NULL_PTR;
+        g_Layers[Layer].Layer = Layer;
+        SwTimer_Create(&g_Layers[Layer].Timer, SWTIMER_ONE_SHOT, 1, LedSeq_StepCallBack, &g_Layers[Layer]);
+    }
+
+    LedSeq_Output();
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: LedSeq_Play
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Layer - Layer playing the pattern (0 .. LEDSEQ_LAYERS - 1)
+*                  2.Pattern - Pattern to be played from its first step
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pattern is started, E_NOT_OK for invalid parameters
+* Description: Function to start a pattern on a layer, replacing the one it was playing. The layer stops
+*              by itself after the last repetition.
+**********************************************************************/
+Std_ReturnType LedSeq_Play(uint8 Layer, const LedSeq_PatternType *Pattern)
+{
+    LedSeq_LayerType *Entry;
+    NVIC_CriticalStateType IntState;
+
+    if((Layer >= LEDSEQ_LAYERS) || (Pattern == NULL_PTR) || (Pattern->StepCount == 0))
+    {
+        return E_NOT_OK;
+    }
+
+    Entry = &g_Layers[Layer];
+
+    /* The step call back runs at the ceiling and sees the layer either stopped or restarted */
+    IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    Entry->Pattern = Pattern;
+    Entry->Step = 0;
+    Entry->Played = 0;
+    g_PlayingMask |= LEDSEQ_LAYER_BIT(Layer);
+    SwTimer_Restart(&Entry->Timer, LedSeq_StepTicks(&Pattern->Steps[0]));
+    LedSeq_Output();
+
+    NVIC_ExitCritical(IntState);
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: LedSeq_Stop
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Layer - Layer to be stopped (0 .. LEDSEQ_LAYERS - 1)
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to stop the pattern of a layer, the next playing layer drives the LEDs.
+**********************************************************************/
+void LedSeq_Stop(uint8 Layer)
+{
+    NVIC_CriticalStateType IntState;
+
+    if(Layer >= LEDSEQ_LAYERS)
+    {
+        return;
+    }
+
+    IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    SwTimer_Stop(&g_Layers[Layer].Timer);
+    g_Layers[Layer].Pattern = NULL_PTR;
+    g_PlayingMask &= ~LEDSEQ_LAYER_BIT(Layer);
+    LedSeq_Output();
+
+    NVIC_ExitCritical(IntState);
+}
+
+/*********************************************************************
+* Service Name: LedSeq_GetPattern
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Layer - Layer (0 .. LEDSEQ_LAYERS - 1)
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pattern played by the layer, NULL_PTR if it is stopped
+* Description: Function to get the pattern of a layer.
+**********************************************************************/
+const LedSeq_PatternType *LedSeq_GetPattern(uint8 Layer)
+{
+    return (Layer < LEDSEQ_LAYERS) ? g_Layers[Layer].Pattern : NULL_PTR;
+}
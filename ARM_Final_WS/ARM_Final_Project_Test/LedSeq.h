@@ -0,0 +1,113 @@
+ /******************************************************************************
+ *
+ * Module: LED Sequencer
+ *
+ * File Name: LedSeq.h
+ *
+ * Description: header file for the table-driven LED sequence engine. A pattern is a const table of
+ *              steps (level of the LED pins and duration) played a number of times or forever. Each
+ *              layer plays one pattern, the highest layer playing a pattern drives the pins so an
+ *              overlay (an alarm) hides the base pattern until it ends or is stopped, the hidden
+ *              layers keep their timing.
+ *
+ *              Every layer owns a one-shot software timer armed with the duration of its current
+ *              step, the engine only runs at step boundaries (constant work) and the ticks between
+ *              them are skipped by the timing wheel and the tickless idle.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef LEDSEQ_H_
+#define LEDSEQ_H_
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "std_types.h"
+#include "Gpio.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Number of layers, layer 0 has the lowest priority */
+#define LEDSEQ_LAYERS                        2
+
+/* Repeat count of a pattern played until it is stopped */
+#define LEDSEQ_REPEAT_FOREVER                0
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef struct
+{
+    uint8 Pins;                     /* Level of the sequencer pins during the step */
+    uint32 DurationMs;              /* Rounded up to the tick period, at least one tick */
+}LedSeq_StepType;
+
+typedef struct
+{
+    const LedSeq_StepType *Steps;
+    uint8 StepCount;
+    uint8 Repeat;                   /* Number of times the steps are played, LEDSEQ_REPEAT_FOREVER */
+}LedSeq_PatternType;
+
+/*******************************************************************************
+ *                                Functions Prototypes                          *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: LedSeq_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): 1.Port - Port of the LEDs
+*                  2.Mask - LED pins driven by the sequencer, configured as outputs
+*                  3.TickPeriodMs - Period of the SysTick ticks driving the software timers
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the sequencer is initialized, E_NOT_OK for invalid parameters
+* Description: Function to stop all the layers and turn off the LEDs, SwTimer_Init must be called before.
+**********************************************************************/
+Std_ReturnType LedSeq_Init(Gpio_PortType Port, uint8 Mask, uint32 TickPeriodMs);
+
+/*********************************************************************
+* Service Name: LedSeq_Play
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Layer - Layer playing the pattern (0 .. LEDSEQ_LAYERS - 1)
+*                  2.Pattern - Pattern to be played from its first step
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the pattern is started, E_NOT_OK for invalid parameters
+* Description: Function to start a pattern on a layer, replacing the one it was playing. The layer stops
+*              by itself after the last repetition.
+**********************************************************************/
+Std_ReturnType LedSeq_Play(uint8 Layer, const LedSeq_PatternType *Pattern);
+
+/*********************************************************************
+* Service Name: LedSeq_Stop
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Layer - Layer to be stopped (0 .. LEDSEQ_LAYERS - 1)
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to stop the pattern of a layer, the next playing layer drives the LEDs.
+**********************************************************************/
+void LedSeq_Stop(uint8 Layer);
+
+/*********************************************************************
+* Service Name: LedSeq_GetPattern
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Layer - Layer (0 .. LEDSEQ_LAYERS - 1)
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pattern played by the layer, NULL_PTR if it is stopped
+* Description: Function to get the pattern of a layer.
+**********************************************************************/
+const LedSeq_PatternType *LedSeq_GetPattern(uint8 Layer);
+
+#endif /* LEDSEQ_H_ */
@@ -17,116 +17,442 @@
 #include "tm4c123gh6pm_registers.h"
 
 /*******************************************************************************
- *                               Functions Definitions                         *
+ *                               Global Variables                              *
  *******************************************************************************/
 
-/*********************************************************************
-* Service Name: NVIC_EnableIRQ
-* Sync/Async: Synchronous
-* Reentrancy: reentrant
-* Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
-* Parameters (inout): None
-* Parameters (out): None
-* Return value: None
-* Description: Function to enable Interrupt request for specific IRQ
-**********************************************************************/
-void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num)
+/* RAM vector table, the linker places .vtable at the start of the SRAM */
+#pragma DATA_SECTION(g_RamVectors, ".vtable")
+#pragma DATA_ALIGN(g_RamVectors, 1024)   /* NVIC_VECTOR_TABLE_ALIGNMENT */
+static NVIC_HandlerType g_RamVectors[NVIC_VECTOR_COUNT];
+
+/* Vector number of every NVIC_ExceptionType, 0 for the ones that cannot be installed */
+static const uint8 g_ExceptionVectors[] =
+{
+    0,      /* EXCEPTION_RESET_TYPE */
+    2,      /* EXCEPTION_NMI_TYPE */
+    3,      /* EXCEPTION_HARD_FAULT_TYPE */
+    4,      /* EXCEPTION_MEM_FAULT_TYPE */
+    5,      /* EXCEPTION_BUS_FAULT_TYPE */
+    6,      /* EXCEPTION_USAGE_FAULT_TYPE */
+    11,     /* EXCEPTION_SVC_TYPE */
+    12,     /* EXCEPTION_DEBUG_MONITOR_TYPE */
+    14,     /* EXCEPTION_PEND_SV_TYPE */
+    15      /* EXCEPTION_SYSTICK_TYPE */
+};
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+#if (NVIC_BENCHMARK_ENABLE == TRUE)
+/* PENDSVSET bit in the Interrupt Control and State register, writing 0 to the other bits has no effect */
+#define NVIC_BENCHMARK_PENDSVSET_MASK        0x10000000
+
+/* NVIC_EnableIRQ before the bank indexing, kept to be measured by NVIC_Benchmark */
+static void NVIC_LegacyEnableIRQ(NVIC_IRQType IRQ_Num)
 {
     switch(IRQ_Num)
     {
-    case 0 ... 31: /* In case of IRQs with numbers from 0 to 31 */
-        /* Enable the IRQ on NVIC_EN0_REG based on IRQ_Num function argument */
+    case 0 ... 31:
         NVIC_EN0_REG |= (1<<IRQ_Num);
         break;
-    case 32 ... 63: /* In case of IRQs with numbers from 32 to 63 */
-        /* Enable the IRQ on NVIC_EN1_REG based on IRQ_Num function argument */
+    case 32 ... 63:
         NVIC_EN1_REG |= (1<<(IRQ_Num & 0x1F));
         break;
-    case 64 ... 95: /* In case of IRQs with numbers from 64 to 95 */
-        /* Enable the IRQ on NVIC_EN2_REG based on IRQ_Num function argument */
+    case 64 ... 95:
         NVIC_EN2_REG |= (1<<(IRQ_Num & 0x1F));
         break;
-    case 96 ... 127: /* In case of IRQs with numbers from 96 to 127 */
-        /* Enable the IRQ on NVIC_EN3_REG based on IRQ_Num function argument */
+    case 96 ... 127:
         NVIC_EN3_REG |= (1<<(IRQ_Num & 0x1F));
         break;
-    case 128 ... 138: /* In case of IRQs with numbers from 128 to 138 */
-        /* Enable the IRQ on NVIC_EN4_REG based on IRQ_Num function argument */
+    case 128 ... 138:
         NVIC_EN4_REG |= (1<<(IRQ_Num & 0x1F));
         break;
     }
 }
 
-/*********************************************************************
-* Service Name: NVIC_DisableIRQ
-* Sync/Async: Synchronous
-* Reentrancy: reentrant
-* Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
-* Parameters (inout): None
-* Parameters (out): None
-* Return value: None
-* Description: Function to disable Interrupt request for specific IRQ
-**********************************************************************/
-void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num)
+/* NVIC_DisableIRQ before the bank indexing, kept to be measured by NVIC_Benchmark. The read of
+ * NVIC_DISn_REG returns the enabled IRQs, so it disables all of them in the bank */
+static void NVIC_LegacyDisableIRQ(NVIC_IRQType IRQ_Num)
 {
     switch(IRQ_Num)
     {
-    case 0 ... 31: /* In case of IRQs with numbers from 0 to 31 */
-        /* Disable the IRQ on NVIC_DIS0_REG based on IRQ_Num function argument */
+    case 0 ... 31:
         NVIC_DIS0_REG |= (1<<IRQ_Num);
         break;
-    case 32 ... 63: /* In case of IRQs with numbers from 32 to 63 */
-        /* Disable the IRQ on NVIC_DIS1_REG based on IRQ_Num function argument */
+    case 32 ... 63:
         NVIC_DIS1_REG |= (1<<(IRQ_Num & 0x1F));
         break;
-    case 64 ... 95: /* In case of IRQs with numbers from 64 to 95 */
-        /* Disable the IRQ on NVIC_DIS2_REG based on IRQ_Num function argument */
+    case 64 ... 95:
         NVIC_DIS2_REG |= (1<<(IRQ_Num & 0x1F));
         break;
-    case 96 ... 127: /* In case of IRQs with numbers from 96 to 127 */
-        /* Disable the IRQ on NVIC_DIS3_REG based on IRQ_Num function argument */
+    case 96 ... 127:
         NVIC_DIS3_REG |= (1<<(IRQ_Num & 0x1F));
         break;
-    case 128 ... 138: /* In case of IRQs with numbers from 128 to 138 */
-        /* Disable the IRQ on NVIC_DIS4_REG based on IRQ_Num function argument */
+    case 128 ... 138:
         NVIC_DIS4_REG |= (1<<(IRQ_Num & 0x1F));
         break;
     }
 }
 
+/* Shortest round trip of a PendSV exception from thread mode with the VTOR at TABLE: pend it, let
+ * it be taken and returned from, mask the interrupts again. The cost of the same sequence without
+ * the exception (OVERHEAD) is removed */
+static uint32 NVIC_MeasureVectorEntry(uint32 Table, uint32 Overhead)
+{
+    uint32 Shortest = 0xFFFFFFFFUL;
+    uint32 Start;
+    uint32 Cycles;
+    uint8 Run;
+
+    NVIC_SYSTEM_VTABLE = Table;
+    Data_Sync_Barrier();
+    Instruction_Sync_Barrier();
+
+    for(Run = 0; Run < NVIC_BENCHMARK_RUNS; Run++)
+    {
+        Start = DWT_CYCCNT_REG;
+        NVIC_SYSTEM_INTCTRL = NVIC_BENCHMARK_PENDSVSET_MASK;
+        Enable_Exceptions();
+        Disable_Exceptions();
+        Cycles = DWT_CYCCNT_REG - Start - Overhead;
+        if(Cycles < Shortest)
+        {
+            Shortest = Cycles;
+        }
+    }
+
+    return Shortest;
+}
+
+/* Shortest of NVIC_BENCHMARK_RUNS calls of SERVICE(IRQ_NUM) into CYCLES, the cost of reading the
+ * cycle counter (OVERHEAD) removed */
+#define NVIC_MEASURE_CALL(SERVICE, IRQ_NUM, OVERHEAD, CYCLES)                           \
+    do                                                                                  \
+    {                                                                                   \
+        uint8 Run_;                                                                     \
+        (CYCLES) = 0xFFFFFFFFUL;                                                        \
+        for(Run_ = 0; Run_ < NVIC_BENCHMARK_RUNS; Run_++)                               \
+        {                                                                               \
+            uint32 Start_ = DWT_CYCCNT_REG;                                             \
+            uint32 Cycles_;                                                             \
+            SERVICE(IRQ_NUM);                                                           \
+            Cycles_ = DWT_CYCCNT_REG - Start_ - (OVERHEAD);                             \
+            if(Cycles_ < (CYCLES))                                                      \
+            {                                                                           \
+                (CYCLES) = Cycles_;                                                     \
+            }                                                                           \
+        }                                                                               \
+    } while(0)
+#endif
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
 /*********************************************************************
-* Service Name: NVIC_SetPriorityIRQ
+* Service Name: NVIC_Init
 * Sync/Async: Synchronous
 * Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to apply the interrupt map of NVIC_Cfg.h: installs the IRQ handlers, sets the
+*              IRQ priorities with one byte write per IRQ, sets the exception priorities then enables
+*              the IRQs with one write per NVIC_ENn_REG used. The IRQs and exceptions missing from the
+*              tables keep their priorities. To be called once at boot, when the handlers are ready to run.
+**********************************************************************/
+void NVIC_Init(void)
+{
+    NVIC_IRQMaskType Enable_Mask = {{0}};
+    const NVIC_IRQConfigType *Config_PTR;
+    uint8 Entry;
+
+    NVIC_RelocateVectorTable();
+
+    for(Entry = 0; Entry < NVIC_IRQConfigCount; Entry++)
+    {
+        Config_PTR = &NVIC_IRQConfig[Entry];
+
+        g_RamVectors[NVIC_IRQ_VECTOR_OFFSET + Config_PTR->IRQ_Num] = Config_PTR->Handler;
+
+        /* Own byte of the IRQ, the IRQs sharing its NVIC_PRIn_REG are not touched. The IRQ is
+         * still disabled, the new priority is in place before it is enabled below */
+        NVIC_IRQ_PRI_BYTE(Config_PTR->IRQ_Num) = (uint8)(Config_PTR->Priority << NVIC_PRIORITY_BITS_SHIFT);
+
+        if(Config_PTR->Enable)
+        {
+            NVIC_IRQ_MASK_ADD(Enable_Mask, Config_PTR->IRQ_Num);
+        }
+    }
+
+    /* The handlers are in place before the first IRQ can use them */
+    Data_Sync_Barrier();
+
+    for(Entry = 0; Entry < NVIC_ExceptionConfigCount; Entry++)
+    {
+        NVIC_SetPriorityException(NVIC_ExceptionConfig[Entry].Exception_Num, NVIC_ExceptionConfig[Entry].Priority);
+    }
+
+    NVIC_EnableIRQMask(&Enable_Mask);
+}
+
+/*********************************************************************
+* Service Name: NVIC_EnableIRQ
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to enable Interrupt request for specific IRQ (below NVIC_IRQ_COUNT)
+**********************************************************************/
+void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num)
+{
+    /* Set the IRQ bit in its NVIC_ENn_REG, the other IRQs are not affected by the 0 bits */
+    NVIC_IRQ_REG(NVIC_EN_BASE_ADDRESS, IRQ_Num) = NVIC_IRQ_BIT(IRQ_Num);
+}
+
+/*********************************************************************
+* Service Name: NVIC_DisableIRQ
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to disable Interrupt request for specific IRQ (below NVIC_IRQ_COUNT),
+*              the IRQ is not taken anymore when the function returns
+**********************************************************************/
+void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num)
+{
+    /* Set the IRQ bit in its NVIC_DISn_REG, the other IRQs are not affected by the 0 bits */
+    NVIC_IRQ_REG(NVIC_DIS_BASE_ADDRESS, IRQ_Num) = NVIC_IRQ_BIT(IRQ_Num);
+
+    /* Complete the write before returning so the IRQ cannot be taken after this point */
+    Data_Sync_Barrier();
+    Instruction_Sync_Barrier();
+}
+
+/*********************************************************************
+* Service Name: NVIC_IsEnabledIRQ
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: TRUE if the IRQ is enabled, FALSE otherwise
+* Description: Function to check whether specific IRQ is enabled
+**********************************************************************/
+boolean NVIC_IsEnabledIRQ(NVIC_IRQType IRQ_Num)
+{
+    return (NVIC_IRQ_REG(NVIC_EN_BASE_ADDRESS, IRQ_Num) >> (IRQ_Num & 0x1F)) & 0x01;
+}
+
+/*********************************************************************
+* Service Name: NVIC_SetPendingIRQ
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to trigger specific IRQ by software
+**********************************************************************/
+void NVIC_SetPendingIRQ(NVIC_IRQType IRQ_Num)
+{
+    NVIC_IRQ_REG(NVIC_PEND_BASE_ADDRESS, IRQ_Num) = NVIC_IRQ_BIT(IRQ_Num);
+}
+
+/*********************************************************************
+* Service Name: NVIC_ClearPendingIRQ
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to remove the pending state of specific IRQ
+**********************************************************************/
+void NVIC_ClearPendingIRQ(NVIC_IRQType IRQ_Num)
+{
+    NVIC_IRQ_REG(NVIC_UNPEND_BASE_ADDRESS, IRQ_Num) = NVIC_IRQ_BIT(IRQ_Num);
+}
+
+/*********************************************************************
+* Service Name: NVIC_IsPendingIRQ
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: TRUE if the IRQ is pending, FALSE otherwise
+* Description: Function to check whether specific IRQ is pending
+**********************************************************************/
+boolean NVIC_IsPendingIRQ(NVIC_IRQType IRQ_Num)
+{
+    return (NVIC_IRQ_REG(NVIC_PEND_BASE_ADDRESS, IRQ_Num) >> (IRQ_Num & 0x1F)) & 0x01;
+}
+
+/*********************************************************************
+* Service Name: NVIC_IsActiveIRQ
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: TRUE if the IRQ handler is running or preempted, FALSE otherwise
+* Description: Function to check whether specific IRQ is active
+**********************************************************************/
+boolean NVIC_IsActiveIRQ(NVIC_IRQType IRQ_Num)
+{
+    return (NVIC_IRQ_REG(NVIC_ACTIVE_BASE_ADDRESS, IRQ_Num) >> (IRQ_Num & 0x1F)) & 0x01;
+}
+
+/*********************************************************************
+* Service Name: NVIC_EnableIRQMask
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Mask - Set of IRQs to be enabled
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to enable a set of IRQs with one store per register bank
+**********************************************************************/
+void NVIC_EnableIRQMask(const NVIC_IRQMaskType *Mask)
+{
+    volatile uint32 *En_Reg_PTR = (volatile uint32 *)NVIC_EN_BASE_ADDRESS;
+    uint8 Bank;
+
+    for(Bank = 0; Bank < NVIC_IRQ_BANKS; Bank++)
+    {
+        /* Writing 0 bits has no effect, the empty banks need no test */
+        En_Reg_PTR[Bank] = Mask->Bank[Bank];
+    }
+}
+
+/*********************************************************************
+* Service Name: NVIC_DisableIRQMask
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Mask - Set of IRQs to be disabled
+* Parameters (inout): None
+* Parameters (out): Previous - IRQs of the set that were enabled, may be NULL_PTR
+* Return value: None
+* Description: Function to disable a set of IRQs with one store per register bank. Passing Previous to
+*              NVIC_EnableIRQMask later enables again only the IRQs this call disabled.
+**********************************************************************/
+void NVIC_DisableIRQMask(const NVIC_IRQMaskType *Mask, NVIC_IRQMaskType *Previous)
+{
+    volatile uint32 *En_Reg_PTR = (volatile uint32 *)NVIC_EN_BASE_ADDRESS;
+    volatile uint32 *Dis_Reg_PTR = (volatile uint32 *)NVIC_DIS_BASE_ADDRESS;
+    uint8 Bank;
+
+    for(Bank = 0; Bank < NVIC_IRQ_BANKS; Bank++)
+    {
+        if(Previous != NULL_PTR)
+        {
+            Previous->Bank[Bank] = En_Reg_PTR[Bank] & Mask->Bank[Bank];
+        }
+        Dis_Reg_PTR[Bank] = Mask->Bank[Bank];
+    }
+
+    Data_Sync_Barrier();
+    Instruction_Sync_Barrier();
+}
+
+/*********************************************************************
+* Service Name: NVIC_SetPriorityIRQ
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
 * Parameters (in): 1.IRQ_Num - Number of the IRQ from the target vector table
-*                  2.IRQ_Priority - The required Priority for the IRQ
+*                  2.IRQ_Priority - The required Priority for the IRQ (0 .. 7)
 * Parameters (inout): None
 * Parameters (out): None
 * Return value: None
-* Description: Function to set the priority value for specific IRQ.
+* Description: Function to set the priority value for specific IRQ, the other IRQs are not affected.
 **********************************************************************/
 void NVIC_SetPriorityIRQ(NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType IRQ_Priority)
 {
-    /* Pointer to uint32 to point to the required Priority Register (NVIC_PRIn_REG) */
-    volatile uint32 *Pri_Reg_PTR = NULL_PTR;
-    uint8 Pri_Mask = 0;
-    /* Variable to hold the bits position of the priority number */
-    volatile uint8 Pri_Bits_Pos = 0;
+    /* Each IRQ has its own byte in the NVIC_PRIn_REG registers, the priority is in its 3 upper bits */
+    NVIC_IRQ_PRI_BYTE(IRQ_Num) = (uint8)(IRQ_Priority << NVIC_PRIORITY_BITS_SHIFT);
+}
 
-    /* Equation to calculate the address of the required priority register based on the IRQ_Num */
-    Pri_Reg_PTR = (volatile uint32 *)(NVIC_PRI_BASE_ADDRESS + ((IRQ_Num / 4) * 4));
+/*********************************************************************
+* Service Name: NVIC_GetPriorityIRQ
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Priority of the IRQ (0 .. 7)
+* Description: Function to get the priority value of specific IRQ.
+**********************************************************************/
+NVIC_IRQPriorityType NVIC_GetPriorityIRQ(NVIC_IRQType IRQ_Num)
+{
+    return (NVIC_IRQPriorityType)(NVIC_IRQ_PRI_BYTE(IRQ_Num) >> NVIC_PRIORITY_BITS_SHIFT);
+}
+
+/*********************************************************************
+* Service Name: NVIC_SetPriorityGrouping
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Group - Split of the priority bits into preemption priority and sub-priority
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the PRIGROUP field, to be called once before the priorities are set.
+**********************************************************************/
+void NVIC_SetPriorityGrouping(NVIC_PriorityGroupType Group)
+{
+    /* The register ignores writes without the key, the other fields are written back unchanged.
+     * The key reads as another value so it is removed with the upper half-word */
+    NVIC_SYSTEM_APINT = NVIC_APINT_VECTKEY | (NVIC_SYSTEM_APINT & 0x0000FFFF & ~(NVIC_APINT_PRIGROUP_MASK))
+                        | ((uint32)Group << NVIC_APINT_PRIGROUP_BITS_POS);
+}
+
+/*********************************************************************
+* Service Name: NVIC_GetPriorityGrouping
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Split of the priority bits into preemption priority and sub-priority
+* Description: Function to get the PRIGROUP field, PRIGROUP values below 4 are reported as
+*              NVIC_PRIORITY_GROUP_3_0 since they all give 3 preemption bits on this device.
+**********************************************************************/
+NVIC_PriorityGroupType NVIC_GetPriorityGrouping(void)
+{
+    uint32 Group = (NVIC_SYSTEM_APINT & NVIC_APINT_PRIGROUP_MASK) >> NVIC_APINT_PRIGROUP_BITS_POS;
 
-    /* The priority bit positions has a fixed starting numbers 5  - 7, 13 - 15, 21 - 23, 29 - 31
-     *                                                         00101   01101    10101    11101
-     * The Least Significant 3 bits are the same (0x05) and the remaining two bits are numbers from 0 to 3
-     * The Least Significant two Bits of the IRQ_NUM are numbers from 0 to 3
-     * So with this two bits shifted left by 3 and insert the number (0x05), we have the required position */
-    Pri_Bits_Pos = ((IRQ_Num & 0x03)<<3) | 0x05;
+    if(Group < NVIC_PRIORITY_GROUP_3_0)
+    {
+        return NVIC_PRIORITY_GROUP_3_0;
+    }
+    return (NVIC_PriorityGroupType)Group;
+}
 
-    Pri_Mask = ~(0x07<<Pri_Bits_Pos);
+/*********************************************************************
+* Service Name: NVIC_EncodePriority
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Preempt - Preemption priority, limited to the bits of the current grouping
+*                  2.Sub - Sub-priority, limited to the bits of the current grouping
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Priority (0 .. 7) to be passed to NVIC_SetPriorityIRQ or NVIC_SetPriorityException
+* Description: Function to build a priority from its preemption and sub-priority parts.
+**********************************************************************/
+NVIC_IRQPriorityType NVIC_EncodePriority(uint8 Preempt, uint8 Sub)
+{
+    /* Number of sub-priority bits: 0 for NVIC_PRIORITY_GROUP_3_0 up to 3 for NVIC_PRIORITY_GROUP_0_3 */
+    uint8 Sub_Bits = (uint8)(NVIC_GetPriorityGrouping() - NVIC_PRIORITY_GROUP_3_0);
+    uint8 Preempt_Mask = (uint8)((1 << (NVIC_PRIORITY_BITS - Sub_Bits)) - 1);
+    uint8 Sub_Mask = (uint8)((1 << Sub_Bits) - 1);
 
-    /* Set the required Priority for the required IRQ */
-    (*Pri_Reg_PTR) = ((*Pri_Reg_PTR) & Pri_Mask) | (IRQ_Priority<<Pri_Bits_Pos);
+    return (NVIC_IRQPriorityType)(((Preempt & Preempt_Mask) << Sub_Bits) | (Sub & Sub_Mask));
 }
 
 /*********************************************************************
@@ -196,39 +522,230 @@ void NVIC_DisableException(NVIC_ExceptionType Exception_Num)
 * Parameters (inout): None
 * Parameters (out): None
 * Return value: None
-* Description: Function to set the priority value for specific IRQ.
+* Description: Function to set the priority value for specific ARM system or fault exception,
+*              the other exceptions are not affected.
 **********************************************************************/
 void NVIC_SetPriorityException(NVIC_ExceptionType Exception_Num, NVIC_ExceptionPriorityType Exception_Priority)
 {
-    switch(Exception_Num)
+    /* Reset, NMI and Hard Fault have fixed priorities */
+    if((Exception_Num >= EXCEPTION_MEM_FAULT_TYPE) && (Exception_Num <= EXCEPTION_SYSTICK_TYPE))
     {
-    case EXCEPTION_MEM_FAULT_TYPE: /* In case of MemManagement Fault */
-        /* Set priority of MemManagement Fault as required in Exception_Priority function argument */
-        NVIC_SYSTEM_PRI1_REG = (NVIC_SYSTEM_PRI1_REG & MEM_FAULT_PRIORITY_MASK) | (Exception_Priority<<MEM_FAULT_PRIORITY_BITS_POS);
-        break;
-    case EXCEPTION_BUS_FAULT_TYPE: /* In case of Bus Fault */
-        /* Set priority of Bus Fault as required in Exception_Priority function argument */
-        NVIC_SYSTEM_PRI1_REG = (NVIC_SYSTEM_PRI1_REG & BUS_FAULT_PRIORITY_MASK) | (Exception_Priority<<BUS_FAULT_PRIORITY_BITS_POS);
-        break;
-    case EXCEPTION_USAGE_FAULT_TYPE: /* In case of Usage Fault */
-        /* Set priority of Usage Fault as required in Exception_Priority function argument */
-        NVIC_SYSTEM_PRI1_REG = (NVIC_SYSTEM_PRI1_REG & USAGE_FAULT_PRIORITY_MASK) | (Exception_Priority<<USAGE_FAULT_PRIORITY_BITS_POS);
-        break;
-    case EXCEPTION_SVC_TYPE: /* In case of SVC Exception */
-        /* Set priority of SVC Exception as required in Exception_Priority function argument */
-        NVIC_SYSTEM_PRI2_REG = (NVIC_SYSTEM_PRI2_REG & SVC_PRIORITY_MASK) | (Exception_Priority<<SVC_PRIORITY_BITS_POS);
-        break;
-    case EXCEPTION_DEBUG_MONITOR_TYPE: /* In case of Debug Exception */
-        /* Set priority of Debug Exception as required in Exception_Priority function argument */
-        NVIC_SYSTEM_PRI3_REG = (NVIC_SYSTEM_PRI3_REG & DEBUG_MONITOR_PRIORITY_MASK) | (Exception_Priority<<DEBUG_MONITOR_PRIORITY_BITS_POS);
-        break;
-    case EXCEPTION_PEND_SV_TYPE: /* In case of PendSV Exception */
-        /* Set priority of PendSV Exception as required in Exception_Priority function argument */
-        NVIC_SYSTEM_PRI3_REG = (NVIC_SYSTEM_PRI3_REG & PENDSV_PRIORITY_MASK) | (Exception_Priority<<PENDSV_PRIORITY_BITS_POS);
-        break;
-    case EXCEPTION_SYSTICK_TYPE: /* In case of SysTick Timer Exception */
-        /* Set priority of SysTick Timer Exception as required in Exception_Priority function argument */
-        NVIC_SYSTEM_PRI3_REG = (NVIC_SYSTEM_PRI3_REG & SYSTICK_PRIORITY_MASK) | (Exception_Priority<<SYSTICK_PRIORITY_BITS_POS);
-        break;
+        /* Each configurable exception has its own byte in the NVIC_SYSTEM_PRIn_REG registers */
+        NVIC_SYSTEM_PRI_BYTE(g_ExceptionVectors[Exception_Num]) = (uint8)(Exception_Priority << NVIC_PRIORITY_BITS_SHIFT);
     }
 }
+
+/*********************************************************************
+* Service Name: NVIC_RelocateVectorTable
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to copy the flash vector table to the RAM vector table in the .vtable section and
+*              point the VTOR to it. Calling it again once the table is in RAM has no effect.
+**********************************************************************/
+void NVIC_RelocateVectorTable(void)
+{
+    const NVIC_HandlerType *Flash_Vectors_PTR;
+    uint32 IntState;
+    uint8 Vector;
+
+    if(NVIC_SYSTEM_VTABLE == (uint32)g_RamVectors)
+    {
+        return;
+    }
+
+    IntState = _disable_IRQ();
+
+    /* Copy the table the VTOR points to, the flash table at reset */
+    Flash_Vectors_PTR = (const NVIC_HandlerType *)NVIC_SYSTEM_VTABLE;
+    for(Vector = 0; Vector < NVIC_VECTOR_COUNT; Vector++)
+    {
+        g_RamVectors[Vector] = Flash_Vectors_PTR[Vector];
+    }
+
+    /* The copy must be complete before the next exception fetches a vector from it */
+    Data_Sync_Barrier();
+    NVIC_SYSTEM_VTABLE = (uint32)g_RamVectors;
+    Data_Sync_Barrier();
+    Instruction_Sync_Barrier();
+
+    _restore_interrupts(IntState);
+}
+
+/*********************************************************************
+* Service Name: NVIC_SetVector
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.IRQ_Num - Number of the IRQ from the target vector table
+*                  2.Handler - Interrupt handler to be installed
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the handler is installed, E_NOT_OK for an invalid IRQ or handler
+* Description: Function to install the handler of specific IRQ in the RAM vector table, the table is
+*              relocated first if needed. The handler is called directly by the hardware.
+**********************************************************************/
+Std_ReturnType NVIC_SetVector(NVIC_IRQType IRQ_Num, NVIC_HandlerType Handler)
+{
+    if((IRQ_Num >= NVIC_IRQ_COUNT) || (Handler == NULL_PTR))
+    {
+        return E_NOT_OK;
+    }
+
+    NVIC_RelocateVectorTable();
+
+    /* A single word store, the IRQ sees either the old or the new handler */
+    g_RamVectors[NVIC_IRQ_VECTOR_OFFSET + IRQ_Num] = Handler;
+    Data_Sync_Barrier();
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: NVIC_SetExceptionVector
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Exception_Num - Number of the Exception from the target vector table
+*                  2.Handler - Exception handler to be installed
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the handler is installed, E_NOT_OK for the reset vector or an invalid handler
+* Description: Function to install the handler of specific ARM system or fault exception in the RAM
+*              vector table, the table is relocated first if needed.
+**********************************************************************/
+Std_ReturnType NVIC_SetExceptionVector(NVIC_ExceptionType Exception_Num, NVIC_HandlerType Handler)
+{
+    if((Exception_Num > EXCEPTION_SYSTICK_TYPE) || (g_ExceptionVectors[Exception_Num] == 0) || (Handler == NULL_PTR))
+    {
+        return E_NOT_OK;
+    }
+
+    NVIC_RelocateVectorTable();
+
+    g_RamVectors[g_ExceptionVectors[Exception_Num]] = Handler;
+    Data_Sync_Barrier();
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: NVIC_EnterCritical
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Ceiling - Highest priority to be masked (1 .. 7), the lower priorities are masked too
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Masking state to be passed to NVIC_ExitCritical
+* Description: Function to start a critical section by raising BASEPRI to the ceiling, interrupts with
+*              a higher priority than the ceiling are still taken. Sections can be nested, an inner
+*              section never lowers the masking of the outer one.
+**********************************************************************/
+NVIC_CriticalStateType NVIC_EnterCritical(NVIC_IRQPriorityType Ceiling)
+{
+#if (NVIC_CRITICAL_USE_BASEPRI == TRUE)
+    /* BASEPRI_MAX only raises the masking, an inner section never lowers the outer one */
+    return NVIC_RaiseBasePri((uint32)Ceiling << NVIC_PRIORITY_BITS_SHIFT);
+#else
+    return _disable_IRQ();
+#endif
+}
+
+/*********************************************************************
+* Service Name: NVIC_ExitCritical
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Previous - Value returned by the matching NVIC_EnterCritical
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to end a critical section by restoring the masking state it started from.
+**********************************************************************/
+void NVIC_ExitCritical(NVIC_CriticalStateType Previous)
+{
+#if (NVIC_CRITICAL_USE_BASEPRI == TRUE)
+    _set_interrupt_priority(Previous);
+#else
+    _restore_interrupts(Previous);
+#endif
+}
+
+#if (NVIC_BENCHMARK_ENABLE == TRUE)
+/*********************************************************************
+* Service Name: NVIC_Benchmark
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): IRQ_Num - IRQ enabled and disabled by the benchmark (below NVIC_IRQ_COUNT)
+* Parameters (inout): None
+* Parameters (out): a_Result - Cost of the IRQ control services
+* Return value: E_OK if the benchmark ran, E_NOT_OK for an invalid IRQ
+* Description: Function to measure NVIC_EnableIRQ and NVIC_DisableIRQ against the range switch and
+*              read-modify-write they replaced. The enabled IRQs are restored after, the previous
+*              disable turned off every enabled IRQ of the bank. The interrupts are disabled while
+*              it runs.
+**********************************************************************/
+Std_ReturnType NVIC_Benchmark(NVIC_IRQType IRQ_Num, NVIC_BenchmarkType *a_Result)
+{
+    volatile uint32 *En_Reg_PTR = (volatile uint32 *)NVIC_EN_BASE_ADDRESS;
+    NVIC_IRQMaskType Enabled;
+    uint32 IntState;
+    uint32 Overhead;
+    uint32 Start;
+    uint32 Cycles;
+    uint32 Table;
+    uint8 Run;
+    uint8 Bank;
+
+    if(IRQ_Num >= NVIC_IRQ_COUNT)
+    {
+        return E_NOT_OK;
+    }
+
+    IntState = _disable_IRQ();
+
+    for(Bank = 0; Bank < NVIC_IRQ_BANKS; Bank++)
+    {
+        Enabled.Bank[Bank] = En_Reg_PTR[Bank];
+    }
+
+    /* Cost of reading the cycle counter twice */
+    Start = DWT_CYCCNT_REG;
+    Overhead = DWT_CYCCNT_REG - Start;
+
+    NVIC_MEASURE_CALL(NVIC_EnableIRQ, IRQ_Num, Overhead, a_Result->EnableIRQCycles);
+    NVIC_MEASURE_CALL(NVIC_DisableIRQ, IRQ_Num, Overhead, a_Result->DisableIRQCycles);
+    NVIC_MEASURE_CALL(NVIC_LegacyEnableIRQ, IRQ_Num, Overhead, a_Result->LegacyEnableIRQCycles);
+    NVIC_MEASURE_CALL(NVIC_LegacyDisableIRQ, IRQ_Num, Overhead, a_Result->LegacyDisableIRQCycles);
+
+    /* The IRQ is disabled, enable again what was enabled before */
+    NVIC_EnableIRQMask(&Enabled);
+
+    /* Cost of unmasking and masking the interrupts with nothing pending */
+    Overhead = 0xFFFFFFFFUL;
+    for(Run = 0; Run < NVIC_BENCHMARK_RUNS; Run++)
+    {
+        Start = DWT_CYCCNT_REG;
+        Enable_Exceptions();
+        Disable_Exceptions();
+        Cycles = DWT_CYCCNT_REG - Start;
+        if(Cycles < Overhead)
+        {
+            Overhead = Cycles;
+        }
+    }
+
+    /* Same PendSV handler in both tables, only the place the vector is read from differs */
+    Table = NVIC_SYSTEM_VTABLE;
+    NVIC_RelocateVectorTable();
+    a_Result->FlashVectorEntryCycles = NVIC_MeasureVectorEntry(NVIC_FLASH_VECTOR_TABLE_ADDRESS, Overhead);
+    a_Result->RamVectorEntryCycles = NVIC_MeasureVectorEntry((uint32)g_RamVectors, Overhead);
+    NVIC_SYSTEM_VTABLE = Table;
+    Data_Sync_Barrier();
+    Instruction_Sync_Barrier();
+
+    _restore_interrupts(IntState);
+
+    return E_OK;
+}
+#endif
@@ -17,37 +17,72 @@
  *                                    Header Files                             *
  *******************************************************************************/
 #include "std_types.h"
+#include "NVIC_Cfg.h"
 
 /*******************************************************************************
  *                           Preprocessor Definitions                          *
  *******************************************************************************/
 
-#define MEM_FAULT_PRIORITY_MASK              0x000000E0
-#define MEM_FAULT_PRIORITY_BITS_POS          5
+#define MEM_FAULT_ENABLE_MASK                0x00010000
+#define BUS_FAULT_ENABLE_MASK                0x00020000
+#define USAGE_FAULT_ENABLE_MASK              0x00040000
 
-#define BUS_FAULT_PRIORITY_MASK              0x0000E000
-#define BUS_FAULT_PRIORITY_BITS_POS          13
+#define NVIC_PRI_BASE_ADDRESS                         0xE000E400  /* Address of NVIC_PRI0_REG */
+#define NVIC_EN_BASE_ADDRESS                          0xE000E100  /* Address of NVIC_EN0_REG */
+#define NVIC_DIS_BASE_ADDRESS                         0xE000E180  /* Address of NVIC_DIS0_REG */
+#define NVIC_PEND_BASE_ADDRESS                        0xE000E200  /* Address of NVIC_PEND0_REG */
+#define NVIC_UNPEND_BASE_ADDRESS                      0xE000E280  /* Address of NVIC_UNPEND0_REG */
+#define NVIC_ACTIVE_BASE_ADDRESS                      0xE000E300  /* Address of NVIC_ACTIVE0_REG */
+#define NVIC_SYSTEM_PRI_BASE_ADDRESS                  0xE000ED18  /* Address of NVIC_SYSTEM_PRI1_REG */
 
-#define USAGE_FAULT_PRIORITY_MASK            0x00E00000
-#define USAGE_FAULT_PRIORITY_BITS_POS        21
+/* Number of IRQs of the TM4C123GH6PM and number of 32-bit registers in each EN/DIS/PEND/UNPEND/ACTIVE bank */
+#define NVIC_IRQ_COUNT                       139
+#define NVIC_IRQ_BANKS                       5
 
-#define SVC_PRIORITY_MASK                    0xE0000000
-#define SVC_PRIORITY_BITS_POS                29
+/* Number of 32-bit NVIC_PRIn_REG registers, each one holds the priorities of 4 IRQs */
+#define NVIC_PRI_REGS                        ((NVIC_IRQ_COUNT + 3) / 4)
 
-#define DEBUG_MONITOR_PRIORITY_MASK          0x000000E0
-#define DEBUG_MONITOR_PRIORITY_BITS_POS      5
+/* Register of an IRQ in a bank starting at BASE and the bit of the IRQ in this register.
+ * The EN/DIS/PEND/UNPEND registers act on the bits written as 1 and ignore the bits written as 0,
+ * so one store of the IRQ bit acts on this IRQ only */
+#define NVIC_IRQ_REG(BASE, IRQ_NUM)          (((volatile uint32 *)(BASE))[(IRQ_NUM) >> 5])
+#define NVIC_IRQ_BIT(IRQ_NUM)                (1UL << ((IRQ_NUM) & 0x1F))
 
-#define PENDSV_PRIORITY_MASK                 0x00E00000
-#define PENDSV_PRIORITY_BITS_POS             21
+/* Vector table: 16 system exception entries followed by one entry per IRQ */
+#define NVIC_IRQ_VECTOR_OFFSET               16
+#define NVIC_VECTOR_COUNT                    (NVIC_IRQ_VECTOR_OFFSET + NVIC_IRQ_COUNT)
 
-#define SYSTICK_PRIORITY_MASK                0xE0000000
-#define SYSTICK_PRIORITY_BITS_POS            29
+/* Flash vector table (.intvecs), the VTOR reset value */
+#define NVIC_FLASH_VECTOR_TABLE_ADDRESS      0x00000000
 
-#define MEM_FAULT_ENABLE_MASK                0x00010000
-#define BUS_FAULT_ENABLE_MASK                0x00020000
-#define USAGE_FAULT_ENABLE_MASK              0x00040000
+/* The VTOR needs the table aligned on its size rounded up to a power of 2 (256 entries) */
+#define NVIC_VECTOR_TABLE_ALIGNMENT          1024
 
-#define NVIC_PRI_BASE_ADDRESS                         0xE000E400  /* Address of NVIC_PRI0_REG */
+/* The TM4C123GH6PM implements the 3 upper bits of every 8-bit priority field, BASEPRI included */
+#define NVIC_PRIORITY_BITS_SHIFT             5
+#define NVIC_PRIORITY_BITS                   3
+
+/* Priority byte of an IRQ (NVIC_PRIn_REG) and of a system exception from its vector number 4 - 15
+ * (NVIC_SYSTEM_PRIn_REG). The priority registers are byte accessible, so one byte store sets one
+ * priority without a read-modify-write of the 3 other priorities sharing the word */
+#define NVIC_IRQ_PRI_BYTE(IRQ_NUM)           (((volatile uint8 *)NVIC_PRI_BASE_ADDRESS)[(IRQ_NUM)])
+#define NVIC_SYSTEM_PRI_BYTE(VECTOR)         (((volatile uint8 *)NVIC_SYSTEM_PRI_BASE_ADDRESS)[(VECTOR) - 4])
+
+/* Application Interrupt and Reset Control register: the write key and the PRIGROUP field */
+#define NVIC_APINT_VECTKEY                   0x05FA0000
+#define NVIC_APINT_PRIGROUP_MASK             0x00000700
+#define NVIC_APINT_PRIGROUP_BITS_POS         8
+
+/* Highest priority (lowest value) of the interrupts allowed to call the SwTimer, Scheduler, Deferred
+ * and Kernel services. Their critical sections mask this priority and the lower ones only, so
+ * interrupts above it (priority 0) are never delayed by them and must not call these services */
+#define NVIC_SERVICES_CEILING_PRIORITY       1
+
+/* Calls of each service measured by NVIC_Benchmark, the minimum is kept */
+#define NVIC_BENCHMARK_RUNS                  64
+
+/* Add an IRQ to a NVIC_IRQMaskType set */
+#define NVIC_IRQ_MASK_ADD(MASK, IRQ_NUM)     ((MASK).Bank[(IRQ_NUM) >> 5] |= NVIC_IRQ_BIT(IRQ_NUM))
 
 /* Enable Exceptions ... This Macro enable IRQ interrupts, Programmable Systems Exceptions and Faults by clearing the I-bit in the PRIMASK. */
 #define Enable_Exceptions()    __asm(" CPSIE I ")
@@ -61,6 +96,22 @@
 /* Disable Faults ... This Macro disable Faults by setting the F-bit in the FAULTMASK */
 #define Disable_Faults()       __asm(" CPSID F ")
 
+/* Wait For Interrupt ... This Macro puts the processor in sleep mode until an interrupt becomes pending,
+ * it also wakes up on a pending interrupt masked by PRIMASK */
+#define Wait_For_Interrupt()   __asm(" WFI ")
+
+/* Data Synchronization Barrier ... This Macro waits until all the memory accesses before it are completed,
+ * used after disabling an IRQ so it cannot be taken after the disable returns */
+#define Data_Sync_Barrier()    __asm(" DSB ")
+
+/* Instruction Synchronization Barrier ... This Macro flushes the pipeline so the instructions after it
+ * see the effect of the system register and memory writes before it */
+#define Instruction_Sync_Barrier()  __asm(" ISB ")
+
+/* Data Memory Barrier ... This Macro completes all the memory accesses before it before any memory access after it,
+ * used to publish data to an interrupt or another thread before the index or flag that announces it */
+#define Data_Memory_Barrier()  __asm(" DMB ")
+
 /*******************************************************************************
  *                           Data Types Declarations                           *
  *******************************************************************************/
@@ -68,6 +119,28 @@ typedef uint8 NVIC_IRQType;
 
 typedef uint8 NVIC_IRQPriorityType;
 
+typedef void (*NVIC_HandlerType)(void);
+
+/* Interrupt masking state saved by NVIC_EnterCritical and restored by NVIC_ExitCritical */
+typedef uint32 NVIC_CriticalStateType;
+
+/* Set of IRQs, one bit per IRQ in the layout of the EN/DIS registers */
+typedef struct
+{
+    uint32 Bank[NVIC_IRQ_BANKS];
+}NVIC_IRQMaskType;
+
+/* Cost of one call in core cycles, the cycle counter must be enabled by Delay_Init */
+typedef struct
+{
+    uint32 EnableIRQCycles;         /* NVIC_EnableIRQ: bank index and one store */
+    uint32 DisableIRQCycles;        /* NVIC_DisableIRQ: bank index, one store, DSB and ISB */
+    uint32 LegacyEnableIRQCycles;   /* Previous range switch and read-modify-write of NVIC_ENn_REG */
+    uint32 LegacyDisableIRQCycles;  /* Previous range switch and read-modify-write of NVIC_DISn_REG */
+    uint32 FlashVectorEntryCycles;  /* PendSV pended, taken and returned, vector read from the flash table */
+    uint32 RamVectorEntryCycles;    /* Same with the vector read from the RAM vector table */
+}NVIC_BenchmarkType;
+
 typedef enum
 {
     EXCEPTION_RESET_TYPE,
@@ -84,10 +157,62 @@ typedef enum
 
 typedef uint8 NVIC_ExceptionPriorityType;
 
+/* Entry of the IRQ configuration table built from NVIC_CFG_IRQ_TABLE */
+typedef struct
+{
+    NVIC_IRQType IRQ_Num;
+    NVIC_IRQPriorityType Priority;
+    boolean Enable;
+    NVIC_HandlerType Handler;
+}NVIC_IRQConfigType;
+
+/* Entry of the exception configuration table built from NVIC_CFG_EXCEPTION_TABLE */
+typedef struct
+{
+    NVIC_ExceptionType Exception_Num;
+    NVIC_ExceptionPriorityType Priority;
+}NVIC_ExceptionConfigType;
+
+/* Split of the 3 priority bits into preemption (group) priority and sub-priority, the value is the
+ * PRIGROUP field. Only the preemption priority decides whether an interrupt preempts another one,
+ * the sub-priority orders the pending interrupts of the same preemption priority */
+typedef enum
+{
+    NVIC_PRIORITY_GROUP_3_0 = 4,    /* 8 preemption priorities, no sub-priority (reset default) */
+    NVIC_PRIORITY_GROUP_2_1 = 5,    /* 4 preemption priorities, 2 sub-priorities */
+    NVIC_PRIORITY_GROUP_1_2 = 6,    /* 2 preemption priorities, 4 sub-priorities */
+    NVIC_PRIORITY_GROUP_0_3 = 7     /* No preemption, 8 sub-priorities */
+}NVIC_PriorityGroupType;
+
+/*******************************************************************************
+ *                       External Variables                                    *
+ *******************************************************************************/
+
+/* Configuration tables defined in NVIC_Cfg.c */
+extern const NVIC_IRQConfigType NVIC_IRQConfig[];
+extern const uint8 NVIC_IRQConfigCount;
+extern const NVIC_ExceptionConfigType NVIC_ExceptionConfig[];
+extern const uint8 NVIC_ExceptionConfigCount;
+
 /*******************************************************************************
  *                                Functions Prototypes                          *
  *******************************************************************************/
 
+/*********************************************************************
+* Service Name: NVIC_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to apply the interrupt map of NVIC_Cfg.h: installs the IRQ handlers, sets the
+*              IRQ priorities with one byte write per IRQ, sets the exception priorities then enables
+*              the IRQs with one write per NVIC_ENn_REG used. The IRQs and exceptions missing from the
+*              tables keep their priorities. To be called once at boot, when the handlers are ready to run.
+**********************************************************************/
+void NVIC_Init(void);
+
 /*********************************************************************
 * Service Name: NVIC_EnableIRQ
 * Sync/Async: Synchronous
@@ -96,7 +221,7 @@ typedef uint8 NVIC_ExceptionPriorityType;
 * Parameters (inout): None
 * Parameters (out): None
 * Return value: None
-* Description: Function to enable Interrupt request for specific IRQ
+* Description: Function to enable Interrupt request for specific IRQ (below NVIC_IRQ_COUNT)
 **********************************************************************/
 void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num);
 
@@ -108,23 +233,159 @@ void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num);
 * Parameters (inout): None
 * Parameters (out): None
 * Return value: None
-* Description: Function to disable Interrupt request for specific IRQ
+* Description: Function to disable Interrupt request for specific IRQ (below NVIC_IRQ_COUNT),
+*              the IRQ is not taken anymore when the function returns
 **********************************************************************/
 void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num);
 
+/*********************************************************************
+* Service Name: NVIC_IsEnabledIRQ
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: TRUE if the IRQ is enabled, FALSE otherwise
+* Description: Function to check whether specific IRQ is enabled
+**********************************************************************/
+boolean NVIC_IsEnabledIRQ(NVIC_IRQType IRQ_Num);
+
+/*********************************************************************
+* Service Name: NVIC_SetPendingIRQ
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to trigger specific IRQ by software
+**********************************************************************/
+void NVIC_SetPendingIRQ(NVIC_IRQType IRQ_Num);
+
+/*********************************************************************
+* Service Name: NVIC_ClearPendingIRQ
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to remove the pending state of specific IRQ
+**********************************************************************/
+void NVIC_ClearPendingIRQ(NVIC_IRQType IRQ_Num);
+
+/*********************************************************************
+* Service Name: NVIC_IsPendingIRQ
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: TRUE if the IRQ is pending, FALSE otherwise
+* Description: Function to check whether specific IRQ is pending
+**********************************************************************/
+boolean NVIC_IsPendingIRQ(NVIC_IRQType IRQ_Num);
+
+/*********************************************************************
+* Service Name: NVIC_IsActiveIRQ
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: TRUE if the IRQ handler is running or preempted, FALSE otherwise
+* Description: Function to check whether specific IRQ is active
+**********************************************************************/
+boolean NVIC_IsActiveIRQ(NVIC_IRQType IRQ_Num);
+
+/*********************************************************************
+* Service Name: NVIC_EnableIRQMask
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Mask - Set of IRQs to be enabled
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to enable a set of IRQs with one store per register bank
+**********************************************************************/
+void NVIC_EnableIRQMask(const NVIC_IRQMaskType *Mask);
+
+/*********************************************************************
+* Service Name: NVIC_DisableIRQMask
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Mask - Set of IRQs to be disabled
+* Parameters (inout): None
+* Parameters (out): Previous - IRQs of the set that were enabled, may be NULL_PTR
+* Return value: None
+* Description: Function to disable a set of IRQs with one store per register bank. Passing Previous to
+*              NVIC_EnableIRQMask later enables again only the IRQs this call disabled.
+**********************************************************************/
+void NVIC_DisableIRQMask(const NVIC_IRQMaskType *Mask, NVIC_IRQMaskType *Previous);
+
 /*********************************************************************
 * Service Name: NVIC_SetPriorityIRQ
 * Sync/Async: Synchronous
-* Reentrancy: non reentrant
+* Reentrancy: reentrant
 * Parameters (in): 1.IRQ_Num - Number of the IRQ from the target vector table
-*                  2.IRQ_Priority - The required Priority for the IRQ
+*                  2.IRQ_Priority - The required Priority for the IRQ (0 .. 7)
 * Parameters (inout): None
 * Parameters (out): None
 * Return value: None
-* Description: Function to set the priority value for specific IRQ.
+* Description: Function to set the priority value for specific IRQ, the other IRQs are not affected.
 **********************************************************************/
 void NVIC_SetPriorityIRQ(NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType IRQ_Priority);
 
+/*********************************************************************
+* Service Name: NVIC_GetPriorityIRQ
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Priority of the IRQ (0 .. 7)
+* Description: Function to get the priority value of specific IRQ.
+**********************************************************************/
+NVIC_IRQPriorityType NVIC_GetPriorityIRQ(NVIC_IRQType IRQ_Num);
+
+/*********************************************************************
+* Service Name: NVIC_SetPriorityGrouping
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Group - Split of the priority bits into preemption priority and sub-priority
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the PRIGROUP field, to be called once before the priorities are set.
+**********************************************************************/
+void NVIC_SetPriorityGrouping(NVIC_PriorityGroupType Group);
+
+/*********************************************************************
+* Service Name: NVIC_GetPriorityGrouping
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Split of the priority bits into preemption priority and sub-priority
+* Description: Function to get the PRIGROUP field, PRIGROUP values below 4 are reported as
+*              NVIC_PRIORITY_GROUP_3_0 since they all give 3 preemption bits on this device.
+**********************************************************************/
+NVIC_PriorityGroupType NVIC_GetPriorityGrouping(void);
+
+/*********************************************************************
+* Service Name: NVIC_EncodePriority
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Preempt - Preemption priority, limited to the bits of the current grouping
+*                  2.Sub - Sub-priority, limited to the bits of the current grouping
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Priority (0 .. 7) to be passed to NVIC_SetPriorityIRQ or NVIC_SetPriorityException
+* Description: Function to build a priority from its preemption and sub-priority parts.
+**********************************************************************/
+NVIC_IRQPriorityType NVIC_EncodePriority(uint8 Preempt, uint8 Sub);
+
 /*********************************************************************
 * Service Name: NVIC_EnableException
 * Sync/Async: Synchronous
@@ -158,8 +419,109 @@ void NVIC_DisableException(NVIC_ExceptionType Exception_Num);
 * Parameters (inout): None
 * Parameters (out): None
 * Return value: None
-* Description: Function to set the priority value for specific IRQ.
+* Description: Function to set the priority value for specific ARM system or fault exception,
+*              the other exceptions are not affected.
 **********************************************************************/
 void NVIC_SetPriorityException(NVIC_ExceptionType Exception_Num, NVIC_ExceptionPriorityType Exception_Priority);
 
+/*********************************************************************
+* Service Name: NVIC_RelocateVectorTable
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to copy the flash vector table to the RAM vector table in the .vtable section and
+*              point the VTOR to it. Calling it again once the table is in RAM has no effect.
+**********************************************************************/
+void NVIC_RelocateVectorTable(void);
+
+/*********************************************************************
+* Service Name: NVIC_SetVector
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.IRQ_Num - Number of the IRQ from the target vector table
+*                  2.Handler - Interrupt handler to be installed
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the handler is installed, E_NOT_OK for an invalid IRQ or handler
+* Description: Function to install the handler of specific IRQ in the RAM vector table, the table is
+*              relocated first if needed. The handler is called directly by the hardware.
+**********************************************************************/
+Std_ReturnType NVIC_SetVector(NVIC_IRQType IRQ_Num, NVIC_HandlerType Handler);
+
+/*********************************************************************
+* Service Name: NVIC_SetExceptionVector
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Exception_Num - Number of the Exception from the target vector table
+*                  2.Handler - Exception handler to be installed
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the handler is installed, E_NOT_OK for the reset vector or an invalid handler
+* Description: Function to install the handler of specific ARM system or fault exception in the RAM
+*              vector table, the table is relocated first if needed.
+**********************************************************************/
+Std_ReturnType NVIC_SetExceptionVector(NVIC_ExceptionType Exception_Num, NVIC_HandlerType Handler);
+
+/*********************************************************************
+* Service Name: NVIC_RaiseBasePri
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): BasePri - New BASEPRI value, priority in the 3 upper bits of the byte
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: BASEPRI value before the call
+* Description: Function to raise BASEPRI through BASEPRI_MAX (NVIC_BasePri.asm), BASEPRI is left as
+*              it is when it already masks as much or more, or when BasePri is 0.
+**********************************************************************/
+uint32 NVIC_RaiseBasePri(uint32 BasePri);
+
+/*********************************************************************
+* Service Name: NVIC_EnterCritical
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Ceiling - Highest priority to be masked (1 .. 7), the lower priorities are masked too
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Masking state to be passed to NVIC_ExitCritical
+* Description: Function to start a critical section by raising BASEPRI to the ceiling, interrupts with
+*              a higher priority than the ceiling are still taken. Sections can be nested, an inner
+*              section never lowers the masking of the outer one.
+**********************************************************************/
+NVIC_CriticalStateType NVIC_EnterCritical(NVIC_IRQPriorityType Ceiling);
+
+/*********************************************************************
+* Service Name: NVIC_ExitCritical
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Previous - Value returned by the matching NVIC_EnterCritical
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to end a critical section by restoring the masking state it started from.
+**********************************************************************/
+void NVIC_ExitCritical(NVIC_CriticalStateType Previous);
+
+#if (NVIC_BENCHMARK_ENABLE == TRUE)
+/*********************************************************************
+* Service Name: NVIC_Benchmark
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): IRQ_Num - IRQ enabled and disabled by the benchmark (below NVIC_IRQ_COUNT)
+* Parameters (inout): None
+* Parameters (out): a_Result - Cost of the IRQ control services
+* Return value: E_OK if the benchmark ran, E_NOT_OK for an invalid IRQ
+* Description: Function to measure NVIC_EnableIRQ and NVIC_DisableIRQ against the range switch and
+*              read-modify-write they replaced. The enabled IRQs are restored after, the previous
+*              disable turned off every enabled IRQ of the bank. The interrupts are disabled while
+*              it runs, except around the PendSV exceptions comparing the vector fetch from the flash
+*              and the RAM tables: the difference of the two is the cost of the RAM table. To be called
+*              from thread mode before Kernel_Start with the deferred work queue empty, so PendSV has
+*              nothing to do.
+**********************************************************************/
+Std_ReturnType NVIC_Benchmark(NVIC_IRQType IRQ_Num, NVIC_BenchmarkType *a_Result);
+#endif
+
 #endif /* NVIC_H_ */
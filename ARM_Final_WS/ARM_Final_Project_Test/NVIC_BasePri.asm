@@ -0,0 +1,43 @@
+;******************************************************************************
+;
+; Module: NVIC
+;
+; File Name: NVIC_BasePri.asm
+;
+; Description: BASEPRI access used by NVIC_EnterCritical. The TI ARM compiler has an intrinsic to
+;              write BASEPRI but none to read it, and a read followed by a conditional write in C
+;              is two steps. BASEPRI_MAX does the comparison in the hardware: the write is ignored
+;              when it would lower the current masking.
+;
+; Author: Karima Mahmoud
+;
+;******************************************************************************
+
+        .thumb
+        .text
+        .align  4
+
+        .global NVIC_RaiseBasePri
+
+;******************************************************************************
+; Service Name: NVIC_RaiseBasePri
+; Sync/Async: Synchronous
+; Reentrancy: reentrant
+; Parameters (in): R0 - New BASEPRI value, priority in the 3 upper bits of the byte
+; Parameters (inout): None
+; Parameters (out): None
+; Return value: R0 - BASEPRI value before the call
+; Description: Function to raise BASEPRI to the given value. BASEPRI is left as it is when it
+;              already masks as much or more, or when the value is 0.
+;******************************************************************************
+        .thumbfunc NVIC_RaiseBasePri
+NVIC_RaiseBasePri: .asmfunc
+
+        MRS     R1, BASEPRI
+        MSR     BASEPRI_MAX, R0
+        MOV     R0, R1
+        BX      LR
+
+        .endasmfunc
+
+        .end
@@ -0,0 +1,89 @@
+ /******************************************************************************
+ *
+ * Module: Nested Vectored Interrupt Controller
+ *
+ * File Name: NVIC_Cfg.c
+ *
+ * Description: Configuration tables of the NVIC driver built from NVIC_Cfg.h and their build time checks
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "NVIC.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Token pasting after the expansion of the arguments */
+#define NVIC_CFG_CAT(A, B)                   NVIC_CFG_CAT_(A, B)
+#define NVIC_CFG_CAT_(A, B)                  A##B
+
+/* Build error (negative array size) when COND is false */
+#define NVIC_CFG_STATIC_ASSERT(COND, NAME)   typedef char NAME[(COND) ? 1 : -1]
+
+/* One enumerator per IRQ and per priority, a duplicate enumerator is a build error */
+#define NVIC_CFG_IRQ_CLAIM(IRQ_NUM, PRIORITY, ENABLE, HANDLER)                          \
+    NVIC_CFG_CAT(NVIC_CFG_IRQ_CLAIMED_, IRQ_NUM),                                       \
+    NVIC_CFG_CAT(NVIC_CFG_PRIORITY_CLAIMED_, PRIORITY),
+
+#define NVIC_CFG_EXCEPTION_CLAIM(EXCEPTION_NUM, PRIORITY)                               \
+    NVIC_CFG_CAT(NVIC_CFG_PRIORITY_CLAIMED_, PRIORITY),
+
+/* Range checks of every entry */
+#define NVIC_CFG_IRQ_CHECK(IRQ_NUM, PRIORITY, ENABLE, HANDLER)                          \
+    NVIC_CFG_STATIC_ASSERT((IRQ_NUM) < NVIC_IRQ_COUNT, NVIC_CFG_CAT(NVIC_Cfg_IRQNumCheck_, IRQ_NUM));   \
+    NVIC_CFG_STATIC_ASSERT((PRIORITY) < (1 << NVIC_PRIORITY_BITS), NVIC_CFG_CAT(NVIC_Cfg_IRQPriorityCheck_, IRQ_NUM));
+
+#define NVIC_CFG_EXCEPTION_CHECK(EXCEPTION_NUM, PRIORITY)                               \
+    NVIC_CFG_STATIC_ASSERT(((EXCEPTION_NUM) >= EXCEPTION_MEM_FAULT_TYPE) && ((EXCEPTION_NUM) <= EXCEPTION_SYSTICK_TYPE), \
+                           NVIC_CFG_CAT(NVIC_Cfg_ExceptionCheck_, EXCEPTION_NUM));      \
+    NVIC_CFG_STATIC_ASSERT((PRIORITY) < (1 << NVIC_PRIORITY_BITS), NVIC_CFG_CAT(NVIC_Cfg_ExceptionPriorityCheck_, EXCEPTION_NUM));
+
+/* Declaration of the handlers and the table entries */
+#define NVIC_CFG_IRQ_HANDLER(IRQ_NUM, PRIORITY, ENABLE, HANDLER)                        \
+    void HANDLER(void);
+
+#define NVIC_CFG_IRQ_ENTRY(IRQ_NUM, PRIORITY, ENABLE, HANDLER)                          \
+    {IRQ_NUM, PRIORITY, ENABLE, HANDLER},
+
+#define NVIC_CFG_EXCEPTION_ENTRY(EXCEPTION_NUM, PRIORITY)                               \
+    {EXCEPTION_NUM, PRIORITY},
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+enum
+{
+    NVIC_CFG_IRQ_TABLE(NVIC_CFG_IRQ_CLAIM)
+    NVIC_CFG_EXCEPTION_TABLE(NVIC_CFG_EXCEPTION_CLAIM)
+    NVIC_CFG_CLAIMS
+};
+
+NVIC_CFG_IRQ_TABLE(NVIC_CFG_IRQ_CHECK)
+NVIC_CFG_EXCEPTION_TABLE(NVIC_CFG_EXCEPTION_CHECK)
+
+NVIC_CFG_IRQ_TABLE(NVIC_CFG_IRQ_HANDLER)
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+const NVIC_IRQConfigType NVIC_IRQConfig[] =
+{
+    NVIC_CFG_IRQ_TABLE(NVIC_CFG_IRQ_ENTRY)
+};
+
+const uint8 NVIC_IRQConfigCount = sizeof(NVIC_IRQConfig) / sizeof(NVIC_IRQConfig[0]);
+
+const NVIC_ExceptionConfigType NVIC_ExceptionConfig[] =
+{
+    NVIC_CFG_EXCEPTION_TABLE(NVIC_CFG_EXCEPTION_ENTRY)
+};
+
+const uint8 NVIC_ExceptionConfigCount = sizeof(NVIC_ExceptionConfig) / sizeof(NVIC_ExceptionConfig[0]);
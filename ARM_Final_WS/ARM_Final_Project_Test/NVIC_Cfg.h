@@ -0,0 +1,53 @@
+ /******************************************************************************
+ *
+ * Module: Nested Vectored Interrupt Controller
+ *
+ * File Name: NVIC_Cfg.h
+ *
+ * Description: Pre-compile configuration header file for the NVIC driver. The interrupt map of the
+ *              application is listed here once and applied by NVIC_Init.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_CFG_H_
+#define NVIC_CFG_H_
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* NVIC_EnterCritical raises BASEPRI to the ceiling when TRUE, it disables all the interrupts
+ * (PRIMASK) like Disable_Exceptions when FALSE. Used to compare the interrupt jitter of both */
+#ifndef NVIC_CRITICAL_USE_BASEPRI
+#define NVIC_CRITICAL_USE_BASEPRI            TRUE
+#endif
+
+/* NVIC_Benchmark measures the IRQ enable/disable services against their previous implementation and the
+ * exception entry with the vector table in flash and in RAM when TRUE */
+#ifndef NVIC_BENCHMARK_ENABLE
+#define NVIC_BENCHMARK_ENABLE                FALSE
+#endif
+
+/* IRQs configured by NVIC_Init, one ENTRY per IRQ:
+ *     ENTRY(IRQ number, Priority, Enabled, Handler)
+ * The IRQ number and the priority must be plain decimal numbers, they are checked at build time:
+ * an IRQ listed twice or a priority used by two interrupts (IRQs or exceptions below) does not
+ * compile. The handler is installed in the RAM vector table */
+#define NVIC_CFG_IRQ_TABLE(ENTRY)                                                       \
+    ENTRY(30,   2,  TRUE,   GPIOPortF_Handler)      /* GPIO Port F, SW1 and SW2 */      \
+    ENTRY(70,   3,  TRUE,   Swi_Level0_Handler)     /* SWI_LEVEL0_IRQ_NUM */            \
+    ENTRY(71,   4,  TRUE,   Swi_Level1_Handler)     /* SWI_LEVEL1_IRQ_NUM */            \
+    ENTRY(92,   5,  TRUE,   Swi_Level2_Handler)     /* SWI_LEVEL2_IRQ_NUM */            \
+    ENTRY(93,   6,  TRUE,   Swi_Level3_Handler)     /* SWI_LEVEL3_IRQ_NUM */
+
+/* System exceptions whose priority is set by NVIC_Init, one ENTRY per exception:
+ *     ENTRY(NVIC_ExceptionType, Priority)
+ * PendSV runs the Deferred work items and the Kernel context switch, it has the lowest priority
+ * so neither of them ever delays an interrupt */
+#define NVIC_CFG_EXCEPTION_TABLE(ENTRY)                                                 \
+    ENTRY(EXCEPTION_SYSTICK_TYPE,   1)              /* SysTick, drives the software timers */   \
+    ENTRY(EXCEPTION_PEND_SV_TYPE,   7)              /* PendSV, Deferred and Kernel */
+
+#endif /* NVIC_CFG_H_ */
@@ -0,0 +1,408 @@
+ /******************************************************************************
+ *
+ * Module: Ring Buffer
+ *
+ * File Name: RingBuffer.c
+ *
+ * Description: Source file for the lock-free single-producer/single-consumer ring buffer.
+ *              The producer writes the element, then a barrier, then Head. The consumer
+ *              reads Head, then a barrier, then the element, and the same in the other
+ *              direction for the freed space and Tail.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include <string.h>
+#include "RingBuffer.h"
+#include "NVIC.h"
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: RingBuffer_Init
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Storage - Storage of Capacity * ElementSize bytes
+*                  2.Capacity - Number of elements, power of 2
+*                  3.ElementSize - Size of one element in bytes (1 for bytes, 4 for words)
+* Parameters (inout): Ring - Ring buffer to be initialized
+* Parameters (out): None
+* Return value: E_OK if the ring buffer is initialized, E_NOT_OK for invalid parameters
+* Description: Function to initialize an empty ring buffer, must be called before both sides use it.
+**********************************************************************/
+Std_ReturnType RingBuffer_Init(RingBuffer_Type *Ring, void *Storage, uint32 Capacity, uint32 ElementSize)
+{
+    if((Ring == NULL_PTR) || (Storage == NULL_PTR) || (ElementSize == 0) ||
+       (Capacity == 0) || ((Capacity & (Capacity - 1)) != 0) || (Capacity > 0x80000000UL))
+    {
+        return E_NOT_OK;
+    }
+
+    Ring->Storage = (uint8 *)Storage;
+    Ring->Capacity = Capacity;
+    Ring->ElementSize = ElementSize;
+    Ring->Head = 0;
+    Ring->Tail = 0;
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: RingBuffer_GetCount
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Ring - Ring buffer
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Number of elements in the ring buffer
+* Description: Function to get the number of elements, exact for the consumer and a lower
+*              bound of the free space for the producer.
+**********************************************************************/
+uint32 RingBuffer_GetCount(const RingBuffer_Type *Ring)
+{
+    return Ring->Head - Ring->Tail;
+}
+
+/*********************************************************************
+* Service Name: RingBuffer_GetFree
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Ring - Ring buffer
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Number of free elements in the ring buffer
+* Description: Function to get the free space, exact for the producer.
+**********************************************************************/
+uint32 RingBuffer_GetFree(const RingBuffer_Type *Ring)
+{
+    return Ring->Capacity - (Ring->Head - Ring->Tail);
+}
+
+/*********************************************************************
+* Service Name: RingBuffer_Push
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Element - Element of ElementSize bytes to be copied
+* Parameters (inout): Ring - Ring buffer
+* Parameters (out): None
+* Return value: E_OK if the element is pushed, E_NOT_OK if the ring buffer is full
+* Description: Function to push one element, producer side only.
+**********************************************************************/
+Std_ReturnType RingBuffer_Push(RingBuffer_Type *Ring, const void *Element)
+{
+    uint32 Head = Ring->Head;
+
+    if((Head - Ring->Tail) == Ring->Capacity)
+    {
+        return E_NOT_OK;
+    }
+
+    /* The consumer may still be reading the slot until Tail is seen moved */
+    Data_Memory_Barrier();
+    memcpy(&Ring->Storage[(Head & (Ring->Capacity - 1)) * Ring->ElementSize], Element, Ring->ElementSize);
+    Data_Memory_Barrier();
+    Ring->Head = Head + 1;
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: RingBuffer_Pop
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): Ring - Ring buffer
+* Parameters (out): Element - Buffer of ElementSize bytes receiving the element
+* Return value: E_OK if an element is popped, E_NOT_OK if the ring buffer is empty
+* Description: Function to pop one element, consumer side only.
+**********************************************************************/
+Std_ReturnType RingBuffer_Pop(RingBuffer_Type *Ring, void *Element)
+{
+    uint32 Tail = Ring->Tail;
+
+    if(Ring->Head == Tail)
+    {
+        return E_NOT_OK;
+    }
+
+    Data_Memory_Barrier();
+    memcpy(Element, &Ring->Storage[(Tail & (Ring->Capacity - 1)) * Ring->ElementSize], Ring->ElementSize);
+    Data_Memory_Barrier();
+    Ring->Tail = Tail + 1;
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: RingBuffer_PushByte
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Data - Byte to be pushed
+* Parameters (inout): Ring - Ring buffer of 1-byte elements
+* Parameters (out): None
+* Return value: E_OK if the byte is pushed, E_NOT_OK if the ring buffer is full
+* Description: Function to push one byte without the generic copy, producer side only.
+**********************************************************************/
+Std_ReturnType RingBuffer_PushByte(RingBuffer_Type *Ring, uint8 Data)
+{
+    uint32 Head = Ring->Head;
+
+    if((Head - Ring->Tail) == Ring->Capacity)
+    {
+        return E_NOT_OK;
+    }
+
+    Data_Memory_Barrier();
+    Ring->Storage[Head & (Ring->Capacity - 1)] = Data;
+    Data_Memory_Barrier();
+    Ring->Head = Head + 1;
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: RingBuffer_PopByte
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): Ring - Ring buffer of 1-byte elements
+* Parameters (out): Data - Popped byte
+* Return value: E_OK if a byte is popped, E_NOT_OK if the ring buffer is empty
+* Description: Function to pop one byte without the generic copy, consumer side only.
+**********************************************************************/
+Std_ReturnType RingBuffer_PopByte(RingBuffer_Type *Ring, uint8 *Data)
+{
+    uint32 Tail = Ring->Tail;
+
+    if(Ring->Head == Tail)
+    {
+        return E_NOT_OK;
+    }
+
+    Data_Memory_Barrier();
+    *Data = Ring->Storage[Tail & (Ring->Capacity - 1)];
+    Data_Memory_Barrier();
+    Ring->Tail = Tail + 1;
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: RingBuffer_PushWord
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Data - Word to be pushed
+* Parameters (inout): Ring - Ring buffer of 4-byte elements with word aligned storage
+* Parameters (out): None
+* Return value: E_OK if the word is pushed, E_NOT_OK if the ring buffer is full
+* Description: Function to push one word without the generic copy, producer side only.
+**********************************************************************/
+Std_ReturnType RingBuffer_PushWord(RingBuffer_Type *Ring, uint32 Data)
+{
+    uint32 Head = Ring->Head;
+
+    if((Head - Ring->Tail) == Ring->Capacity)
+    {
+        return E_NOT_OK;
+    }
+
+    Data_Memory_Barrier();
+    ((uint32 *)Ring->Storage)[Head & (Ring->Capacity - 1)] = Data;
+    Data_Memory_Barrier();
+    Ring->Head = Head + 1;
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: RingBuffer_PopWord
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): Ring - Ring buffer of 4-byte elements with word aligned storage
+* Parameters (out): Data - Popped word
+* Return value: E_OK if a word is popped, E_NOT_OK if the ring buffer is empty
+* Description: Function to pop one word without the generic copy, consumer side only.
+**********************************************************************/
+Std_ReturnType RingBuffer_PopWord(RingBuffer_Type *Ring, uint32 *Data)
+{
+    uint32 Tail = Ring->Tail;
+
+    if(Ring->Head == Tail)
+    {
+        return E_NOT_OK;
+    }
+
+    Data_Memory_Barrier();
+    *Data = ((const uint32 *)Ring->Storage)[Tail & (Ring->Capacity - 1)];
+    Data_Memory_Barrier();
+    Ring->Tail = Tail + 1;
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: RingBuffer_PushBulk
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): 1.Elements - Array of elements to be copied
+*                  2.Count - Number of elements in the array
+* Parameters (inout): Ring - Ring buffer
+* Parameters (out): None
+* Return value: Number of pushed elements, less than Count if the ring buffer gets full
+* Description: Function to push many elements with at most two copies and one Head update,
+*              producer side only.
+**********************************************************************/
+uint32 RingBuffer_PushBulk(RingBuffer_Type *Ring, const void *Elements, uint32 Count)
+{
+    uint32 Head = Ring->Head;
+    uint32 Free = Ring->Capacity - (Head - Ring->Tail);
+    uint32 Index = Head & (Ring->Capacity - 1);
+    uint32 First;
+
+    if(Count > Free)
+    {
+        Count = Free;
+    }
+
+    /* Up to the end of the storage, then the rest from its start */
+    First = Ring->Capacity - Index;
+    if(First > Count)
+    {
+        First = Count;
+    }
+
+    Data_Memory_Barrier();
+    memcpy(&Ring->Storage[Index * Ring->ElementSize], Elements, First * Ring->ElementSize);
+    memcpy(Ring->Storage, (const uint8 *)Elements + (First * Ring->ElementSize), (Count - First) * Ring->ElementSize);
+    Data_Memory_Barrier();
+    Ring->Head = Head + Count;
+
+    return Count;
+}
+
+/*********************************************************************
+* Service Name: RingBuffer_PopBulk
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Count - Maximum number of elements to pop
+* Parameters (inout): Ring - Ring buffer
+* Parameters (out): Elements - Array receiving the elements
+* Return value: Number of popped elements, less than Count if the ring buffer gets empty
+* Description: Function to pop many elements with at most two copies and one Tail update,
+*              consumer side only.
+**********************************************************************/
+uint32 RingBuffer_PopBulk(RingBuffer_Type *Ring, void *Elements, uint32 Count)
+{
+    uint32 Tail = Ring->Tail;
+    uint32 Used = Ring->Head - Tail;
+    uint32 Index = Tail & (Ring->Capacity - 1);
+    uint32 First;
+
+    if(Count > Used)
+    {
+        Count = Used;
+    }
+
+    First = Ring->Capacity - Index;
+    if(First > Count)
+    {
+        First = Count;
+    }
+
+    Data_Memory_Barrier();
+    memcpy(Elements, &Ring->Storage[Index * Ring->ElementSize], First * Ring->ElementSize);
+    memcpy((uint8 *)Elements + (First * Ring->ElementSize), Ring->Storage, (Count - First) * Ring->ElementSize);
+    Data_Memory_Barrier();
+    Ring->Tail = Tail + Count;
+
+    return Count;
+}
+
+/*********************************************************************
+* Service Name: RingBuffer_GetWriteSpan
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Ring - Ring buffer
+* Parameters (inout): None
+* Parameters (out): Span - Address of the first free element
+* Return value: Number of contiguous free elements at Span
+* Description: Function to get the contiguous free space for a direct write (e.g. by DMA),
+*              followed by RingBuffer_CommitWrite. Producer side only.
+**********************************************************************/
+uint32 RingBuffer_GetWriteSpan(const RingBuffer_Type *Ring, void **Span)
+{
+    uint32 Head = Ring->Head;
+    uint32 Free = Ring->Capacity - (Head - Ring->Tail);
+    uint32 Index = Head & (Ring->Capacity - 1);
+
+    *Span = &Ring->Storage[Index * Ring->ElementSize];
+
+    /* The space must not be written before the consumer is seen done with it */
+    Data_Memory_Barrier();
+
+    return ((Ring->Capacity - Index) < Free) ? (Ring->Capacity - Index) : Free;
+}
+
+/*********************************************************************
+* Service Name: RingBuffer_CommitWrite
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Count - Number of elements written, at most the last write span length
+* Parameters (inout): Ring - Ring buffer
+* Parameters (out): None
+* Return value: None
+* Description: Function to publish the elements written in the write span. Producer side only.
+**********************************************************************/
+void RingBuffer_CommitWrite(RingBuffer_Type *Ring, uint32 Count)
+{
+    Data_Memory_Barrier();
+    Ring->Head += Count;
+}
+
+/*********************************************************************
+* Service Name: RingBuffer_GetReadSpan
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Ring - Ring buffer
+* Parameters (inout): None
+* Parameters (out): Span - Address of the oldest element
+* Return value: Number of contiguous elements at Span
+* Description: Function to get the contiguous stored elements for a direct read (e.g. by DMA),
+*              followed by RingBuffer_CommitRead. Consumer side only.
+**********************************************************************/
+uint32 RingBuffer_GetReadSpan(const RingBuffer_Type *Ring, const void **Span)
+{
+    uint32 Tail = Ring->Tail;
+    uint32 Used = Ring->Head - Tail;
+    uint32 Index = Tail & (Ring->Capacity - 1);
+
+    *Span = &Ring->Storage[Index * Ring->ElementSize];
+
+    /* The elements must not be read before Head is seen moved */
+    Data_Memory_Barrier();
+
+    return ((Ring->Capacity - Index) < Used) ? (Ring->Capacity - Index) : Used;
+}
+
+/*********************************************************************
+* Service Name: RingBuffer_CommitRead
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Count - Number of elements read, at most the last read span length
+* Parameters (inout): Ring - Ring buffer
+* Parameters (out): None
+* Return value: None
+* Description: Function to release the elements read from the read span. Consumer side only.
+**********************************************************************/
+void RingBuffer_CommitRead(RingBuffer_Type *Ring, uint32 Count)
+{
+    Data_Memory_Barrier();
+    Ring->Tail += Count;
+}
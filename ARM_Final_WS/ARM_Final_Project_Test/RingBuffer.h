@@ -0,0 +1,231 @@
+ /******************************************************************************
+ *
+ * Module: Ring Buffer
+ *
+ * File Name: RingBuffer.h
+ *
+ * Description: header file for the lock-free single-producer/single-consumer ring buffer.
+ *              One side (an ISR or a thread) only pushes and the other side only pops, neither
+ *              side disables the interrupts. The producer only writes Head and the consumer
+ *              only writes Tail, both are free running and the element index is the counter
+ *              masked by the capacity, so every element of the storage is usable.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef RINGBUFFER_H_
+#define RINGBUFFER_H_
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Ring buffer control block, the storage is allocated by the user */
+typedef struct
+{
+    uint8 *Storage;
+    uint32 Capacity;                /* Number of elements, power of 2 */
+    uint32 ElementSize;             /* Size of one element in bytes */
+    volatile uint32 Head;           /* Elements pushed, written by the producer only */
+    volatile uint32 Tail;           /* Elements popped, written by the consumer only */
+}RingBuffer_Type;
+
+/*******************************************************************************
+ *                                Functions Prototypes                          *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: RingBuffer_Init
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Storage - Storage of Capacity * ElementSize bytes
+*                  2.Capacity - Number of elements, power of 2
+*                  3.ElementSize - Size of one element in bytes (1 for bytes, 4 for words)
+* Parameters (inout): Ring - Ring buffer to be initialized
+* Parameters (out): None
+* Return value: E_OK if the ring buffer is initialized, E_NOT_OK for invalid parameters
+* Description: Function to initialize an empty ring buffer, must be called before both sides use it.
+**********************************************************************/
+Std_ReturnType RingBuffer_Init(RingBuffer_Type *Ring, void *Storage, uint32 Capacity, uint32 ElementSize);
+
+/*********************************************************************
+* Service Name: RingBuffer_GetCount
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Ring - Ring buffer
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Number of elements in the ring buffer
+* Description: Function to get the number of elements, exact for the consumer and a lower
+*              bound of the free space for the producer.
+**********************************************************************/
+uint32 RingBuffer_GetCount(const RingBuffer_Type *Ring);
+
+/*********************************************************************
+* Service Name: RingBuffer_GetFree
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Ring - Ring buffer
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Number of free elements in the ring buffer
+* Description: Function to get the free space, exact for the producer.
+**********************************************************************/
+uint32 RingBuffer_GetFree(const RingBuffer_Type *Ring);
+
+/*********************************************************************
+* Service Name: RingBuffer_Push
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Element - Element of ElementSize bytes to be copied
+* Parameters (inout): Ring - Ring buffer
+* Parameters (out): None
+* Return value: E_OK if the element is pushed, E_NOT_OK if the ring buffer is full
+* Description: Function to push one element, producer side only.
+**********************************************************************/
+Std_ReturnType RingBuffer_Push(RingBuffer_Type *Ring, const void *Element);
+
+/*********************************************************************
+* Service Name: RingBuffer_Pop
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): Ring - Ring buffer
+* Parameters (out): Element - Buffer of ElementSize bytes receiving the element
+* Return value: E_OK if an element is popped, E_NOT_OK if the ring buffer is empty
+* Description: Function to pop one element, consumer side only.
+**********************************************************************/
+Std_ReturnType RingBuffer_Pop(RingBuffer_Type *Ring, void *Element);
+
+/*********************************************************************
+* Service Name: RingBuffer_PushByte
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Data - Byte to be pushed
+* Parameters (inout): Ring - Ring buffer of 1-byte elements
+* Parameters (out): None
+* Return value: E_OK if the byte is pushed, E_NOT_OK if the ring buffer is full
+* Description: Function to push one byte without the generic copy, producer side only.
+**********************************************************************/
+Std_ReturnType RingBuffer_PushByte(RingBuffer_Type *Ring, uint8 Data);
+
+/*********************************************************************
+* Service Name: RingBuffer_PopByte
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): Ring - Ring buffer of 1-byte elements
+* Parameters (out): Data - Popped byte
+* Return value: E_OK if a byte is popped, E_NOT_OK if the ring buffer is empty
+* Description: Function to pop one byte without the generic copy, consumer side only.
+**********************************************************************/
+Std_ReturnType RingBuffer_PopByte(RingBuffer_Type *Ring, uint8 *Data);
+
+/*********************************************************************
+* Service Name: RingBuffer_PushWord
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Data - Word to be pushed
+* Parameters (inout): Ring - Ring buffer of 4-byte elements with word aligned storage
+* Parameters (out): None
+* Return value: E_OK if the word is pushed, E_NOT_OK if the ring buffer is full
+* Description: Function to push one word without the generic copy, producer side only.
+**********************************************************************/
+Std_ReturnType RingBuffer_PushWord(RingBuffer_Type *Ring, uint32 Data);
+
+/*********************************************************************
+* Service Name: RingBuffer_PopWord
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): Ring - Ring buffer of 4-byte elements with word aligned storage
+* Parameters (out): Data - Popped word
+* Return value: E_OK if a word is popped, E_NOT_OK if the ring buffer is empty
+* Description: Function to pop one word without the generic copy, consumer side only.
+**********************************************************************/
+Std_ReturnType RingBuffer_PopWord(RingBuffer_Type *Ring, uint32 *Data);
+
+/*********************************************************************
+* Service Name: RingBuffer_PushBulk
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): 1.Elements - Array of elements to be copied
+*                  2.Count - Number of elements in the array
+* Parameters (inout): Ring - Ring buffer
+* Parameters (out): None
+* Return value: Number of pushed elements, less than Count if the ring buffer gets full
+* Description: Function to push many elements with at most two copies and one Head update,
+*              producer side only.
+**********************************************************************/
+uint32 RingBuffer_PushBulk(RingBuffer_Type *Ring, const void *Elements, uint32 Count);
+
+/*********************************************************************
+* Service Name: RingBuffer_PopBulk
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Count - Maximum number of elements to pop
+* Parameters (inout): Ring - Ring buffer
+* Parameters (out): Elements - Array receiving the elements
+* Return value: Number of popped elements, less than Count if the ring buffer gets empty
+* Description: Function to pop many elements with at most two copies and one Tail update,
+*              consumer side only.
+**********************************************************************/
+uint32 RingBuffer_PopBulk(RingBuffer_Type *Ring, void *Elements, uint32 Count);
+
+/*********************************************************************
+* Service Name: RingBuffer_GetWriteSpan
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Ring - Ring buffer
+* Parameters (inout): None
+* Parameters (out): Span - Address of the first free element
+* Return value: Number of contiguous free elements at Span
+* Description: Function to get the contiguous free space for a direct write (e.g. by DMA),
+*              followed by RingBuffer_CommitWrite. Producer side only.
+**********************************************************************/
+uint32 RingBuffer_GetWriteSpan(const RingBuffer_Type *Ring, void **Span);
+
+/*********************************************************************
+* Service Name: RingBuffer_CommitWrite
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Count - Number of elements written, at most the last write span length
+* Parameters (inout): Ring - Ring buffer
+* Parameters (out): None
+* Return value: None
+* Description: Function to publish the elements written in the write span. Producer side only.
+**********************************************************************/
+void RingBuffer_CommitWrite(RingBuffer_Type *Ring, uint32 Count);
+
+/*********************************************************************
+* Service Name: RingBuffer_GetReadSpan
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Ring - Ring buffer
+* Parameters (inout): None
+* Parameters (out): Span - Address of the oldest element
+* Return value: Number of contiguous elements at Span
+* Description: Function to get the contiguous stored elements for a direct read (e.g. by DMA),
+*              followed by RingBuffer_CommitRead. Consumer side only.
+**********************************************************************/
+uint32 RingBuffer_GetReadSpan(const RingBuffer_Type *Ring, const void **Span);
+
+/*********************************************************************
+* Service Name: RingBuffer_CommitRead
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Count - Number of elements read, at most the last read span length
+* Parameters (inout): Ring - Ring buffer
+* Parameters (out): None
+* Return value: None
+* Description: Function to release the elements read from the read span. Consumer side only.
+**********************************************************************/
+void RingBuffer_CommitRead(RingBuffer_Type *Ring, uint32 Count);
+
+#endif /* RINGBUFFER_H_ */
@@ -0,0 +1,249 @@
+ /******************************************************************************
+ *
+ * Module: Scheduler
+ *
+ * File Name: Scheduler.c
+ *
+ * Description: Source file for the cooperative run-to-completion event scheduler
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "Scheduler.h"
+#include "NVIC.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+#define SCHEDULER_QUEUE_MASK                 (SCHEDULER_QUEUE_LENGTH - 1)
+
+/* Bit of a priority in the ready mask, priority 0 is bit 31 so the count of leading zeros
+ * of the ready mask is the highest ready priority */
+#define SCHEDULER_READY_BIT(PRIORITY)        (0x80000000UL >> (PRIORITY))
+
+#if ((SCHEDULER_QUEUE_LENGTH & SCHEDULER_QUEUE_MASK) != 0) || (SCHEDULER_PRIORITIES > 32)
+#error "SCHEDULER_QUEUE_LENGTH must be a power of 2 and SCHEDULER_PRIORITIES at most 32"
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    Scheduler_HandlerType Handler;
+    uint32 Param;
+    uint32 PostCycles;              /* Cycle counter value when the event was posted */
+}Scheduler_EventType;
+
+typedef struct
+{
+    Scheduler_EventType Events[SCHEDULER_QUEUE_LENGTH];
+    uint8 Head;                     /* Next event to dispatch */
+    uint8 Count;
+}Scheduler_QueueType;
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+static Scheduler_QueueType g_Queues[SCHEDULER_PRIORITIES];
+
+/* Bit set for every priority with a waiting event */
+static volatile uint32 g_ReadyMask = 0;
+
+static Scheduler_StatsType g_Stats;
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Scheduler_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to empty all the event queues.
+**********************************************************************/
+void Scheduler_Init(void)
+{
+    uint8 Priority;
+    NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    for(Priority = 0; Priority < SCHEDULER_PRIORITIES; Priority++)
+    {
+        g_Queues[Priority].Head = 0;
+        g_Queues[Priority].Count = 0;
+    }
+    g_ReadyMask = 0;
+
+    NVIC_ExitCritical(IntState);
+}
+
+/*********************************************************************
+* Service Name: Scheduler_Post
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Priority - Queue of the event (0 .. SCHEDULER_PRIORITIES - 1)
+*                  2.Handler - Function called from the main loop
+*                  3.Param - Parameter passed to the handler
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the event is queued, E_NOT_OK if the queue is full or the priority is invalid
+* Description: Function to queue an event, can be called from ISRs.
+**********************************************************************/
+Std_ReturnType Scheduler_Post(Scheduler_PriorityType Priority, Scheduler_HandlerType Handler, uint32 Param)
+{
+    Scheduler_QueueType *Queue;
+    Scheduler_EventType *Event;
+    NVIC_CriticalStateType IntState;
+
+    if((Priority >= SCHEDULER_PRIORITIES) || (Handler == NULL_PTR))
+    {
+        return E_NOT_OK;
+    }
+
+    Queue = &g_Queues[Priority];
+
+    IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    if(Queue->Count == SCHEDULER_QUEUE_LENGTH)
+    {
+        g_Stats.Dropped++;
+        NVIC_ExitCritical(IntState);
+        return E_NOT_OK;
+    }
+
+    Event = &Queue->Events[(Queue->Head + Queue->Count) & SCHEDULER_QUEUE_MASK];
+    Event->Handler = Handler;
+    Event->Param = Param;
+    Event->PostCycles = DWT_CYCCNT_REG;
+
+    Queue->Count++;
+    g_ReadyMask |= SCHEDULER_READY_BIT(Priority);
+
+    g_Stats.Posted++;
+    if(Queue->Count > g_Stats.MaxQueueDepth)
+    {
+        g_Stats.MaxQueueDepth = Queue->Count;
+    }
+
+    NVIC_ExitCritical(IntState);
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Scheduler_IsReady
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: TRUE if an event is waiting, FALSE otherwise
+* Description: Function to check whether an event is waiting. Called with interrupts disabled
+*              before sleeping so that an event posted after the check wakes the processor.
+**********************************************************************/
+boolean Scheduler_IsReady(void)
+{
+    return (g_ReadyMask != 0) ? TRUE : FALSE;
+}
+
+/*********************************************************************
+* Service Name: Scheduler_Dispatch
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Number of dispatched events
+* Description: Function to run the waiting events until all the queues are empty, the highest
+*              priority event first and events of the same priority in posting order.
+*              Called from the main loop only.
+**********************************************************************/
+uint32 Scheduler_Dispatch(void)
+{
+    Scheduler_QueueType *Queue;
+    Scheduler_HandlerType Handler;
+    uint32 Param;
+    uint32 Priority;
+    uint32 StartCycles;
+    uint32 HandlerStartCycles;
+    uint32 HandlerEndCycles;
+    uint32 Latency;
+    uint32 Overhead;
+    uint32 Dispatched = 0;
+    NVIC_CriticalStateType IntState;
+
+    while(g_ReadyMask != 0)
+    {
+        StartCycles = DWT_CYCCNT_REG;
+
+        IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+        /* Highest ready priority, a new event of higher priority posted by a handler is
+         * dispatched before the remaining events of lower priority */
+        Priority = _norm(g_ReadyMask);
+        Queue = &g_Queues[Priority];
+
+        Handler = Queue->Events[Queue->Head].Handler;
+        Param = Queue->Events[Queue->Head].Param;
+        Latency = StartCycles - Queue->Events[Queue->Head].PostCycles;
+
+        Queue->Head = (Queue->Head + 1) & SCHEDULER_QUEUE_MASK;
+        if(--Queue->Count == 0)
+        {
+            g_ReadyMask &= ~SCHEDULER_READY_BIT(Priority);
+        }
+
+        NVIC_ExitCritical(IntState);
+
+        /* Run to completion with interrupts enabled */
+        HandlerStartCycles = DWT_CYCCNT_REG;
+        Handler(Param);
+        HandlerEndCycles = DWT_CYCCNT_REG;
+
+        Dispatched++;
+
+        IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+        g_Stats.Dispatched++;
+        g_Stats.LastLatencyCycles = Latency;
+        if(Latency > g_Stats.MaxLatencyCycles)
+        {
+            g_Stats.MaxLatencyCycles = Latency;
+        }
+        Overhead = (HandlerStartCycles - StartCycles) + (DWT_CYCCNT_REG - HandlerEndCycles);
+        g_Stats.LastOverheadCycles = Overhead;
+        if(Overhead > g_Stats.MaxOverheadCycles)
+        {
+            g_Stats.MaxOverheadCycles = Overhead;
+        }
+        g_Stats.TotalOverheadCycles += Overhead;
+        NVIC_ExitCritical(IntState);
+    }
+
+    return Dispatched;
+}
+
+/*********************************************************************
+* Service Name: Scheduler_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Stats - Copy of the measurements
+* Return value: None
+* Description: Function to read the scheduler counters and overhead measurements.
+**********************************************************************/
+void Scheduler_GetStats(Scheduler_StatsType *a_Stats)
+{
+    NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+    *a_Stats = g_Stats;
+    NVIC_ExitCritical(IntState);
+}
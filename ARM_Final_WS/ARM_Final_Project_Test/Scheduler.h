@@ -0,0 +1,123 @@
+ /******************************************************************************
+ *
+ * Module: Scheduler
+ *
+ * File Name: Scheduler.h
+ *
+ * Description: header file for the cooperative run-to-completion event scheduler. ISRs post
+ *              events to prioritized queues and the main loop dispatches them, every handler
+ *              runs to completion in thread mode.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Number of event priorities, 0 is the highest priority */
+#define SCHEDULER_PRIORITIES                 4
+
+/* Number of events each priority queue can hold, must be a power of 2 */
+#define SCHEDULER_QUEUE_LENGTH               8
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef void (*Scheduler_HandlerType)(uint32 a_Param);
+
+typedef uint8 Scheduler_PriorityType;
+
+/* Measurements in core cycles, the cycle counter must be enabled by Delay_Init */
+typedef struct
+{
+    uint32 Posted;                  /* Events queued */
+    uint32 Dropped;                 /* Events lost because their queue was full */
+    uint32 Dispatched;              /* Events executed */
+    uint32 MaxQueueDepth;
+    uint32 LastOverheadCycles;      /* Dispatch time of an event excluding its handler */
+    uint32 MaxOverheadCycles;
+    uint64 TotalOverheadCycles;     /* Divided by Dispatched gives the mean overhead */
+    uint32 LastLatencyCycles;       /* From the post to the start of the handler */
+    uint32 MaxLatencyCycles;
+}Scheduler_StatsType;
+
+/*******************************************************************************
+ *                                Functions Prototypes                          *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Scheduler_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to empty all the event queues.
+**********************************************************************/
+void Scheduler_Init(void);
+
+/*********************************************************************
+* Service Name: Scheduler_Post
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Priority - Queue of the event (0 .. SCHEDULER_PRIORITIES - 1)
+*                  2.Handler - Function called from the main loop
+*                  3.Param - Parameter passed to the handler
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if the event is queued, E_NOT_OK if the queue is full or the priority is invalid
+* Description: Function to queue an event, can be called from ISRs.
+**********************************************************************/
+Std_ReturnType Scheduler_Post(Scheduler_PriorityType Priority, Scheduler_HandlerType Handler, uint32 Param);
+
+/*********************************************************************
+* Service Name: Scheduler_IsReady
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: TRUE if an event is waiting, FALSE otherwise
+* Description: Function to check whether an event is waiting. Called with interrupts disabled
+*              before sleeping so that an event posted after the check wakes the processor.
+**********************************************************************/
+boolean Scheduler_IsReady(void);
+
+/*********************************************************************
+* Service Name: Scheduler_Dispatch
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Number of dispatched events
+* Description: Function to run the waiting events until all the queues are empty, the highest
+*              priority event first and events of the same priority in posting order.
+*              Called from the main loop only.
+**********************************************************************/
+uint32 Scheduler_Dispatch(void);
+
+/*********************************************************************
+* Service Name: Scheduler_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Stats - Copy of the measurements
+* Return value: None
+* Description: Function to read the scheduler counters and overhead measurements.
+**********************************************************************/
+void Scheduler_GetStats(Scheduler_StatsType *a_Stats);
+
+#endif /* SCHEDULER_H_ */
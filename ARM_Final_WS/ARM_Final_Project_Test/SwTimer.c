@@ -0,0 +1,451 @@
+ /******************************************************************************
+ *
+ * Module: Software Timers
+ *
+ * File Name: SwTimer.c
+ *
+ * Description: Source file for the software timer service.
+ *
+ *              The running timers are hashed into a hierarchical timing wheel of
+ *              SWTIMER_LEVELS levels with SWTIMER_LEVEL_SLOTS slots each. Level 0 holds the
+ *              timers due in the next 64 ticks (one slot per tick), level 1 the timers due in
+ *              the next 64 * 64 ticks (one slot per 64 ticks) and so on. Each tick only the
+ *              current level 0 slot is processed, and every 64 ticks one slot of the upper
+ *              level is cascaded down, so the tick cost does not depend on the number of
+ *              running timers.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "SwTimer.h"
+#include "NVIC.h"
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+/* Slot lists of the wheel, each list is NULL terminated and every node keeps the
+ * address of the pointer that points to it (PPrev) so it can be unlinked in O(1) */
+static SwTimer_Type *g_Wheel[SWTIMER_LEVELS][SWTIMER_LEVEL_SLOTS];
+
+/* Next tick to be processed by the wheel */
+static volatile uint32 g_CurrentTick = 0;
+
+/*******************************************************************************
+ *                          Private Functions Definitions                      *
+ *******************************************************************************/
+
+/* Insert the timer in the slot matching its expiry tick. Called inside a critical section. */
+static void SwTimer_Link(SwTimer_Type *Timer)
+{
+    uint32 Expiry = Timer->Expiry;
+    uint32 Delta = Expiry - g_CurrentTick;
+    uint8 Level = 0;
+    SwTimer_Type **Slot;
+
+    if((sint32)Delta < 0)
+    {
+        /* Already due (e.g. the tick was held off), expire it on the next tick */
+        Delta = 0;
+        Expiry = g_CurrentTick;
+    }
+    else if(Delta > SWTIMER_MAX_DIRECT_TICKS)
+    {
+        /* Too far for the wheel, park it in the last level. It is re-inserted with the
+         * remaining delay when its slot is cascaded */
+        Delta = SWTIMER_MAX_DIRECT_TICKS;
+        Expiry = g_CurrentTick + SWTIMER_MAX_DIRECT_TICKS;
+    }
+
+    /* Find the first level able to hold the delay, at most SWTIMER_LEVELS - 1 iterations */
+    while((Level < (SWTIMER_LEVELS - 1)) && (Delta >= (SWTIMER_LEVEL_SLOTS << (Level * SWTIMER_LEVEL_BITS))))
+    {
+        Level++;
+    }
+
+    Slot = &g_Wheel[Level][(Expiry >> (Level * SWTIMER_LEVEL_BITS)) & SWTIMER_LEVEL_MASK];
+
+    /* Push the timer at the head of the slot list */
+    Timer->Next = *Slot;
+    if(Timer->Next != NULL_PTR)
+    {
+        Timer->Next->PPrev = &Timer->Next;
+    }
+    Timer->PPrev = Slot;
+    *Slot = Timer;
+}
+
+/* Remove the timer from the list it is linked in. Called inside a critical section. */
+static void SwTimer_Unlink(SwTimer_Type *Timer)
+{
+    *(Timer->PPrev) = Timer->Next;
+    if(Timer->Next != NULL_PTR)
+    {
+        Timer->Next->PPrev = Timer->PPrev;
+    }
+    Timer->Next = NULL_PTR;
+    Timer->PPrev = NULL_PTR;
+}
+
+/* Re-insert all the timers of the current slot of the given level in the lower levels.
+ * Returns the slot index so the caller knows if the next level has to be cascaded too. */
+static uint32 SwTimer_Cascade(uint8 Level)
+{
+    uint32 Index = (g_CurrentTick >> (Level * SWTIMER_LEVEL_BITS)) & SWTIMER_LEVEL_MASK;
+    SwTimer_Type *Timer = g_Wheel[Level][Index];
+    SwTimer_Type *Next;
+
+    g_Wheel[Level][Index] = NULL_PTR;
+
+    while(Timer != NULL_PTR)
+    {
+        Next = Timer->Next;
+        SwTimer_Link(Timer);
+        Timer = Next;
+    }
+
+    return Index;
+}
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: SwTimer_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to initialize the timing wheel. Must be called before the tick is started.
+**********************************************************************/
+void SwTimer_Init(void)
+{
+    uint8 Level;
+    uint8 Index;
+
+    for(Level = 0; Level < SWTIMER_LEVELS; Level++)
+    {
+        for(Index = 0; Index < SWTIMER_LEVEL_SLOTS; Index++)
+        {
+            g_Wheel[Level][Index] = NULL_PTR;
+        }
+    }
+
+    g_CurrentTick = 0;
+}
+
+/*********************************************************************
+* Service Name: SwTimer_Create
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Mode - One-shot or periodic timer
+*                  2.PeriodTicks - Timer period in ticks (1 .. SWTIMER_MAX_PERIOD_TICKS)
+*                  3.CallBack - Function called from the tick interrupt on expiry
+*                  4.Arg - User argument passed to the call back function
+* Parameters (inout): Timer - Timer control block to be initialized
+* Parameters (out): None
+* Return value: E_OK if the timer is created, E_NOT_OK for invalid parameters
+* Description: Function to initialize a timer control block. The timer is created stopped.
+**********************************************************************/
+Std_ReturnType SwTimer_Create(SwTimer_Type *Timer, SwTimer_ModeType Mode, uint32 PeriodTicks,
+                              SwTimer_CallBackType CallBack, void *Arg)
+{
+    if((Timer == NULL_PTR) || (CallBack == NULL_PTR) || (PeriodTicks == 0) || (PeriodTicks > SWTIMER_MAX_PERIOD_TICKS))
+    {
+        return E_NOT_OK;
+    }
+
+    Timer->Next = NULL_PTR;
+    Timer->PPrev = NULL_PTR;
+    Timer->Expiry = 0;
+    Timer->Period = PeriodTicks;
+    Timer->CallBack = CallBack;
+    Timer->Arg = Arg;
+    Timer->Mode = Mode;
+    Timer->Active = FALSE;
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: SwTimer_Start
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): Timer - Timer to be started
+* Parameters (out): None
+* Return value: E_OK if the timer is started, E_NOT_OK if it is already running
+* Description: Function to start a timer, it expires after its period from the current tick.
+**********************************************************************/
+Std_ReturnType SwTimer_Start(SwTimer_Type *Timer)
+{
+    Std_ReturnType Status = E_NOT_OK;
+    NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    if(Timer->Active == FALSE)
+    {
+        /* g_CurrentTick is the next tick to be processed, so a period of N ticks expires
+         * on the N-th tick interrupt from now */
+        Timer->Expiry = g_CurrentTick + Timer->Period - 1;
+        Timer->Active = TRUE;
+        SwTimer_Link(Timer);
+        Status = E_OK;
+    }
+
+    NVIC_ExitCritical(IntState);
+
+    return Status;
+}
+
+/*********************************************************************
+* Service Name: SwTimer_Stop
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): Timer - Timer to be stopped
+* Parameters (out): None
+* Return value: None
+* Description: Function to stop a timer, stopping a stopped timer has no effect.
+**********************************************************************/
+void SwTimer_Stop(SwTimer_Type *Timer)
+{
+    NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    if(Timer->Active == TRUE)
+    {
+        SwTimer_Unlink(Timer);
+        Timer->Active = FALSE;
+    }
+
+    NVIC_ExitCritical(IntState);
+}
+
+/*********************************************************************
+* Service Name: SwTimer_Restart
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): PeriodTicks - New period in ticks, 0 keeps the current period
+* Parameters (inout): Timer - Timer to be restarted
+* Parameters (out): None
+* Return value: E_OK if the timer is restarted, E_NOT_OK for an invalid period
+* Description: Function to stop a timer (if running) and start it again from the current tick.
+**********************************************************************/
+Std_ReturnType SwTimer_Restart(SwTimer_Type *Timer, uint32 PeriodTicks)
+{
+    NVIC_CriticalStateType IntState;
+
+    if(PeriodTicks > SWTIMER_MAX_PERIOD_TICKS)
+    {
+        return E_NOT_OK;
+    }
+
+    IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    if(Timer->Active == TRUE)
+    {
+        SwTimer_Unlink(Timer);
+    }
+
+    if(PeriodTicks != 0)
+    {
+        Timer->Period = PeriodTicks;
+    }
+
+    Timer->Expiry = g_CurrentTick + Timer->Period - 1;
+    Timer->Active = TRUE;
+    SwTimer_Link(Timer);
+
+    NVIC_ExitCritical(IntState);
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: SwTimer_IsActive
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Timer to be checked
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: TRUE if the timer is running, FALSE otherwise
+* Description: Function to check whether a timer is running.
+**********************************************************************/
+boolean SwTimer_IsActive(const SwTimer_Type *Timer)
+{
+    return Timer->Active;
+}
+
+/*********************************************************************
+* Service Name: SwTimer_GetTicks
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Number of ticks processed by the wheel
+* Description: Function to get the current tick of the timing wheel.
+**********************************************************************/
+uint32 SwTimer_GetTicks(void)
+{
+    return g_CurrentTick;
+}
+
+/*********************************************************************
+* Service Name: SwTimer_Tick
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to advance the wheel by one tick and call the expired timers.
+*              Called from the SysTick interrupt.
+**********************************************************************/
+void SwTimer_Tick(void)
+{
+    uint32 Index;
+    NVIC_CriticalStateType IntState;
+    SwTimer_Type *Expired;
+    SwTimer_Type *Timer;
+
+    IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    Index = g_CurrentTick & SWTIMER_LEVEL_MASK;
+
+    /* At the start of every level 0 round move the next slot of level 1 down, and
+     * every time level 1 wraps do the same with level 2 and so on */
+    if((Index == 0) && (SwTimer_Cascade(1) == 0) && (SwTimer_Cascade(2) == 0))
+    {
+        SwTimer_Cascade(3);
+    }
+
+    /* Advance the tick before calling the expired timers so timers started from a
+     * call back function are placed relative to the next tick */
+    g_CurrentTick++;
+
+    /* Detach the expired list, the local head lets call back functions stop other
+     * timers of the same list safely */
+    Expired = g_Wheel[0][Index];
+    g_Wheel[0][Index] = NULL_PTR;
+    if(Expired != NULL_PTR)
+    {
+        Expired->PPrev = &Expired;
+    }
+
+    while(Expired != NULL_PTR)
+    {
+        Timer = Expired;
+        SwTimer_Unlink(Timer);
+
+        if(Timer->Mode == SWTIMER_PERIODIC)
+        {
+            /* Keep the period phase locked to the original start tick */
+            Timer->Expiry += Timer->Period;
+            SwTimer_Link(Timer);
+        }
+        else
+        {
+            Timer->Active = FALSE;
+        }
+
+        /* Run the call back with interrupts enabled */
+        NVIC_ExitCritical(IntState);
+        Timer->CallBack(Timer->Arg);
+        IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+    }
+
+    NVIC_ExitCritical(IntState);
+}
+
+/*********************************************************************
+* Service Name: SwTimer_GetIdleTicks
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Number of ticks until the next tick that has work, counting that tick
+* Description: Function to find how many ticks can be skipped by a tickless idle. A return value
+*              of N means the next N - 1 ticks have nothing to expire or cascade, and
+*              SWTIMER_NO_PENDING_TICKS means no timer is running. Walks the empty slots of the
+*              wheel (at most SWTIMER_LEVELS * SWTIMER_LEVEL_SLOTS of them), so it is meant for the
+*              idle path only. Must be called with interrupts disabled.
+**********************************************************************/
+uint32 SwTimer_GetIdleTicks(void)
+{
+    uint32 Tick = g_CurrentTick;
+    uint32 Index = Tick & SWTIMER_LEVEL_MASK;
+    uint32 Nearest = SWTIMER_NO_PENDING_TICKS;
+    uint32 Distance;
+    uint32 Block;
+    uint32 Offset;
+    uint8 Level;
+
+    /* The next tick starts a new level 0 round and cascades the upper levels */
+    if(Index == 0)
+    {
+        return 1;
+    }
+
+    /* Level 0 has one slot per tick, its current slot is processed by the next tick */
+    for(Offset = 0; Offset < SWTIMER_LEVEL_SLOTS; Offset++)
+    {
+        if(g_Wheel[0][(Index + Offset) & SWTIMER_LEVEL_MASK] != NULL_PTR)
+        {
+            Nearest = Offset;
+            break;
+        }
+    }
+
+    /* The current slot of the upper levels is already cascaded, so their first busy slot
+     * after it is processed at the start of its block (the current slot itself one round later) */
+    for(Level = 1; Level < SWTIMER_LEVELS; Level++)
+    {
+        Block = Tick >> (Level * SWTIMER_LEVEL_BITS);
+
+        for(Offset = 1; Offset <= SWTIMER_LEVEL_SLOTS; Offset++)
+        {
+            if(g_Wheel[Level][(Block + Offset) & SWTIMER_LEVEL_MASK] != NULL_PTR)
+            {
+                Distance = ((Block + Offset) << (Level * SWTIMER_LEVEL_BITS)) - Tick;
+                if(Distance < Nearest)
+                {
+                    Nearest = Distance;
+                }
+                break;
+            }
+        }
+    }
+
+    if(Nearest == SWTIMER_NO_PENDING_TICKS)
+    {
+        /* No running timer at all */
+        return SWTIMER_NO_PENDING_TICKS;
+    }
+
+    return Nearest + 1;
+}
+
+/*********************************************************************
+* Service Name: SwTimer_SkipTicks
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Ticks - Number of ticks that elapsed without a tick interrupt
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to account the ticks suppressed by a tickless idle. Ticks must be less than
+*              the last value returned by SwTimer_GetIdleTicks. Must be called with interrupts
+*              disabled, before the interrupt that ended the idle is served.
+**********************************************************************/
+void SwTimer_SkipTicks(uint32 Ticks)
+{
+    g_CurrentTick += Ticks;
+}
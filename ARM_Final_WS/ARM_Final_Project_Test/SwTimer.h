@@ -0,0 +1,201 @@
+ /******************************************************************************
+ *
+ * Module: Software Timers
+ *
+ * File Name: SwTimer.h
+ *
+ * Description: header file for the software timer service driven by the SysTick tick.
+ *              Timers are kept in a hierarchical timing wheel so starting, stopping and
+ *              expiring a timer is O(1) whatever the number of running timers.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef SWTIMER_H_
+#define SWTIMER_H_
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Number of wheel levels and the number of slots in each level (2^SWTIMER_LEVEL_BITS) */
+#define SWTIMER_LEVELS                       4
+#define SWTIMER_LEVEL_BITS                   6
+#define SWTIMER_LEVEL_SLOTS                  (1UL<<SWTIMER_LEVEL_BITS)
+#define SWTIMER_LEVEL_MASK                   (SWTIMER_LEVEL_SLOTS - 1)
+
+/* Longest delay the wheel can hold directly (2^24 - 1 ticks), longer periods are
+ * parked in the last level and re-inserted until they become due */
+#define SWTIMER_MAX_DIRECT_TICKS             ((1UL<<(SWTIMER_LEVELS * SWTIMER_LEVEL_BITS)) - 1)
+
+/* Longest accepted period, keeps the wrap-around comparison of the 32-bit tick counter valid */
+#define SWTIMER_MAX_PERIOD_TICKS             0x7FFFFFFFUL
+
+/* Returned by SwTimer_GetIdleTicks when no timer is running */
+#define SWTIMER_NO_PENDING_TICKS             0xFFFFFFFFUL
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef void (*SwTimer_CallBackType)(void *a_Arg);
+
+typedef enum
+{
+    SWTIMER_ONE_SHOT,
+    SWTIMER_PERIODIC
+}SwTimer_ModeType;
+
+/* Timer control block, allocated by the user and linked into the wheel while running */
+typedef struct SwTimer_Struct
+{
+    struct SwTimer_Struct *Next;
+    struct SwTimer_Struct **PPrev;  /* Address of the pointer pointing to this timer */
+    uint32 Expiry;                  /* Absolute tick at which the timer expires */
+    uint32 Period;                  /* Period in ticks */
+    SwTimer_CallBackType CallBack;
+    void *Arg;
+    SwTimer_ModeType Mode;
+    boolean Active;
+}SwTimer_Type;
+
+/*******************************************************************************
+ *                                Functions Prototypes                          *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: SwTimer_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to initialize the timing wheel. Must be called before the tick is started.
+**********************************************************************/
+void SwTimer_Init(void);
+
+/*********************************************************************
+* Service Name: SwTimer_Create
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): 1.Mode - One-shot or periodic timer
+*                  2.PeriodTicks - Timer period in ticks (1 .. SWTIMER_MAX_PERIOD_TICKS)
+*                  3.CallBack - Function called from the tick interrupt on expiry
+*                  4.Arg - User argument passed to the call back function
+* Parameters (inout): Timer - Timer control block to be initialized
+* Parameters (out): None
+* Return value: E_OK if the timer is created, E_NOT_OK for invalid parameters
+* Description: Function to initialize a timer control block. The timer is created stopped.
+**********************************************************************/
+Std_ReturnType SwTimer_Create(SwTimer_Type *Timer, SwTimer_ModeType Mode, uint32 PeriodTicks,
+                              SwTimer_CallBackType CallBack, void *Arg);
+
+/*********************************************************************
+* Service Name: SwTimer_Start
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): Timer - Timer to be started
+* Parameters (out): None
+* Return value: E_OK if the timer is started, E_NOT_OK if it is already running
+* Description: Function to start a timer, it expires after its period from the current tick.
+**********************************************************************/
+Std_ReturnType SwTimer_Start(SwTimer_Type *Timer);
+
+/*********************************************************************
+* Service Name: SwTimer_Stop
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): Timer - Timer to be stopped
+* Parameters (out): None
+* Return value: None
+* Description: Function to stop a timer, stopping a stopped timer has no effect.
+**********************************************************************/
+void SwTimer_Stop(SwTimer_Type *Timer);
+
+/*********************************************************************
+* Service Name: SwTimer_Restart
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): PeriodTicks - New period in ticks, 0 keeps the current period
+* Parameters (inout): Timer - Timer to be restarted
+* Parameters (out): None
+* Return value: E_OK if the timer is restarted, E_NOT_OK for an invalid period
+* Description: Function to stop a timer (if running) and start it again from the current tick.
+**********************************************************************/
+Std_ReturnType SwTimer_Restart(SwTimer_Type *Timer, uint32 PeriodTicks);
+
+/*********************************************************************
+* Service Name: SwTimer_IsActive
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Timer to be checked
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: TRUE if the timer is running, FALSE otherwise
+* Description: Function to check whether a timer is running.
+**********************************************************************/
+boolean SwTimer_IsActive(const SwTimer_Type *Timer);
+
+/*********************************************************************
+* Service Name: SwTimer_GetTicks
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Number of ticks processed by the wheel
+* Description: Function to get the current tick of the timing wheel.
+**********************************************************************/
+uint32 SwTimer_GetTicks(void);
+
+/*********************************************************************
+* Service Name: SwTimer_Tick
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to advance the wheel by one tick and call the expired timers.
+*              Called from the SysTick interrupt.
+**********************************************************************/
+void SwTimer_Tick(void);
+
+/*********************************************************************
+* Service Name: SwTimer_GetIdleTicks
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Number of ticks until the next tick that has work, counting that tick
+* Description: Function to find how many ticks can be skipped by a tickless idle. A return value
+*              of N means the next N - 1 ticks have nothing to expire or cascade, and
+*              SWTIMER_NO_PENDING_TICKS means no timer is running.
+*              Must be called with interrupts disabled.
+**********************************************************************/
+uint32 SwTimer_GetIdleTicks(void);
+
+/*********************************************************************
+* Service Name: SwTimer_SkipTicks
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Ticks - Number of ticks that elapsed without a tick interrupt
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to account the ticks suppressed by a tickless idle. Ticks must be less than
+*              the last value returned by SwTimer_GetIdleTicks. Must be called with interrupts
+*              disabled, before the interrupt that ended the idle is served.
+**********************************************************************/
+void SwTimer_SkipTicks(uint32 Ticks);
+
+#endif /* SWTIMER_H_ */
@@ -0,0 +1,333 @@
+ /******************************************************************************
+ *
+ * Module: Software Interrupts
+ *
+ * File Name: Swi.c
+ *
+ * Description: Source file for the multi-level software interrupt executor
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "Swi.h"
+#include "NVIC.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* FIFO of the posted work items of one level, Tail points to the Next field of the last item */
+typedef struct
+{
+    Deferred_WorkType *Head;
+    Deferred_WorkType **Tail;
+}Swi_QueueType;
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+static const uint8 g_LevelIRQs[SWI_LEVELS] =
+{
+    SWI_LEVEL0_IRQ_NUM,
+    SWI_LEVEL1_IRQ_NUM,
+    SWI_LEVEL2_IRQ_NUM,
+    SWI_LEVEL3_IRQ_NUM
+};
+
+static Swi_QueueType g_Queues[SWI_LEVELS];
+
+static Swi_StatsType g_Stats[SWI_LEVELS];
+
+#if (SWI_BENCHMARK_ENABLE == TRUE)
+/* Cycle counter at the start of the probe work, latency measured by the nested work and the probe
+ * work items */
+static volatile uint32 g_BenchmarkStartCycles;
+static volatile uint32 g_BenchmarkNestedCycles;
+static Deferred_WorkType g_BenchmarkProbe;
+static Deferred_WorkType g_BenchmarkNested;
+
+/* Measurements of a level that has not run */
+static const Swi_StatsType g_ClearedStats = {0, 0, 0, 0, 0xFFFFFFFFUL, 0, 0};
+#endif
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Execute the queued work items of a level in posting order until its queue is empty.
+ * Runs in the level IRQ, a post to a higher level preempts it */
+static void Swi_Run(uint8 Level)
+{
+    Swi_QueueType *Queue = &g_Queues[Level];
+    Swi_StatsType *Stats = &g_Stats[Level];
+    Deferred_WorkType *Work;
+    uint32 PostCycles;
+    uint32 StartCycles;
+    uint32 Latency;
+    uint32 WorkCycles;
+    NVIC_CriticalStateType IntState;
+
+    while(1)
+    {
+        /* Take the first item, it may be posted again as soon as it is unlinked */
+        IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+        Work = Queue->Head;
+        if(Work == NULL_PTR)
+        {
+            NVIC_ExitCritical(IntState);
+            break;
+        }
+        Queue->Head = Work->Next;
+        if(Queue->Head == NULL_PTR)
+        {
+            Queue->Tail = &Queue->Head;
+        }
+        /* A higher level may post the item again once it is unlinked and overwrite its post time */
+        PostCycles = Work->PostCycles;
+        Work->Queued = FALSE;
+        NVIC_ExitCritical(IntState);
+
+        StartCycles = DWT_CYCCNT_REG;
+        Latency = StartCycles - PostCycles;
+
+        Work->WorkFunc(Work->Arg);
+
+        WorkCycles = DWT_CYCCNT_REG - StartCycles;
+
+        /* Only this level updates its measurements */
+        Stats->Executed++;
+        Stats->LastLatencyCycles = Latency;
+        if(Latency < Stats->MinLatencyCycles)
+        {
+            Stats->MinLatencyCycles = Latency;
+        }
+        if(Latency > Stats->MaxLatencyCycles)
+        {
+            Stats->MaxLatencyCycles = Latency;
+        }
+        if(WorkCycles > Stats->MaxWorkCycles)
+        {
+            Stats->MaxWorkCycles = WorkCycles;
+        }
+    }
+}
+
+#if (SWI_BENCHMARK_ENABLE == TRUE)
+/* Probe work, records when it starts */
+static void Swi_BenchmarkProbe(void *a_Arg)
+{
+    g_BenchmarkStartCycles = DWT_CYCCNT_REG;
+}
+
+/* Work of the lowest level, posts the probe at level 0 which preempts it at once */
+static void Swi_BenchmarkNested(void *a_Arg)
+{
+    uint32 Start = DWT_CYCCNT_REG;
+
+    (void)Swi_Post(0, &g_BenchmarkProbe);
+    g_BenchmarkNestedCycles = g_BenchmarkStartCycles - Start;
+}
+#endif
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Swi_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if every level has a higher priority than the next one, E_NOT_OK otherwise
+* Description: Function to empty the level queues and check the level priorities set by NVIC_Init.
+**********************************************************************/
+Std_ReturnType Swi_Init(void)
+{
+    Std_ReturnType Status = E_OK;
+    uint8 Level;
+
+    for(Level = 0; Level < SWI_LEVELS; Level++)
+    {
+        g_Queues[Level].Head = NULL_PTR;
+        g_Queues[Level].Tail = &g_Queues[Level].Head;
+        g_Stats[Level].MinLatencyCycles = 0xFFFFFFFFUL;
+
+        /* A level must be able to preempt the next one and must not preempt the services critical sections */
+        if(NVIC_GetPriorityIRQ(g_LevelIRQs[Level]) < NVIC_SERVICES_CEILING_PRIORITY)
+        {
+            Status = E_NOT_OK;
+        }
+        if((Level > 0) && (NVIC_GetPriorityIRQ(g_LevelIRQs[Level]) <= NVIC_GetPriorityIRQ(g_LevelIRQs[Level - 1])))
+        {
+            Status = E_NOT_OK;
+        }
+    }
+
+    return Status;
+}
+
+/*********************************************************************
+* Service Name: Swi_Post
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): Level - Level running the work (0 .. SWI_LEVELS - 1)
+* Parameters (inout): Work - Work item created by Deferred_Create
+* Parameters (out): None
+* Return value: E_OK if the item is queued, E_NOT_OK for an invalid level or if it is still queued
+* Description: Function to queue a work item at a level and pend the level IRQ. The work runs as soon as
+*              no interrupt of the same or a higher priority is active, the caller is preempted when
+*              the level has a higher priority. Can be called from ISRs of the services ceiling or lower.
+**********************************************************************/
+Std_ReturnType Swi_Post(uint8 Level, Deferred_WorkType *Work)
+{
+    NVIC_CriticalStateType IntState;
+
+    if(Level >= SWI_LEVELS)
+    {
+        return E_NOT_OK;
+    }
+
+    IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+    if(Work->Queued)
+    {
+        g_Stats[Level].Coalesced++;
+        NVIC_ExitCritical(IntState);
+        return E_NOT_OK;
+    }
+
+    Work->Next = NULL_PTR;
+    Work->PostCycles = DWT_CYCCNT_REG;
+    Work->Queued = TRUE;
+    *g_Queues[Level].Tail = Work;
+    g_Queues[Level].Tail = &Work->Next;
+    g_Stats[Level].Posted++;
+
+    /* Pending the IRQ again while it is pending has no effect, the level runs its whole queue */
+    NVIC_SetPendingIRQ(g_LevelIRQs[Level]);
+
+    NVIC_ExitCritical(IntState);
+
+    return E_OK;
+}
+
+/*********************************************************************
+* Service Name: Swi_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Level - Level (0 .. SWI_LEVELS - 1)
+* Parameters (inout): None
+* Parameters (out): a_Stats - Copy of the measurements of the level
+* Return value: E_OK if the stats are copied, E_NOT_OK for an invalid level
+* Description: Function to read the post-to-start latency and the work time of one level.
+**********************************************************************/
+Std_ReturnType Swi_GetStats(uint8 Level, Swi_StatsType *a_Stats)
+{
+    NVIC_CriticalStateType IntState;
+
+    if(Level >= SWI_LEVELS)
+    {
+        return E_NOT_OK;
+    }
+
+    IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+    *a_Stats = g_Stats[Level];
+    NVIC_ExitCritical(IntState);
+
+    return E_OK;
+}
+
+#if (SWI_BENCHMARK_ENABLE == TRUE)
+/*********************************************************************
+* Service Name: Swi_Benchmark
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Result - Shortest post-to-start latency of every level and of a nested post
+* Return value: None
+* Description: Function to measure the levels with probe work items posted from thread mode, the
+*              interrupts are enabled while it runs. Swi_Init and NVIC_Init must be called before, the
+*              measurements of Swi_GetStats are cleared afterwards.
+**********************************************************************/
+void Swi_Benchmark(Swi_BenchmarkType *a_Result)
+{
+    uint32 IntState;
+    uint32 Start;
+    uint32 Cycles;
+    uint8 Level;
+    uint8 Run;
+
+    (void)Deferred_Create(&g_BenchmarkProbe, Swi_BenchmarkProbe, NULL_PTR);
+    (void)Deferred_Create(&g_BenchmarkNested, Swi_BenchmarkNested, NULL_PTR);
+
+    /* Every level has a higher priority than thread mode, the probe runs before Swi_Post returns.
+     * A tick taken meanwhile only lengthens that run, the minimum is kept */
+    IntState = _enable_IRQ();
+
+    for(Level = 0; Level < SWI_LEVELS; Level++)
+    {
+        a_Result->PostToStartCycles[Level] = 0xFFFFFFFFUL;
+        for(Run = 0; Run < SWI_BENCHMARK_RUNS; Run++)
+        {
+            Start = DWT_CYCCNT_REG;
+            (void)Swi_Post(Level, &g_BenchmarkProbe);
+            Cycles = g_BenchmarkStartCycles - Start;
+            if(Cycles < a_Result->PostToStartCycles[Level])
+            {
+                a_Result->PostToStartCycles[Level] = Cycles;
+            }
+        }
+    }
+
+    a_Result->PreemptCycles = 0xFFFFFFFFUL;
+    for(Run = 0; Run < SWI_BENCHMARK_RUNS; Run++)
+    {
+        (void)Swi_Post(SWI_LEVELS - 1, &g_BenchmarkNested);
+        if(g_BenchmarkNestedCycles < a_Result->PreemptCycles)
+        {
+            a_Result->PreemptCycles = g_BenchmarkNestedCycles;
+        }
+    }
+
+    _restore_interrupts(IntState);
+
+    /* The probes are not application work, every level is idle again */
+    for(Level = 0; Level < SWI_LEVELS; Level++)
+    {
+        g_Stats[Level] = g_ClearedStats;
+    }
+}
+#endif
+
+/*******************************************************************************
+ *                          Interrupt Handlers                                 *
+ *******************************************************************************/
+
+void Swi_Level0_Handler(void)
+{
+    Swi_Run(0);
+}
+
+void Swi_Level1_Handler(void)
+{
+    Swi_Run(1);
+}
+
+void Swi_Level2_Handler(void)
+{
+    Swi_Run(2);
+}
+
+void Swi_Level3_Handler(void)
+{
+    Swi_Run(3);
+}
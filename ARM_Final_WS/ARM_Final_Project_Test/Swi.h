@@ -0,0 +1,143 @@
+ /******************************************************************************
+ *
+ * Module: Software Interrupts
+ *
+ * File Name: Swi.h
+ *
+ * Description: header file for the multi-level software interrupt executor. Each level owns an IRQ
+ *              of a peripheral the application does not use, posting work at a level pends this IRQ
+ *              so the NVIC runs the levels nested and preemptive in their priority order. The level
+ *              IRQs, priorities and handlers are listed in NVIC_Cfg.h.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef SWI_H_
+#define SWI_H_
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include "std_types.h"
+#include "Deferred.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Number of levels, level 0 has the highest priority */
+#define SWI_LEVELS                           4
+
+/* IRQ of each level (Timer 4A, Timer 4B, Timer 5A and Timer 5B, unused by the application) */
+#define SWI_LEVEL0_IRQ_NUM                   70
+#define SWI_LEVEL1_IRQ_NUM                   71
+#define SWI_LEVEL2_IRQ_NUM                   92
+#define SWI_LEVEL3_IRQ_NUM                   93
+
+/* Swi_Benchmark measures the post-to-start latency of every level when TRUE */
+#ifndef SWI_BENCHMARK_ENABLE
+#define SWI_BENCHMARK_ENABLE                 FALSE
+#endif
+
+/* Posts of each measurement made by Swi_Benchmark, the minimum is kept */
+#define SWI_BENCHMARK_RUNS                   64
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Measurements of one level in core cycles, the cycle counter must be enabled by Delay_Init */
+typedef struct
+{
+    uint32 Posted;                  /* Work items queued */
+    uint32 Coalesced;               /* Posts of an item that was still queued */
+    uint32 Executed;                /* Work items executed */
+    uint32 LastLatencyCycles;       /* From the post to the start of the work */
+    uint32 MinLatencyCycles;
+    uint32 MaxLatencyCycles;
+    uint32 MaxWorkCycles;           /* Execution time of the work */
+}Swi_StatsType;
+
+/* Shortest latencies in core cycles, the cycle counter must be enabled by Delay_Init */
+typedef struct
+{
+    uint32 PostToStartCycles[SWI_LEVELS];   /* From the call of Swi_Post in thread mode to the start of the work */
+    uint32 PreemptCycles;                   /* From a post at level 0 in a work of the lowest level to the
+                                             * start of the work, the preemption of one level by another */
+}Swi_BenchmarkType;
+
+/*******************************************************************************
+ *                                Functions Prototypes                          *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Swi_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: E_OK if every level has a higher priority than the next one, E_NOT_OK otherwise
+* Description: Function to empty the level queues and check the level priorities set by NVIC_Init.
+**********************************************************************/
+Std_ReturnType Swi_Init(void);
+
+/*********************************************************************
+* Service Name: Swi_Post
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): Level - Level running the work (0 .. SWI_LEVELS - 1)
+* Parameters (inout): Work - Work item created by Deferred_Create
+* Parameters (out): None
+* Return value: E_OK if the item is queued, E_NOT_OK for an invalid level or if it is still queued
+* Description: Function to queue a work item at a level and pend the level IRQ. The work runs as soon as
+*              no interrupt of the same or a higher priority is active, the caller is preempted when
+*              the level has a higher priority. Can be called from ISRs of the services ceiling or lower.
+**********************************************************************/
+Std_ReturnType Swi_Post(uint8 Level, Deferred_WorkType *Work);
+
+/*********************************************************************
+* Service Name: Swi_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Level - Level (0 .. SWI_LEVELS - 1)
+* Parameters (inout): None
+* Parameters (out): a_Stats - Copy of the measurements of the level
+* Return value: E_OK if the stats are copied, E_NOT_OK for an invalid level
+* Description: Function to read the post-to-start latency and the work time of one level.
+**********************************************************************/
+Std_ReturnType Swi_GetStats(uint8 Level, Swi_StatsType *a_Stats);
+
+#if (SWI_BENCHMARK_ENABLE == TRUE)
+/*********************************************************************
+* Service Name: Swi_Benchmark
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): a_Result - Shortest post-to-start latency of every level and of a nested post
+* Return value: None
+* Description: Function to measure the levels with probe work items posted from thread mode, the
+*              interrupts are enabled while it runs. Swi_Init and NVIC_Init must be called before, the
+*              measurements of Swi_GetStats are cleared afterwards.
+**********************************************************************/
+void Swi_Benchmark(Swi_BenchmarkType *a_Result);
+#endif
+
+/*********************************************************************
+* Service Name: Swi_LevelN_Handler
+* Sync/Async: Asynchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Handlers of the level IRQs, installed by NVIC_Init.
+**********************************************************************/
+void Swi_Level0_Handler(void);
+void Swi_Level1_Handler(void);
+void Swi_Level2_Handler(void);
+void Swi_Level3_Handler(void);
+
+#endif /* SWI_H_ */
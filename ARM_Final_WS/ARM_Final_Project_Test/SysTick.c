@@ -14,12 +14,171 @@
  *                            Header Files                                     *
  *******************************************************************************/
 #include "SysTick.h"
+#include "NVIC.h"
+#include "IsrProfiler.h"
+#include "Fpu.h"
 #include "tm4c123gh6pm_registers.h"
 
+#if (SYSTICK_HOOK_MODE == SYSTICK_HOOK_STATIC)
+/* SYSTICK_STATIC_HOOKS() of the application */
+#include "App_Cfg.h"
+#endif
+
+/*******************************************************************************
+ *                          Preprocessor Definitions                           *
+ *******************************************************************************/
+
+/* PENDSTSET bit in the Interrupt Control and State register, set while the SysTick
+ * exception is pending (counter reloaded but SysTick_Handler not executed yet) */
+#define SYSTICK_PENDSTSET_MASK          0x04000000
+
+/* Run-Mode Clock Configuration (RCC and RCC2) fields used to find the core clock */
+#define SYSCTL_RCC_OSCSRC_MASK          0x00000030
+#define SYSCTL_RCC_OSCSRC_POS           4
+#define SYSCTL_RCC_XTAL_MASK            0x000007C0
+#define SYSCTL_RCC_XTAL_POS             6
+#define SYSCTL_RCC_BYPASS_MASK          0x00000800
+#define SYSCTL_RCC_USESYSDIV_MASK       0x00400000
+#define SYSCTL_RCC_SYSDIV_MASK          0x07800000
+#define SYSCTL_RCC_SYSDIV_POS           23
+
+#define SYSCTL_RCC2_OSCSRC2_MASK        0x00000070
+#define SYSCTL_RCC2_OSCSRC2_POS         4
+#define SYSCTL_RCC2_BYPASS2_MASK        0x00000800
+#define SYSCTL_RCC2_SYSDIV2_MASK        0x1F800000
+#define SYSCTL_RCC2_SYSDIV2_POS         23
+#define SYSCTL_RCC2_SYSDIV2LSB_MASK     0x00400000
+#define SYSCTL_RCC2_DIV400_MASK         0x40000000
+#define SYSCTL_RCC2_USERCC2_MASK        0x80000000
+
+/* Oscillator sources of the OSCSRC / OSCSRC2 fields */
+#define SYSCTL_OSCSRC_MOSC              0
+#define SYSCTL_OSCSRC_PIOSC             1
+#define SYSCTL_OSCSRC_PIOSC_DIV4        2
+#define SYSCTL_OSCSRC_LFIOSC            3
+#define SYSCTL_OSCSRC_32KHZ             7
+
+#define SYSCTL_PIOSC_HZ                 16000000UL
+#define SYSCTL_LFIOSC_HZ                30000UL
+#define SYSCTL_32KHZ_OSC_HZ             32768UL
+#define SYSCTL_PLL_VCO_HZ               400000000UL
+
+/* First valid value of the XTAL field (4 MHz) */
+#define SYSCTL_XTAL_FIRST               0x06
+
+#if (SYSTICK_BENCHMARK_ENABLE == TRUE)
+/* Measure one call of READ with the interrupts disabled into the SysTick_ReadCostType COST, the cost
+ * of reading the cycle counter (OVERHEAD) removed */
+#define SYSTICK_MEASURE_READ(READ, OVERHEAD, COST)                                      \
+    do                                                                                  \
+    {                                                                                   \
+        uint32 IntState_ = _disable_IRQ();                                              \
+        uint32 Start_ = DWT_CYCCNT_REG;                                                 \
+        uint32 Cycles_;                                                                 \
+        g_BenchmarkSink = (uint64)READ();                                               \
+        Cycles_ = DWT_CYCCNT_REG - Start_ - (OVERHEAD);                                 \
+        _restore_interrupts(IntState_);                                                 \
+        if(Cycles_ < (COST).MinCycles)                                                  \
+        {                                                                               \
+            (COST).MinCycles = Cycles_;                                                 \
+        }                                                                               \
+        if(Cycles_ > (COST).MaxCycles)                                                  \
+        {                                                                               \
+            (COST).MaxCycles = Cycles_;                                                 \
+        }                                                                               \
+    } while(0)
+#endif
+
 /*******************************************************************************
  *                          Global Variables                                   *
  *******************************************************************************/
+#if (SYSTICK_HOOK_MODE == SYSTICK_HOOK_RUNTIME)
 static volatile void (*g_callBackPtr)(void) = NULL_PTR;
+#endif
+
+/* Main oscillator frequency of each XTAL field value, starting from SYSCTL_XTAL_FIRST */
+static const uint32 g_XtalFrequency[] =
+{
+    4000000UL,  4096000UL,  4915200UL,  5000000UL,  5120000UL,  6000000UL,  6144000UL,
+    7372800UL,  8000000UL,  8192000UL,  10000000UL, 12000000UL, 12288000UL, 13560000UL,
+    14318180UL, 16000000UL, 16384000UL, 18000000UL, 20000000UL, 24000000UL, 25000000UL
+};
+
+/* Core clock used to compute the reload values */
+static uint32 g_CoreClockHz = SYSTICK_CORE_CLOCK_HZ;
+
+
+/* Number of hardware periods in one tick (software prescaler) and the number of
+ * hardware periods remaining until the next tick */
+static uint32 g_Prescaler = 1;
+static volatile uint32 g_PrescalerCount = 1;
+
+/* Core cycles in one tick */
+static uint64 g_CyclesPerTick = 0;
+
+/* Low 32 bits of the number of SysTick interrupts since SysTick_Init */
+static volatile uint32 g_TicksLow = 0;
+
+/* Number of times bit 31 of g_TicksLow toggled. The high 32 bits of the tick count are
+ * g_TicksEpoch / 2, and bit 0 of g_TicksEpoch always matches bit 31 of g_TicksLow once
+ * the handler has finished, which lets a reader detect an epoch it read too early */
+static volatile uint32 g_TicksEpoch = 0;
+
+/* Reload value of the running hardware period (cycles per hardware period - 1) */
+static uint32 g_ReloadValue = 0;
+
+/* Duration of one tick in microseconds */
+static uint32 g_MicrosPerTick = 0;
+
+/* Microseconds per core cycle scaled by 2^32 (g_MicrosPerTick * 2^32 / g_CyclesPerTick, rounded down),
+ * the microseconds of a partial tick are then always below g_MicrosPerTick */
+static uint64 g_MicrosPerCycleQ32 = 0;
+
+/* Idle loop statistics */
+static SysTick_IdleStatsType g_IdleStats;
+
+#if (SYSTICK_BENCHMARK_ENABLE == TRUE)
+/* Keeps the measured reads from being optimized away */
+static volatile uint64 g_BenchmarkSink;
+
+/* Empty tick consumer of the hook modes benchmark, bound like g_callBackPtr in the runtime mode */
+static volatile uint32 g_BenchmarkHookCalls;
+static void (* volatile g_BenchmarkHookPtr)(void) = NULL_PTR;
+#endif
+
+#if (SYSTICK_MEASURE_LATENCY == TRUE)
+/* Tick latency measurements, MinCycles starts at the largest value so the first sample replaces it */
+static SysTick_LatencyStatsType g_LatencyStats = {0, 0, 0xFFFFFFFFUL, 0};
+#endif
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Account one hardware period of the counter in the time base, TRUE when it completes a tick.
+ * Called first by SysTick_Handler */
+static boolean SysTick_CountTick(void)
+{
+    uint32 Ticks;
+
+    if(g_PrescalerCount > 1)
+    {
+        /* Period longer than the 24-bit counter, wait for the remaining hardware periods */
+        g_PrescalerCount--;
+        return FALSE;
+    }
+
+    Ticks = g_TicksLow + 1;
+    g_TicksLow = Ticks;
+    if((Ticks & 0x7FFFFFFF) == 0)
+    {
+        /* Bit 31 of the low word toggled */
+        g_TicksEpoch++;
+    }
+    g_PrescalerCount = g_Prescaler;
+
+    return TRUE;
+}
 
 /*******************************************************************************
  *                          Exception Handlers                                 *
@@ -36,17 +195,189 @@ static volatile void (*g_callBackPtr)(void) = NULL_PTR;
 **********************************************************************/
  void SysTick_Handler(void)
  {
-     if(g_callBackPtr != NULL_PTR)
+     /* Count the tick before anything else. The exception entry cleared PENDSTSET, so until the count
+      * is stored a higher priority reader of the time base sees the reloaded counter with the count
+      * of the previous tick. The window is now the load, add and store of SysTick_CountTick */
+     boolean TickDone = SysTick_CountTick();
+#if (SYSTICK_MEASURE_LATENCY == TRUE)
+     /* The counter reloaded g_ReloadValue when it wrapped, also after a tickless sleep that
+      * restores the normal reload value before the wrap */
+     uint32 Latency = g_ReloadValue - SYSTICK_CURRENT_REG;
+#endif
+     ISR_PROFILER_ENTER(ISR_PROFILER_SYSTICK);
+     FPU_ISR_ENTER();
+
+     if(TickDone)
      {
-         /* Call back function in main application after edge detected */
-         (*g_callBackPtr)();
+#if (SYSTICK_MEASURE_LATENCY == TRUE)
+         g_LatencyStats.Samples++;
+         g_LatencyStats.LastCycles = Latency;
+         if(Latency < g_LatencyStats.MinCycles)
+         {
+             g_LatencyStats.MinCycles = Latency;
+         }
+         if(Latency > g_LatencyStats.MaxCycles)
+         {
+             g_LatencyStats.MaxCycles = Latency;
+         }
+#endif
+
+#if (SYSTICK_HOOK_MODE == SYSTICK_HOOK_STATIC)
+         /* Tick consumers bound at build time */
+         SYSTICK_STATIC_HOOKS();
+#else
+         if(g_callBackPtr != NULL_PTR)
+         {
+             /* Call back function in main application after edge detected */
+             (*g_callBackPtr)();
+         }
+#endif
      }
+
+     FPU_ISR_EXIT();
+     ISR_PROFILER_EXIT(ISR_PROFILER_SYSTICK);
  }
 
 /*******************************************************************************
  *                      Functions Definitions                                  *
  *******************************************************************************/
 
+ /*********************************************************************
+ * Service Name: SysTick_ReadCoreClock
+ * Sync/Async: Synchronous
+ * Reentrancy: reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Core clock frequency in Hz, 0 if the configuration is not supported
+ * Description: Function to find the core clock from the RCC/RCC2 oscillator source, PLL
+                bypass and system divider settings.
+ **********************************************************************/
+ static uint32 SysTick_ReadCoreClock(void)
+ {
+     uint32 Rcc = SYSCTL_RCC_REG;
+     uint32 Rcc2 = SYSCTL_RCC2_REG;
+     uint32 Xtal = (Rcc & SYSCTL_RCC_XTAL_MASK) >> SYSCTL_RCC_XTAL_POS;
+     uint32 OscSource;
+     uint32 OscHz;
+     uint32 Divider;
+     boolean Bypass;
+
+     if(Rcc2 & SYSCTL_RCC2_USERCC2_MASK)
+     {
+         OscSource = (Rcc2 & SYSCTL_RCC2_OSCSRC2_MASK) >> SYSCTL_RCC2_OSCSRC2_POS;
+         Bypass = (Rcc2 & SYSCTL_RCC2_BYPASS2_MASK) ? TRUE : FALSE;
+     }
+     else
+     {
+         OscSource = (Rcc & SYSCTL_RCC_OSCSRC_MASK) >> SYSCTL_RCC_OSCSRC_POS;
+         Bypass = (Rcc & SYSCTL_RCC_BYPASS_MASK) ? TRUE : FALSE;
+     }
+
+     if(Bypass == FALSE)
+     {
+         /* PLL running from a 400 MHz VCO, divided by 2 unless DIV400 is used */
+         if((Rcc2 & SYSCTL_RCC2_USERCC2_MASK) && (Rcc2 & SYSCTL_RCC2_DIV400_MASK))
+         {
+             Divider = (((Rcc2 & SYSCTL_RCC2_SYSDIV2_MASK) >> SYSCTL_RCC2_SYSDIV2_POS) << 1)
+                       | ((Rcc2 & SYSCTL_RCC2_SYSDIV2LSB_MASK) ? 1 : 0);
+             return SYSCTL_PLL_VCO_HZ / (Divider + 1);
+         }
+         else if(Rcc2 & SYSCTL_RCC2_USERCC2_MASK)
+         {
+             Divider = (Rcc2 & SYSCTL_RCC2_SYSDIV2_MASK) >> SYSCTL_RCC2_SYSDIV2_POS;
+         }
+         else
+         {
+             Divider = (Rcc & SYSCTL_RCC_SYSDIV_MASK) >> SYSCTL_RCC_SYSDIV_POS;
+         }
+         return (SYSCTL_PLL_VCO_HZ / 2) / (Divider + 1);
+     }
+
+     switch(OscSource)
+     {
+     case SYSCTL_OSCSRC_MOSC:
+         if((Xtal < SYSCTL_XTAL_FIRST) || ((Xtal - SYSCTL_XTAL_FIRST) >= (sizeof(g_XtalFrequency) / sizeof(g_XtalFrequency[0]))))
+         {
+             return 0;
+         }
+         OscHz = g_XtalFrequency[Xtal - SYSCTL_XTAL_FIRST];
+         break;
+     case SYSCTL_OSCSRC_PIOSC:
+         OscHz = SYSCTL_PIOSC_HZ;
+         break;
+     case SYSCTL_OSCSRC_PIOSC_DIV4:
+         OscHz = SYSCTL_PIOSC_HZ / 4;
+         break;
+     case SYSCTL_OSCSRC_LFIOSC:
+         OscHz = SYSCTL_LFIOSC_HZ;
+         break;
+     case SYSCTL_OSCSRC_32KHZ:
+         OscHz = SYSCTL_32KHZ_OSC_HZ;
+         break;
+     default:
+         return 0;
+     }
+
+     /* Without the PLL the oscillator is divided only if USESYSDIV is set */
+     if(Rcc & SYSCTL_RCC_USESYSDIV_MASK)
+     {
+         if(Rcc2 & SYSCTL_RCC2_USERCC2_MASK)
+         {
+             Divider = (Rcc2 & SYSCTL_RCC2_SYSDIV2_MASK) >> SYSCTL_RCC2_SYSDIV2_POS;
+         }
+         else
+         {
+             Divider = (Rcc & SYSCTL_RCC_SYSDIV_MASK) >> SYSCTL_RCC_SYSDIV_POS;
+         }
+         OscHz /= (Divider + 1);
+     }
+
+     return OscHz;
+ }
+
+ /*********************************************************************
+ * Service Name: SysTick_ComputePeriod
+ * Sync/Async: Synchronous
+ * Reentrancy: reentrant
+ * Parameters (in): a_TimeInMicroSeconds - Required period in microseconds
+ * Parameters (inout): None
+ * Parameters (out): 1.a_Reload - Reload value of the hardware period
+ *                   2.a_Prescaler - Number of hardware periods in the required period
+ * Return value: E_OK if the period can be generated, E_NOT_OK otherwise
+ * Description: Function to split the required period into hardware periods that fit the 24-bit
+                counter. Periods longer than the counter range are divided into the smallest
+                number of equal hardware periods, rounded to the nearest cycle.
+ **********************************************************************/
+ static Std_ReturnType SysTick_ComputePeriod(uint32 a_TimeInMicroSeconds, uint32 *a_Reload, uint32 *a_Prescaler)
+ {
+     uint64 Cycles;
+     uint32 Prescaler;
+     uint32 Period;
+
+     if((a_TimeInMicroSeconds == 0) || (g_CoreClockHz < 1000000UL))
+     {
+         return E_NOT_OK;
+     }
+
+     Cycles = (((uint64)a_TimeInMicroSeconds * g_CoreClockHz) + 500000UL) / 1000000UL;
+
+     /* Smallest number of hardware periods that fit the counter */
+     Prescaler = (uint32)((Cycles + SYSTICK_MAX_RELOAD_VALUE) / (SYSTICK_MAX_RELOAD_VALUE + 1));
+     Period = (uint32)((Cycles + (Prescaler / 2)) / Prescaler);
+
+     if(Period < SYSTICK_MIN_PERIOD_CYCLES)
+     {
+         /* Too short to leave any time outside the SysTick interrupt */
+         return E_NOT_OK;
+     }
+
+     *a_Reload = Period - 1;
+     *a_Prescaler = Prescaler;
+
+     return E_OK;
+ }
+
  /*********************************************************************
  * Service Name: SysTick_Init
  * Sync/Async: Synchronous
@@ -54,17 +385,59 @@ static volatile void (*g_callBackPtr)(void) = NULL_PTR;
  * Parameters (in): a_TimeInMilliSeconds - Required Time delay in milliseconds
  * Parameters (inout): None
  * Parameters (out): None
- * Return value: None
+ * Return value: E_OK if the timer is started, E_NOT_OK if the period is out of range
  * Description: Function to initialize SysTick Timer with  the specified time in milliseconds
                 using interrupts.
  **********************************************************************/
+ Std_ReturnType SysTick_Init(uint16 a_TimeInMilliSeconds)
+ {
+     return SysTick_InitMicros((uint32)a_TimeInMilliSeconds * 1000UL);
+ }
 
- void SysTick_Init(uint16 a_TimeInMilliSeconds)
+ /*********************************************************************
+ * Service Name: SysTick_InitMicros
+ * Sync/Async: Synchronous
+ * Reentrancy: non reentrant
+ * Parameters (in): a_TimeInMicroSeconds - Required tick period in microseconds
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: E_OK if the timer is started, E_NOT_OK if the period is out of range
+ * Description: Function to initialize SysTick Timer with the specified period in microseconds
+                using interrupts. The reload value is derived from the actual core clock, and
+                periods longer than the 24-bit counter are handled by a software prescaler.
+                The timer is left untouched if the period is out of range.
+ **********************************************************************/
+ Std_ReturnType SysTick_InitMicros(uint32 a_TimeInMicroSeconds)
  {
+     uint32 Reload;
+     uint32 Prescaler;
+     uint32 CoreClockHz = SysTick_ReadCoreClock();
+
+     if(CoreClockHz == 0)
+     {
+         return E_NOT_OK;
+     }
+     g_CoreClockHz = CoreClockHz;
+
+     if(SysTick_ComputePeriod(a_TimeInMicroSeconds, &Reload, &Prescaler) != E_OK)
+     {
+         return E_NOT_OK;
+     }
+
      SYSTICK_CTRL_REG = 0;      /* Disable the SysTick Timer by clear the ENABLE bit */
 
-     /* Set the Reload value with the value of a_TimeInMilliSeconds in seconds */
-     SYSTICK_RELOAD_REG = ((a_TimeInMilliSeconds * 16000) - 1);
+     /* Set the Reload value of one hardware period */
+     g_ReloadValue = Reload;
+     SYSTICK_RELOAD_REG = g_ReloadValue;
+
+     /* Restart the time base */
+     g_Prescaler = Prescaler;
+     g_PrescalerCount = Prescaler;
+     g_CyclesPerTick = (uint64)Prescaler * (Reload + 1);
+     g_MicrosPerTick = a_TimeInMicroSeconds;
+     g_MicrosPerCycleQ32 = ((uint64)a_TimeInMicroSeconds << 32) / g_CyclesPerTick;
+     g_TicksLow = 0;
+     g_TicksEpoch = 0;
 
      /* Clear the Current register value */
      SYSTICK_CURRENT_REG = 0;
@@ -75,6 +448,22 @@ static volatile void (*g_callBackPtr)(void) = NULL_PTR;
       * Choose the clock source to be the system clock (CLK_SRC = 1) */
      SYSTICK_CTRL_REG |= 0x07;
 
+     return E_OK;
+ }
+
+ /*********************************************************************
+ * Service Name: SysTick_GetCoreClock
+ * Sync/Async: Synchronous
+ * Reentrancy: reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Core clock frequency in Hz
+ * Description: Function to get the core clock used by the last SysTick_InitMicros.
+ **********************************************************************/
+ uint32 SysTick_GetCoreClock(void)
+ {
+     return g_CoreClockHz;
  }
 
  /*********************************************************************
@@ -84,16 +473,31 @@ static volatile void (*g_callBackPtr)(void) = NULL_PTR;
  * Parameters (in): a_TimeInMilliSeconds - Required Time delay in milliseconds
  * Parameters (inout): None
  * Parameters (out): None
- * Return value: None
+ * Return value: E_OK after the delay, E_NOT_OK if the delay is out of range
  * Description: Function to initialize SysTick Timer with  the specified time in milliseconds
                 using Polling.
  **********************************************************************/
- void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds)
+ Std_ReturnType SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds)
  {
+     uint32 Reload;
+     uint32 Prescaler;
+     uint32 CoreClockHz = SysTick_ReadCoreClock();
+
+     if(CoreClockHz == 0)
+     {
+         return E_NOT_OK;
+     }
+     g_CoreClockHz = CoreClockHz;
+
+     if(SysTick_ComputePeriod((uint32)a_TimeInMilliSeconds * 1000UL, &Reload, &Prescaler) != E_OK)
+     {
+         return E_NOT_OK;
+     }
+
      SYSTICK_CTRL_REG = 0;      /* Disable the SysTick Timer by clear the ENABLE bit */
 
-     /* Set the Reload value with the value of a_TimeInMilliSeconds in seconds */
-     SYSTICK_RELOAD_REG = ((a_TimeInMilliSeconds * 16000) - 1);
+     /* Set the Reload value of one hardware period */
+     SYSTICK_RELOAD_REG = Reload;
 
      /* Clear the Current register value */
      SYSTICK_CURRENT_REG = 0;
@@ -104,11 +508,17 @@ static volatile void (*g_callBackPtr)(void) = NULL_PTR;
       * Choose the clock source to be the system clock (CLK_SRC = 1) */
      SYSTICK_CTRL_REG |= 0x05;
 
-     /* wait until the COUNT flag = 1 which mean SysTick Timer reaches ZERO value ... COUNT flag is cleared after read the CTRL register value */
-     while(!(SYSTICK_CTRL_REG & (1<<16)));
+     while(Prescaler > 0)
+     {
+         /* wait until the COUNT flag = 1 which mean SysTick Timer reaches ZERO value ... COUNT flag is cleared after read the CTRL register value */
+         while(!(SYSTICK_CTRL_REG & (1<<16)));
+         Prescaler--;
+     }
 
      /* Disable the SysTick Timer by clear the ENABLE bit */
      SysTick_Stop();
+
+     return E_OK;
  }
 
  /*********************************************************************
@@ -122,10 +532,12 @@ static volatile void (*g_callBackPtr)(void) = NULL_PTR;
  * Description: Function to setup the SysTick Timer call back to be executed in
                 SysTick Handler.
  **********************************************************************/
+#if (SYSTICK_HOOK_MODE == SYSTICK_HOOK_RUNTIME)
  void SysTick_SetCallBack(volatile void (*Ptr2Func) (void))
  {
      g_callBackPtr = Ptr2Func;
  }
+#endif
 
  /*********************************************************************
  * Service Name: SysTick_Stop
@@ -181,3 +593,389 @@ static volatile void (*g_callBackPtr)(void) = NULL_PTR;
      SYSTICK_RELOAD_REG = 0;
  }
 
+ /*********************************************************************
+ * Service Name: SysTick_ReadTimeBase
+ * Sync/Async: Synchronous
+ * Reentrancy: reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_CyclesInTick - Core cycles elapsed in the current tick
+ * Return value: Number of ticks since SysTick_Init
+ * Description: Function to take a consistent snapshot of the tick counter and the SysTick
+                counter without disabling interrupts. The snapshot is retried if the handler
+                ran in the middle, and a reload that is still pending (handler not executed
+                yet, e.g. called from a higher priority interrupt) is counted as one more
+                hardware period.
+ **********************************************************************/
+ static uint64 SysTick_ReadTimeBase(uint64 *a_CyclesInTick)
+ {
+     uint32 Epoch;
+     uint32 Low;
+     uint32 Remaining;
+     uint32 Current;
+     uint32 Elapsed;
+     uint64 Ticks;
+
+     do
+     {
+         Epoch = g_TicksEpoch;
+         Low = g_TicksLow;
+         Remaining = g_PrescalerCount;
+         Current = SYSTICK_CURRENT_REG;
+         Elapsed = g_Prescaler - Remaining;
+
+         if(NVIC_SYSTEM_INTCTRL & SYSTICK_PENDSTSET_MASK)
+         {
+             /* The counter reloaded but the handler did not run yet, re-read the counter so it
+              * is surely after the reload and count the pending hardware period */
+             Current = SYSTICK_CURRENT_REG;
+             Elapsed++;
+         }
+     } while((Low != g_TicksLow) || (Remaining != g_PrescalerCount));
+
+     /* The epoch may have been read before the handler updated it, bit 31 of the low word
+      * tells which epoch the low word belongs to */
+     Epoch += ((Low >> 31) ^ (Epoch & 1));
+     Ticks = (((uint64)(Epoch >> 1)) << 32) | Low;
+
+     if(Elapsed == g_Prescaler)
+     {
+         /* The pending hardware period completes a tick */
+         Ticks++;
+         Elapsed = 0;
+     }
+
+     *a_CyclesInTick = ((uint64)Elapsed * (g_ReloadValue + 1)) + (g_ReloadValue - Current);
+
+     return Ticks;
+ }
+
+ /*********************************************************************
+ * Service Name: SysTick_GetTicks
+ * Sync/Async: Synchronous
+ * Reentrancy: reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Low 32 bits of the number of ticks since SysTick_Init
+ * Description: Function to read the tick counter with a single load, for short intervals.
+ **********************************************************************/
+ uint32 SysTick_GetTicks(void)
+ {
+     return g_TicksLow;
+ }
+
+ /*********************************************************************
+ * Service Name: SysTick_GetTicks64
+ * Sync/Async: Synchronous
+ * Reentrancy: reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Number of ticks since SysTick_Init
+ * Description: Function to read the monotonic 64-bit tick counter.
+ **********************************************************************/
+ uint64 SysTick_GetTicks64(void)
+ {
+     uint64 CyclesInTick;
+
+     return SysTick_ReadTimeBase(&CyclesInTick);
+ }
+
+ /*********************************************************************
+ * Service Name: SysTick_GetCycles64
+ * Sync/Async: Synchronous
+ * Reentrancy: reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Number of core clock cycles since SysTick_Init
+ * Description: Function to read the monotonic time base with core clock resolution.
+ **********************************************************************/
+ uint64 SysTick_GetCycles64(void)
+ {
+     uint64 CyclesInTick;
+     uint64 Ticks = SysTick_ReadTimeBase(&CyclesInTick);
+
+     return (Ticks * g_CyclesPerTick) + CyclesInTick;
+ }
+
+ /*********************************************************************
+ * Service Name: SysTick_GetMicros
+ * Sync/Async: Synchronous
+ * Reentrancy: reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Number of microseconds since SysTick_Init
+ * Description: Function to read the monotonic time base in microseconds.
+ **********************************************************************/
+ uint64 SysTick_GetMicros(void)
+ {
+     uint64 CyclesInTick;
+     uint64 Ticks = SysTick_ReadTimeBase(&CyclesInTick);
+
+     /* Scaled reciprocal instead of a division by the rounded cycles per microsecond: at a clock that
+      * is not a whole number of MHz the quotient could pass g_MicrosPerTick and go back at the next
+      * tick. CyclesInTick < g_CyclesPerTick so the product is below g_MicrosPerTick * 2^32 */
+     return (Ticks * g_MicrosPerTick) + ((CyclesInTick * g_MicrosPerCycleQ32) >> 32);
+ }
+
+ /*********************************************************************
+ * Service Name: SysTick_AddTicks
+ * Sync/Async: Synchronous
+ * Reentrancy: non-reentrant
+ * Parameters (in): a_Ticks - Number of ticks that elapsed without a SysTick interrupt
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to account ticks suppressed by the tickless idle in the time base.
+                Called with interrupts disabled.
+ **********************************************************************/
+ static void SysTick_AddTicks(uint32 a_Ticks)
+ {
+     uint32 Ticks = g_TicksLow + a_Ticks;
+
+     g_TicksLow = Ticks;
+     if((Ticks ^ (Ticks - a_Ticks)) & 0x80000000)
+     {
+         /* Bit 31 of the low word toggled (a_Ticks is far below 2^31) */
+         g_TicksEpoch++;
+     }
+ }
+
+ /*********************************************************************
+ * Service Name: SysTick_IdleSleep
+ * Sync/Async: Synchronous
+ * Reentrancy: non-reentrant
+ * Parameters (in): a_IdleTicks - Number of ticks until the next tick that has work, counting
+ *                                that tick (1 means the next tick is needed)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Number of ticks that elapsed without a SysTick interrupt
+ * Description: Function to sleep (WFI) until the next interrupt. When a_IdleTicks > 1 the SysTick
+                period is stretched up to the deadline so the idle ticks are not interrupted, and
+                on wake-up the counter is re-aligned to the original tick phase. Must be called
+                with interrupts disabled (PRIMASK), the caller accounts the returned ticks then
+                enables the interrupts so the interrupt that woke the processor sees the right time.
+ **********************************************************************/
+ uint32 SysTick_IdleSleep(uint32 a_IdleTicks)
+ {
+     uint32 Period = g_ReloadValue + 1;
+     uint32 MaxIdleTicks = (g_Prescaler == 1) ? (SYSTICK_MAX_RELOAD_VALUE / Period) : 1;
+     uint32 Current;
+     uint32 SleepReload;
+     uint32 TicksAhead;
+     uint32 NextTick;
+     uint32 Skipped = 0;
+     uint64 SleepStart = SysTick_GetCycles64();
+
+     if(a_IdleTicks > MaxIdleTicks)
+     {
+         /* Limited by the 24-bit reload register, prescaled ticks are already longer than it */
+         a_IdleTicks = MaxIdleTicks;
+     }
+
+     if(a_IdleTicks > 1)
+     {
+         /* Stop the counter and check that the tick did not fire in the meantime */
+         SYSTICK_CTRL_REG &= ~(1<<0);
+         Current = SYSTICK_CURRENT_REG;
+
+         if((NVIC_SYSTEM_INTCTRL & SYSTICK_PENDSTSET_MASK) || (Current <= SYSTICK_TICKLESS_STOPPED_CYCLES))
+         {
+             /* The tick is due, sleep with the normal period */
+             SYSTICK_CTRL_REG |= (1<<0);
+             a_IdleTicks = 1;
+         }
+         else
+         {
+             /* Expire exactly at the boundary of the last idle tick: Current cycles until the end
+              * of the running tick, then a_IdleTicks - 1 full periods */
+             SleepReload = (Current - SYSTICK_TICKLESS_STOPPED_CYCLES) + ((a_IdleTicks - 1) * Period) - 1;
+
+             SYSTICK_RELOAD_REG = SleepReload;
+             SYSTICK_CURRENT_REG = 0;
+             SYSTICK_CTRL_REG |= (1<<0);
+
+             /* The counter loaded SleepReload when it was enabled, the normal period is used from
+              * the next reload so the tick after the deadline keeps the original phase */
+             SYSTICK_RELOAD_REG = g_ReloadValue;
+             g_IdleStats.TicklessSleeps++;
+         }
+     }
+
+     Wait_For_Interrupt();
+
+     if(a_IdleTicks > 1)
+     {
+         if(NVIC_SYSTEM_INTCTRL & SYSTICK_PENDSTSET_MASK)
+         {
+             /* The deadline was reached, its SysTick interrupt counts the last idle tick */
+             Skipped = a_IdleTicks - 1;
+         }
+         else
+         {
+             /* Woken up early by another interrupt, find how many tick boundaries are still ahead */
+             SYSTICK_CTRL_REG &= ~(1<<0);
+             Current = SYSTICK_CURRENT_REG;
+
+             if(NVIC_SYSTEM_INTCTRL & SYSTICK_PENDSTSET_MASK)
+             {
+                 /* The deadline was reached while stopping the counter */
+                 SYSTICK_CTRL_REG |= (1<<0);
+                 Skipped = a_IdleTicks - 1;
+             }
+             else
+             {
+                 TicksAhead = ((Current - 1) / Period) + 1;
+                 NextTick = (Current - ((TicksAhead - 1) * Period)) - SYSTICK_TICKLESS_STOPPED_CYCLES;
+                 Skipped = a_IdleTicks - TicksAhead;
+
+                 /* Run the rest of the current tick then continue with the normal period */
+                 SYSTICK_RELOAD_REG = (NextTick > 1) ? (NextTick - 1) : 1;
+                 SYSTICK_CURRENT_REG = 0;
+                 SYSTICK_CTRL_REG |= (1<<0);
+                 SYSTICK_RELOAD_REG = g_ReloadValue;
+
+                 g_IdleStats.EarlyWakeUps++;
+             }
+         }
+
+         SysTick_AddTicks(Skipped);
+         g_IdleStats.SuppressedTicks += Skipped;
+     }
+
+     g_IdleStats.WakeUps++;
+     g_IdleStats.IdleCycles += SysTick_GetCycles64() - SleepStart;
+
+     return Skipped;
+ }
+
+ /*********************************************************************
+ * Service Name: SysTick_GetIdleStats
+ * Sync/Async: Synchronous
+ * Reentrancy: non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Stats - Copy of the idle statistics
+ * Return value: None
+ * Description: Function to read the idle statistics collected by SysTick_IdleSleep.
+ **********************************************************************/
+ void SysTick_GetIdleStats(SysTick_IdleStatsType *a_Stats)
+ {
+     NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+     *a_Stats = g_IdleStats;
+
+     NVIC_ExitCritical(IntState);
+ }
+
+#if (SYSTICK_MEASURE_LATENCY == TRUE)
+ /*********************************************************************
+ * Service Name: SysTick_GetLatencyStats
+ * Sync/Async: Synchronous
+ * Reentrancy: non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Stats - Copy of the tick latency measurements
+ * Return value: None
+ * Description: Function to read the tick latency measured by SysTick_Handler.
+ **********************************************************************/
+ void SysTick_GetLatencyStats(SysTick_LatencyStatsType *a_Stats)
+ {
+     NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+     *a_Stats = g_LatencyStats;
+
+     NVIC_ExitCritical(IntState);
+ }
+
+ /*********************************************************************
+ * Service Name: SysTick_ResetLatencyStats
+ * Sync/Async: Synchronous
+ * Reentrancy: non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to restart the tick latency measurement, e.g. before a new test run.
+ **********************************************************************/
+ void SysTick_ResetLatencyStats(void)
+ {
+     NVIC_CriticalStateType IntState = NVIC_EnterCritical(NVIC_SERVICES_CEILING_PRIORITY);
+
+     g_LatencyStats.Samples = 0;
+     g_LatencyStats.LastCycles = 0;
+     g_LatencyStats.MinCycles = 0xFFFFFFFFUL;
+     g_LatencyStats.MaxCycles = 0;
+
+     NVIC_ExitCritical(IntState);
+ }
+#endif
+
+#if (SYSTICK_BENCHMARK_ENABLE == TRUE)
+ /* Tick consumer doing the least possible work */
+ static void SysTick_BenchmarkHook(void)
+ {
+     g_BenchmarkHookCalls++;
+ }
+
+ /* Dispatch of SYSTICK_HOOK_STATIC: direct call */
+ static uint32 SysTick_BenchmarkStaticHook(void)
+ {
+     SysTick_BenchmarkHook();
+     return 0;
+ }
+
+ /* Dispatch of SYSTICK_HOOK_RUNTIME: pointer load, NULL check and indirect call */
+ static uint32 SysTick_BenchmarkRuntimeHook(void)
+ {
+     if(g_BenchmarkHookPtr != NULL_PTR)
+     {
+         (*g_BenchmarkHookPtr)();
+     }
+     return 0;
+ }
+
+ /*********************************************************************
+ * Service Name: SysTick_Benchmark
+ * Sync/Async: Synchronous
+ * Reentrancy: non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Result - Read cost of every time base service
+ * Return value: None
+ * Description: Function to measure the time base services, each call is measured alone with the
+ *              interrupts disabled. SysTick must be running so the reads see real tick boundaries.
+ **********************************************************************/
+ void SysTick_Benchmark(SysTick_BenchmarkType *a_Result)
+ {
+     SysTick_ReadCostType Init = {0xFFFFFFFFUL, 0};
+     uint32 Overhead;
+     uint32 Start;
+     uint32 Read;
+
+     /* Cost of reading the cycle counter twice */
+     Start = DWT_CYCCNT_REG;
+     Overhead = DWT_CYCCNT_REG - Start;
+
+     a_Result->GetTicks = Init;
+     a_Result->GetTicks64 = Init;
+     a_Result->GetCycles64 = Init;
+     a_Result->GetMicros = Init;
+     a_Result->StaticHook = Init;
+     a_Result->RuntimeHook = Init;
+     g_BenchmarkHookPtr = SysTick_BenchmarkHook;
+
+     for(Read = 0; Read < SYSTICK_BENCHMARK_READS; Read++)
+     {
+         SYSTICK_MEASURE_READ(SysTick_GetTicks, Overhead, a_Result->GetTicks);
+         SYSTICK_MEASURE_READ(SysTick_GetTicks64, Overhead, a_Result->GetTicks64);
+         SYSTICK_MEASURE_READ(SysTick_GetCycles64, Overhead, a_Result->GetCycles64);
+         SYSTICK_MEASURE_READ(SysTick_GetMicros, Overhead, a_Result->GetMicros);
+         SYSTICK_MEASURE_READ(SysTick_BenchmarkStaticHook, Overhead, a_Result->StaticHook);
+         SYSTICK_MEASURE_READ(SysTick_BenchmarkRuntimeHook, Overhead, a_Result->RuntimeHook);
+     }
+ }
+#endif
@@ -17,6 +17,75 @@
  *                            Header Files                                     *
  *******************************************************************************/
 #include "std_types.h"
+#include "SysTick_Cfg.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Default core clock feeding the SysTick timer (CLK_SRC = system clock), replaced by the clock
+ * found in the RCC/RCC2 registers when the timer is initialized */
+#define SYSTICK_CORE_CLOCK_HZ               16000000UL
+#define SYSTICK_CYCLES_PER_MICROSECOND      (SYSTICK_CORE_CLOCK_HZ / 1000000UL)
+
+/* Calls of each service measured by SysTick_Benchmark, enough to cross several ticks */
+#define SYSTICK_BENCHMARK_READS             4096
+
+/* Largest value of the 24-bit reload register */
+#define SYSTICK_MAX_RELOAD_VALUE            0x00FFFFFFUL
+
+/* Shortest accepted tick period in core cycles, shorter periods leave no time outside the interrupt */
+#ifndef SYSTICK_MIN_PERIOD_CYCLES
+#define SYSTICK_MIN_PERIOD_CYCLES           200UL
+#endif
+
+/* Core cycles lost while the counter is stopped to be reprogrammed by the tickless idle,
+ * added back to keep the time base from drifting. Tune against an external reference. */
+#ifndef SYSTICK_TICKLESS_STOPPED_CYCLES
+#define SYSTICK_TICKLESS_STOPPED_CYCLES     0UL
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Statistics of the idle loop, used to quantify the tickless idle savings */
+typedef struct
+{
+    uint32 WakeUps;             /* Number of times the processor woke up from SysTick_IdleSleep */
+    uint32 TicklessSleeps;      /* Sleeps in which the SysTick period was stretched */
+    uint32 EarlyWakeUps;        /* Tickless sleeps ended by another interrupt before the deadline */
+    uint32 SuppressedTicks;     /* SysTick interrupts that did not happen thanks to the tickless idle */
+    uint64 IdleCycles;          /* Core cycles spent sleeping */
+}SysTick_IdleStatsType;
+
+/* Tick latency measurements in core cycles, MaxCycles - MinCycles is the tick jitter */
+typedef struct
+{
+    uint32 Samples;             /* Number of measured ticks */
+    uint32 LastCycles;          /* From the counter reload to the tick processing in SysTick_Handler */
+    uint32 MinCycles;
+    uint32 MaxCycles;
+}SysTick_LatencyStatsType;
+
+/* Cost of one call in core cycles, over SYSTICK_BENCHMARK_READS calls */
+typedef struct
+{
+    uint32 MinCycles;
+    uint32 MaxCycles;           /* Includes the calls made while a reload was pending */
+}SysTick_ReadCostType;
+
+/* Read cost of the time base and dispatch cost of the hook modes, the cycle counter must be enabled
+ * by Delay_Init */
+typedef struct
+{
+    SysTick_ReadCostType GetTicks;
+    SysTick_ReadCostType GetTicks64;
+    SysTick_ReadCostType GetCycles64;
+    SysTick_ReadCostType GetMicros;
+    SysTick_ReadCostType StaticHook;    /* Empty consumer called directly (SYSTICK_HOOK_STATIC) */
+    SysTick_ReadCostType RuntimeHook;   /* Same consumer through the checked pointer (SYSTICK_HOOK_RUNTIME) */
+}SysTick_BenchmarkType;
 
 /*******************************************************************************
  *                      Functions Prototypes                                   *
@@ -29,11 +98,38 @@
  * Parameters (in): a_TimeInMilliSeconds - Required Time delay in milliseconds
  * Parameters (inout): None
  * Parameters (out): None
- * Return value: None
+ * Return value: E_OK if the timer is started, E_NOT_OK if the period is out of range
  * Description: Function to initialize SysTick Timer with  the specified time in milliseconds
                 using interrupts.
  **********************************************************************/
- void SysTick_Init(uint16 a_TimeInMilliSeconds);
+ Std_ReturnType SysTick_Init(uint16 a_TimeInMilliSeconds);
+
+ /*********************************************************************
+ * Service Name: SysTick_InitMicros
+ * Sync/Async: Synchronous
+ * Reentrancy: non reentrant
+ * Parameters (in): a_TimeInMicroSeconds - Required tick period in microseconds
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: E_OK if the timer is started, E_NOT_OK if the period is out of range
+ * Description: Function to initialize SysTick Timer with the specified period in microseconds
+                using interrupts. The reload value is derived from the actual core clock, and
+                periods longer than the 24-bit counter are handled by a software prescaler.
+                The timer is left untouched if the period is out of range.
+ **********************************************************************/
+ Std_ReturnType SysTick_InitMicros(uint32 a_TimeInMicroSeconds);
+
+ /*********************************************************************
+ * Service Name: SysTick_GetCoreClock
+ * Sync/Async: Synchronous
+ * Reentrancy: reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Core clock frequency in Hz
+ * Description: Function to get the core clock used by the last SysTick_InitMicros.
+ **********************************************************************/
+ uint32 SysTick_GetCoreClock(void);
 
  /*********************************************************************
  * Service Name: SysTick_StartBusyWait
@@ -42,11 +138,11 @@
  * Parameters (in): a_TimeInMilliSeconds - Required Time delay in milliseconds
  * Parameters (inout): None
  * Parameters (out): None
- * Return value: None
+ * Return value: E_OK after the delay, E_NOT_OK if the delay is out of range
  * Description: Function to initialize SysTick Timer with  the specified time in milliseconds
                 using Polling.
  **********************************************************************/
- void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds);
+ Std_ReturnType SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds);
 
  /*********************************************************************
  * Service Name: SysTick_Handler
@@ -71,7 +167,9 @@
  * Description: Function to setup the SysTick Timer call back to be executed in
                 SysTick Handler.
  **********************************************************************/
+#if (SYSTICK_HOOK_MODE == SYSTICK_HOOK_RUNTIME)
  void SysTick_SetCallBack(volatile void (*Ptr2Func) (void));
+#endif
 
  /*********************************************************************
  * Service Name: SysTick_Stop
@@ -109,5 +207,125 @@
  **********************************************************************/
  void SysTick_DeInit(void);
 
+ /*********************************************************************
+ * Service Name: SysTick_GetTicks
+ * Sync/Async: Synchronous
+ * Reentrancy: reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Low 32 bits of the number of ticks since SysTick_Init
+ * Description: Function to read the tick counter with a single load, for short intervals.
+ **********************************************************************/
+ uint32 SysTick_GetTicks(void);
+
+ /*********************************************************************
+ * Service Name: SysTick_GetTicks64
+ * Sync/Async: Synchronous
+ * Reentrancy: reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Number of ticks since SysTick_Init
+ * Description: Function to read the monotonic 64-bit tick counter.
+ **********************************************************************/
+ uint64 SysTick_GetTicks64(void);
+
+ /*********************************************************************
+ * Service Name: SysTick_GetCycles64
+ * Sync/Async: Synchronous
+ * Reentrancy: reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Number of core clock cycles since SysTick_Init
+ * Description: Function to read the monotonic time base with core clock resolution.
+ **********************************************************************/
+ uint64 SysTick_GetCycles64(void);
+
+ /*********************************************************************
+ * Service Name: SysTick_GetMicros
+ * Sync/Async: Synchronous
+ * Reentrancy: reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Number of microseconds since SysTick_Init
+ * Description: Function to read the monotonic time base in microseconds.
+ **********************************************************************/
+ uint64 SysTick_GetMicros(void);
+
+ /*********************************************************************
+ * Service Name: SysTick_IdleSleep
+ * Sync/Async: Synchronous
+ * Reentrancy: non-reentrant
+ * Parameters (in): a_IdleTicks - Number of ticks until the next tick that has work, counting
+ *                                that tick (1 means the next tick is needed)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Number of ticks that elapsed without a SysTick interrupt
+ * Description: Function to sleep (WFI) until the next interrupt. When a_IdleTicks > 1 the SysTick
+                period is stretched up to the deadline so the idle ticks are not interrupted, and
+                on wake-up the counter is re-aligned to the original tick phase. Must be called
+                with interrupts disabled (PRIMASK), the caller accounts the returned ticks then
+                enables the interrupts so the interrupt that woke the processor sees the right time.
+ **********************************************************************/
+ uint32 SysTick_IdleSleep(uint32 a_IdleTicks);
+
+ /*********************************************************************
+ * Service Name: SysTick_GetIdleStats
+ * Sync/Async: Synchronous
+ * Reentrancy: non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Stats - Copy of the idle statistics
+ * Return value: None
+ * Description: Function to read the idle statistics collected by SysTick_IdleSleep.
+ **********************************************************************/
+ void SysTick_GetIdleStats(SysTick_IdleStatsType *a_Stats);
+
+#if (SYSTICK_BENCHMARK_ENABLE == TRUE)
+ /*********************************************************************
+ * Service Name: SysTick_Benchmark
+ * Sync/Async: Synchronous
+ * Reentrancy: non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Result - Read cost of every time base service and dispatch cost of the hook modes
+ * Return value: None
+ * Description: Function to measure the time base services, each call is measured alone with the
+ *              interrupts disabled. SysTick must be running so the reads see real tick boundaries.
+ *              Both hook modes are measured in one build with the same empty consumer, the
+ *              difference is the cost of the pointer binding on every tick.
+ **********************************************************************/
+ void SysTick_Benchmark(SysTick_BenchmarkType *a_Result);
+#endif
+
+#if (SYSTICK_MEASURE_LATENCY == TRUE)
+ /*********************************************************************
+ * Service Name: SysTick_GetLatencyStats
+ * Sync/Async: Synchronous
+ * Reentrancy: non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Stats - Copy of the tick latency measurements
+ * Return value: None
+ * Description: Function to read the tick latency measured by SysTick_Handler.
+ **********************************************************************/
+ void SysTick_GetLatencyStats(SysTick_LatencyStatsType *a_Stats);
+
+ /*********************************************************************
+ * Service Name: SysTick_ResetLatencyStats
+ * Sync/Async: Synchronous
+ * Reentrancy: non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to restart the tick latency measurement, e.g. before a new test run.
+ **********************************************************************/
+ void SysTick_ResetLatencyStats(void);
+#endif
+
 
 #endif /* SYSTICK_H_ */
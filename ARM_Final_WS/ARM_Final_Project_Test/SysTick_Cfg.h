@@ -0,0 +1,49 @@
+ /******************************************************************************
+ *
+ * Module: SysTick Timer
+ *
+ * File Name: SysTick_Cfg.h
+ *
+ * Description: Pre-compile configuration header file for the SysTick Timer driver
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef SYSTICK_CFG_H_
+#define SYSTICK_CFG_H_
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* SysTick_Handler calls the function registered by SysTick_SetCallBack through a pointer */
+#define SYSTICK_HOOK_RUNTIME                0
+
+/* SysTick_Handler calls the tick consumers listed in SYSTICK_STATIC_HOOKS() directly,
+ * no pointer load, no NULL check and the calls can be inlined by the compiler. The list belongs to
+ * the application and is defined in App_Cfg.h */
+#define SYSTICK_HOOK_STATIC                 1
+
+/* Selected binding of the tick consumers */
+#ifndef SYSTICK_HOOK_MODE
+#define SYSTICK_HOOK_MODE                   SYSTICK_HOOK_STATIC
+#endif
+
+/* SysTick_Handler records the cycles from the counter reload to the tick processing, the spread
+ * of this latency is the jitter added by the critical sections and the higher priority interrupts */
+#ifndef SYSTICK_MEASURE_LATENCY
+#define SYSTICK_MEASURE_LATENCY             FALSE
+#endif
+
+/* SysTick_Benchmark measures the read cost of the time base and the dispatch cost of the two hook
+ * modes when TRUE */
+#ifndef SYSTICK_BENCHMARK_ENABLE
+#define SYSTICK_BENCHMARK_ENABLE            FALSE
+#endif
+
+#if ((SYSTICK_HOOK_MODE != SYSTICK_HOOK_RUNTIME) && (SYSTICK_HOOK_MODE != SYSTICK_HOOK_STATIC))
+#error "SYSTICK_HOOK_MODE must be SYSTICK_HOOK_RUNTIME or SYSTICK_HOOK_STATIC"
+#endif
+
+#endif /* SYSTICK_CFG_H_ */
@@ -1,107 +1,382 @@
 #include "SysTick.h"
+#include "Delay.h"
+#include "Fault.h"
+#include "Fpu.h"
+#include "IsrProfiler.h"
+#include "Deferred.h"
+#include "Swi.h"
+#include "Scheduler.h"
+#include "Kernel.h"
+#include "IrqGuard.h"
+#include "Gpio.h"
+#include "Button.h"
+#include "LedSeq.h"
+#include "SwTimer.h"
 #include "NVIC.h"
 #include "tm4c123gh6pm_registers.h"
 
-#define GPIO_PORTF_IRQ_NUM                30
-#define GPIO_PORTF_INTERRUPT_PRIORITY     2
-#define SYSTICK_INTERRUPT_PRIORITY        1
+#define SYSTICK_TICK_PERIOD_MS            1     /* SysTick drives the software timers every 1 ms */
 
-#define NUMBER_OF_ITERATIONS_PER_ONE_MILI_SECOND 364
+#define LED_RED_MASK                      GPIO_PIN1_MASK
+#define LED_BLUE_MASK                     GPIO_PIN2_MASK
+#define LED_GREEN_MASK                    GPIO_PIN3_MASK
+#define LEDS_PINS_MASK                    (LED_RED_MASK | LED_BLUE_MASK | LED_GREEN_MASK)
 
-/* Global variable to count time in seconds */
-volatile uint8 g_Counter = 0;
+#define LEDS_LAYER_BASE                   0     /* Sequencer layer of the selected pattern */
+#define LEDS_LAYER_ALARM                  1     /* Sequencer layer of the SW2 alarm, hides the base pattern */
+#define LEDS_BASE_PATTERNS                2
 
-void Delay_MS(unsigned long long n)
+#define BUTTONS_THREAD_PRIORITY           0     /* Kernel priority of the buttons thread */
+#define BUTTONS_IRQ_NUM                   30    /* GPIO Port F IRQ, configured in NVIC_Cfg.h */
+#define BUTTONS_STORM_BUDGET              20    /* PF0 and PF4 edges accepted in one window, more is a fault */
+#define BUTTONS_STORM_WINDOW_TICKS        50
+#define BUTTONS_STORM_BACKOFF_TICKS       200   /* Time the Port F interrupt stays disabled after a storm */
+#define BUTTONS_STORM_EVENT_PRIORITY      0     /* Scheduler queue of the storm report */
+#define BUTTONS_THREAD_STACK_WORDS        128
+#define APP_THREAD_STACK_WORDS            256   /* The application thread is the kernel idle thread */
+#define APP_STATS_PERIOD_TICKS            1000  /* Period of the statistics snapshot */
+#define APP_STATS_SWI_LEVEL               (SWI_LEVELS - 1)  /* Lowest level, below every device interrupt */
+#define APP_PROFILER_TRIGGERS             8     /* Software pends of the buttons IRQ, below the storm budget */
+
+/* Statistics of the services copied every APP_STATS_PERIOD_TICKS, read with the debugger */
+typedef struct
+{
+    uint32 Tick;                                /* SwTimer tick of the snapshot */
+    Scheduler_StatsType Scheduler;
+    Deferred_StatsType Deferred;
+    Kernel_StatsType Kernel;
+    Button_StatsType Buttons;
+    IrqGuard_StatsType ButtonsGuard;
+    SysTick_IdleStatsType Idle;
+    Swi_StatsType Swi[SWI_LEVELS];
+}App_StatsType;
+
+/* Fault record of the previous run, E_NOT_OK when it did not end with a fault */
+static Fault_RecordType g_LastFault;
+static Std_ReturnType g_LastFaultStatus;
+
+/* Red, Blue then Green, 1 second each */
+static const LedSeq_StepType g_CycleSteps[] =
+{
+    {LED_RED_MASK,      1000},
+    {LED_BLUE_MASK,     1000},
+    {LED_GREEN_MASK,    1000}
+};
+
+/* Red and Blue flashing */
+static const LedSeq_StepType g_FlashSteps[] =
+{
+    {LED_RED_MASK,      150},
+    {0,                 50},
+    {LED_BLUE_MASK,     150},
+    {0,                 50}
+};
+
+/* All the LEDs on for 5 seconds after SW2 is pressed */
+static const LedSeq_StepType g_AlarmSteps[] =
+{
+    {LEDS_PINS_MASK,    5000}
+};
+
+/* Patterns of the base layer, SW1 double click selects the next one */
+static const LedSeq_PatternType g_BasePatterns[LEDS_BASE_PATTERNS] =
+{
+    {g_CycleSteps, sizeof(g_CycleSteps) / sizeof(g_CycleSteps[0]), LEDSEQ_REPEAT_FOREVER},
+    {g_FlashSteps, sizeof(g_FlashSteps) / sizeof(g_FlashSteps[0]), LEDSEQ_REPEAT_FOREVER}
+};
+
+static const LedSeq_PatternType g_AlarmPattern =
+{
+    g_AlarmSteps, sizeof(g_AlarmSteps) / sizeof(g_AlarmSteps[0]), 1
+};
+
+/* Red blinking fast for 1 second when the buttons interrupt is disabled by a storm */
+static const LedSeq_StepType g_StormSteps[] =
+{
+    {LED_RED_MASK,      50},
+    {0,                 50}
+};
+
+static const LedSeq_PatternType g_StormPattern =
+{
+    g_StormSteps, sizeof(g_StormSteps) / sizeof(g_StormSteps[0]), 10
+};
+
+/* Index of the pattern played by the base layer */
+static uint8 g_BasePattern = 0;
+
+/* Thread woken when button events are queued */
+static Kernel_ThreadType g_ButtonsThread;
+static uint32 g_ButtonsStack[BUTTONS_THREAD_STACK_WORDS];
+
+#if (SYSTICK_BENCHMARK_ENABLE == TRUE)
+/* Read cost of the SysTick time base */
+static SysTick_BenchmarkType g_SysTickBenchmark;
+#endif
+
+#if (GPIO_BENCHMARK_ENABLE == TRUE)
+/* PORTF access costs on the APB and AHB apertures, measured on the Red LED pin */
+static Gpio_BenchmarkType g_GpioBenchmark;
+#endif
+
+#if (NVIC_BENCHMARK_ENABLE == TRUE)
+/* IRQ control costs measured on the buttons IRQ, and PendSV entry with the flash and RAM vector tables */
+static NVIC_BenchmarkType g_NvicBenchmark;
+#endif
+
+#if (SWI_BENCHMARK_ENABLE == TRUE)
+/* Post-to-start latency of the software interrupt levels */
+static Swi_BenchmarkType g_SwiBenchmark;
+#endif
+
+#if (ISR_PROFILER_ENABLE == TRUE)
+/* Measurements of the profiled ISRs after the trigger pass of main */
+static IsrProfiler_StatsType g_IsrProfile[ISR_PROFILER_IDS];
+#endif
+
+/* Disables the Port F interrupt if the edges come faster than the debounce allows */
+static IrqGuard_Type g_ButtonsGuard;
+
+/* Result of the check of the software interrupt level priorities, the levels are not used unless E_OK */
+static Std_ReturnType g_SwiStatus;
+
+/* Statistics snapshot, taken at the lowest software interrupt level when the timer expires */
+static App_StatsType g_AppStats;
+static SwTimer_Type g_StatsTimer;
+static Deferred_WorkType g_StatsWork;
+
+/* Thread running the event loop at the idle priority */
+static Kernel_ThreadType g_AppThread;
+static uint32 g_AppStack[APP_THREAD_STACK_WORDS];
+
+/* Buttons thread: on every SW2 press turn on all the LEDs for 5 seconds over the base pattern, another
+ * press during the 5 seconds starts them again. A SW1 click ends the alarm at once and a SW1 double
+ * click selects the next base pattern */
+void Buttons_Thread(void *a_Arg)
+{
+    Button_EventType Event;
+
+    while(1)
+    {
+        Kernel_WaitSignal();
+
+        while(Button_GetEvent(&Event) == E_OK)
+        {
+            if((Event.Button == BUTTON_SW2) && (Event.Event == BUTTON_EVENT_PRESS))
+            {
+                LedSeq_Play(LEDS_LAYER_ALARM, &g_AlarmPattern);
+            }
+            else if((Event.Button == BUTTON_SW1) && (Event.Event == BUTTON_EVENT_CLICK))
+            {
+                LedSeq_Stop(LEDS_LAYER_ALARM);
+            }
+            else if((Event.Button == BUTTON_SW1) && (Event.Event == BUTTON_EVENT_DOUBLE_CLICK))
+            {
+                g_BasePattern = (g_BasePattern + 1) % LEDS_BASE_PATTERNS;
+                LedSeq_Play(LEDS_LAYER_BASE, &g_BasePatterns[g_BasePattern]);
+            }
+        }
+    }
+}
+
+/* Button call back, runs in the SysTick interrupt after events are queued */
+void Buttons_NotifyCallBack(void)
 {
-    volatile uint64 count = 0;
-    while(count++ < (NUMBER_OF_ITERATIONS_PER_ONE_MILI_SECOND * n) );
+    Kernel_Signal(&g_ButtonsThread);
+}
+
+/* Scheduler event posted by GPIOPortF_Handler when the guard disabled the buttons interrupt, shows the
+ * storm on the alarm layer from the event loop */
+void Buttons_StormEvent(uint32 a_Param)
+{
+    LedSeq_Play(LEDS_LAYER_ALARM, &g_StormPattern);
+}
+
+/* Statistics snapshot work, runs at APP_STATS_SWI_LEVEL so the copies never delay a device interrupt */
+void App_StatsWork(void *a_Arg)
+{
+    uint8 Level;
+
+    g_AppStats.Tick = SwTimer_GetTicks();
+    Scheduler_GetStats(&g_AppStats.Scheduler);
+    Deferred_GetStats(&g_AppStats.Deferred);
+    Kernel_GetStats(&g_AppStats.Kernel);
+    Button_GetStats(&g_AppStats.Buttons);
+    IrqGuard_GetStats(&g_ButtonsGuard, &g_AppStats.ButtonsGuard);
+    SysTick_GetIdleStats(&g_AppStats.Idle);
+    for(Level = 0; Level < SWI_LEVELS; Level++)
+    {
+        (void)Swi_GetStats(Level, &g_AppStats.Swi[Level]);
+    }
+}
+
+/* Statistics timer call back, runs in the SysTick interrupt and only posts the snapshot */
+void App_StatsCallBack(void *a_Arg)
+{
+    (void)Swi_Post(APP_STATS_SWI_LEVEL, &g_StatsWork);
 }
 
 /* GPIO PORTF External Interrupt - ISR */
 void GPIOPortF_Handler(void)
 {
-    SysTick_Stop();
-    GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x0E; /* Turn on the Red, Blue and Green LEDs */
-    Delay_MS(5000);
-    SysTick_Start();
-    GPIO_PORTF_ICR_REG   |= (1<<0);       /* Clear Trigger flag for PF0 (Interrupt Flag) */
-}
+    uint32 EnterCycles = Deferred_IsrEnter();
+    ISR_PROFILER_ENTER(ISR_PROFILER_GPIO_PORTF);
+    FPU_ISR_ENTER();
 
-/* Enable PF0 (SW2) and activate external interrupt with falling edge */
-void SW2_Init(void)
-{
-    GPIO_PORTF_LOCK_REG   = 0x4C4F434B;   /* Unlock the GPIO_PORTF_CR_REG */
-    GPIO_PORTF_CR_REG    |= (1<<0);       /* Enable changes on PF0 */
-    GPIO_PORTF_AMSEL_REG &= ~(1<<0);      /* Disable Analog on PF0 */
-    GPIO_PORTF_PCTL_REG  &= 0xFFFFFFF0;   /* Clear PMCx bits for PF0 to use it as GPIO pin */
-    GPIO_PORTF_DIR_REG   &= ~(1<<0);      /* Configure PF0 as input pin */
-    GPIO_PORTF_AFSEL_REG &= ~(1<<0);      /* Disable alternative function on PF0 */
-    GPIO_PORTF_PUR_REG   |= (1<<0);       /* Enable pull-up on PF0 */
-    GPIO_PORTF_DEN_REG   |= (1<<0);       /* Enable Digital I/O on PF0 */
-    GPIO_PORTF_IS_REG    &= ~(1<<0);      /* PF0 detect edges */
-    GPIO_PORTF_IBE_REG   &= ~(1<<0);      /* PF0 will detect a certain edge */
-    GPIO_PORTF_IEV_REG   &= ~(1<<0);      /* PF0 will detect a falling edge */
-    GPIO_PORTF_ICR_REG   |= (1<<0);       /* Clear Trigger flag for PF0 (Interrupt Flag) */
-    GPIO_PORTF_IM_REG    |= (1<<0);       /* Enable Interrupt on PF0 pin */
-
-    /* Enable NVIC GPIO PORTF IRQ and set its priority */
-    NVIC_EnableIRQ(GPIO_PORTF_IRQ_NUM);
-    NVIC_SetPriorityIRQ(GPIO_PORTF_IRQ_NUM,GPIO_PORTF_INTERRUPT_PRIORITY);
+    /* The button pins are acknowledged in any case, the guard disables the IRQ on a storm and the
+     * report is left to the event loop */
+    if(IrqGuard_Activation(&g_ButtonsGuard) == FALSE)
+    {
+        (void)Scheduler_Post(BUTTONS_STORM_EVENT_PRIORITY, Buttons_StormEvent, 0);
+    }
+    Button_PortIsr(GPIO_PORTF);           /* Mask the edges of SW1 and SW2 and start their debounce */
+
+    FPU_ISR_EXIT();
+    ISR_PROFILER_EXIT(ISR_PROFILER_GPIO_PORTF);
+    Deferred_IsrExit(EnterCycles);
 }
 
 /* Enable PF1, PF2 and PF3 (RED, Blue and Green LEDs) */
 void Leds_Init(void)
 {
-    GPIO_PORTF_AMSEL_REG &= 0xF1;         /* Disable Analog on PF1, PF2 and PF3 */
-    GPIO_PORTF_PCTL_REG  &= 0xFFFF000F;   /* Clear PMCx bits for PF1, PF2 and PF3 to use it as GPIO pin */
-    GPIO_PORTF_DIR_REG   |= 0x0E;         /* Configure PF1, PF2 and PF3 as output pin */
-    GPIO_PORTF_AFSEL_REG &= 0xF1;         /* Disable alternative function on PF1, PF2 and PF3 */
-    GPIO_PORTF_DEN_REG   |= 0x0E;         /* Enable Digital I/O on PF1, PF2 and PF3 */
-    GPIO_PORTF_DATA_REG  &= 0xF1;         /* Clear bit 0, 1 and 2 in Data register to turn off the leds */
+    Gpio_ConfigPins(GPIO_PORTF, LEDS_PINS_MASK, GPIO_OUTPUT, GPIO_PULL_NONE);
+    GPIO_WRITE_PINS(GPIO_PORTF_BASE_ADDRESS, LEDS_PINS_MASK, 0);   /* Turn off the leds */
+}
+
+#if (ISR_PROFILER_ENABLE == TRUE)
+/* Keep the measurements of each profiled ISR, read with the debugger */
+static void App_IsrProfileDump(IsrProfiler_IdType Id, const IsrProfiler_StatsType *a_Stats)
+{
+    g_IsrProfile[Id] = *a_Stats;
 }
+#endif
 
-void SysTick_CallBackFunc(void)
+/* Event loop thread, runs whenever no other thread is ready */
+void App_Thread(void *a_Arg)
 {
-    g_Counter++;
+    /* The boot completed, a fault from now on starts a new count of fault resets */
+    Fault_ClearResets();
 
-    switch(g_Counter)
+    while(1)
     {
-    case 1:
-        GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x02; /* Turn on the Red LED and disable the others */
-        break;
-    case 2:
-        GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x04; /* Turn on the Blue LED and disable the others */
-        break;
-    case 3:
-        GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x08; /* Turn on the Green LED and disable the others */
-        g_Counter = 0;
-        break;
+        /* Run the posted events to completion */
+        Scheduler_Dispatch();
+
+        /* Sleep until the next software timer deadline or any other interrupt if no event was
+         * posted meanwhile. The interrupts are disabled while the suppressed ticks are accounted,
+         * the pending interrupt is served right after Enable_Exceptions() */
+        Disable_Exceptions();
+        if(!Scheduler_IsReady())
+        {
+            SwTimer_SkipTicks(SysTick_IdleSleep(SwTimer_GetIdleTicks()));
+        }
+        Enable_Exceptions();
     }
 }
 
 int main(void)
 {
-    /* Enable clock for PORTF and wait for clock to start */
-    SYSCTL_RCGCGPIO_REG |= 0x20;
-    while(!(SYSCTL_PRGPIO_REG & 0x20));
+#if (ISR_PROFILER_ENABLE == TRUE)
+    uint32 IntState;
+    uint8 Trigger;
+#endif
+
+    /* PRIMASK is 0 out of reset. Keep the interrupts masked until NVIC_Init has set the priorities,
+     * SysTick would otherwise tick at priority 0, above NVIC_SERVICES_CEILING_PRIORITY */
+    Disable_Exceptions();
 
-    /* Initialize the SW2(PF0) as GPIO Pin and activate external interrupt with falling edge */
-    SW2_Init();
+    /* Report the fault that reset the previous run, the record is in g_LastFault */
+    Fault_Init();
+    g_LastFaultStatus = Fault_GetLastRecord(&g_LastFault);
+
+    /* Enable the FPU before any floating-point code and select the FP context stacking of the ISRs */
+    Fpu_Init();
 
     /* Initialize the LEDs as GPIO Pins */
     Leds_Init();
 
-    /* Start SysTick Timer to generate interrupt every 1 second */
-    SysTick_Init(1000);
-    NVIC_SetPriorityException(EXCEPTION_SYSTICK_TYPE,SYSTICK_INTERRUPT_PRIORITY);
-    SysTick_SetCallBack(SysTick_CallBackFunc);
+    /* Play the Red, Blue and Green cycle on the LEDs, the sequencer runs from software timers */
+    SwTimer_Init();
+    LedSeq_Init(GPIO_PORTF, LEDS_PINS_MASK, SYSTICK_TICK_PERIOD_MS);
+    LedSeq_Play(LEDS_LAYER_BASE, &g_BasePatterns[g_BasePattern]);
 
-    /* Enable Interrupts, Exceptions and Faults */
-    Enable_Exceptions();
-    Enable_Faults();
+    /* SW1 (PF4) and SW2 (PF0) with both edge interrupts and debounce, the PORTF clock is enabled by the GPIO driver */
+    Button_Init();
+    Button_SetCallBack(Buttons_NotifyCallBack);
 
-    while(1)
+    /* Limit the Port F interrupt rate so a faulty line cannot starve the other interrupts */
+    IrqGuard_Create(&g_ButtonsGuard, BUTTONS_IRQ_NUM, BUTTONS_STORM_BUDGET, BUTTONS_STORM_WINDOW_TICKS,
+                    BUTTONS_STORM_BACKOFF_TICKS);
+
+    /* Work queue of the deferred interrupt processing, and the ISR execution times recorded by
+     * Deferred_IsrEnter/Exit in GPIOPortF_Handler */
+    Deferred_Init();
+
+    /* The interrupts post events, the main loop runs their handlers */
+    Scheduler_Init();
+
+    /* Start SysTick Timer to generate interrupt every 1 ms to drive the software timers */
+    SysTick_Init(SYSTICK_TICK_PERIOD_MS);
+#if (SYSTICK_HOOK_MODE == SYSTICK_HOOK_RUNTIME)
+    SysTick_SetCallBack(SwTimer_Tick);
+#endif
+
+    /* Start the cycle counter used by the busy-wait delays and calibrate it at the core clock */
+    Delay_Init(SysTick_GetCoreClock());
+#if (ISR_PROFILER_ENABLE == TRUE)
+    IsrProfiler_Init();
+#endif
+#if (SYSTICK_BENCHMARK_ENABLE == TRUE)
+    SysTick_Benchmark(&g_SysTickBenchmark);
+#endif
+#if (GPIO_BENCHMARK_ENABLE == TRUE)
+    Gpio_Benchmark(GPIO_PORTF, 1, SysTick_GetCoreClock(), &g_GpioBenchmark);
+#endif
+#if (NVIC_BENCHMARK_ENABLE == TRUE)
+    /* Before the kernel starts and NVIC_Init relocates the vector table, PendSV has nothing to do */
+    NVIC_Benchmark(BUTTONS_IRQ_NUM, &g_NvicBenchmark);
+#endif
+
+    /* Run the buttons handling and the event loop as kernel threads */
+    Kernel_Init();
+    Kernel_CreateThread(&g_ButtonsThread, BUTTONS_THREAD_PRIORITY, Buttons_Thread, NULL_PTR, g_ButtonsStack,
+                        BUTTONS_THREAD_STACK_WORDS);
+    Kernel_CreateThread(&g_AppThread, KERNEL_IDLE_PRIORITY, App_Thread, NULL_PTR, g_AppStack, APP_THREAD_STACK_WORDS);
+
+    /* Install the handlers, set the priorities and enable the IRQs listed in NVIC_Cfg.h */
+    NVIC_Init();
+
+    /* Software interrupt levels on the spare IRQs of NVIC_Cfg.h, their priorities are set by NVIC_Init.
+     * A level priority out of order leaves the levels unused and the statistics are not taken */
+    g_SwiStatus = Swi_Init();
+    if(g_SwiStatus == E_OK)
     {
+#if (SWI_BENCHMARK_ENABLE == TRUE)
+        Swi_Benchmark(&g_SwiBenchmark);
+#endif
+        Deferred_Create(&g_StatsWork, App_StatsWork, NULL_PTR);
+        SwTimer_Create(&g_StatsTimer, SWTIMER_PERIODIC, APP_STATS_PERIOD_TICKS, App_StatsCallBack, NULL_PTR);
+        SwTimer_Start(&g_StatsTimer);
+    }
 
+#if (ISR_PROFILER_ENABLE == TRUE)
+    /* Pending to entry latency of the buttons ISR, pended from software with the interrupts enabled so
+     * it runs at once. No pin is pending, Button_PortIsr only reads the status and SysTick is profiled
+     * meanwhile */
+    IntState = _enable_IRQ();
+    for(Trigger = 0; Trigger < APP_PROFILER_TRIGGERS; Trigger++)
+    {
+        IsrProfiler_Trigger(ISR_PROFILER_GPIO_PORTF, BUTTONS_IRQ_NUM);
+        Data_Sync_Barrier();
+        Instruction_Sync_Barrier();
     }
+    _restore_interrupts(IntState);
+    IsrProfiler_Dump(App_IsrProfileDump);
+#endif
+
+    /* Enable Faults, Kernel_Start enables the interrupts masked at the top of main */
+    Enable_Faults();
+    Kernel_Start();
+
+    while(1);
 }
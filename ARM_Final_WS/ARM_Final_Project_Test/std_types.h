@@ -30,8 +30,14 @@ typedef unsigned char         uint8;          /*           0 .. 255
 typedef signed char           sint8;          /*        -128 .. +127             */
 typedef unsigned short        uint16;         /*           0 .. 65535            */
 typedef signed short          sint16;         /*      -32768 .. +32767           */
+#if defined(__LP64__)
+/* 64-bit host builds of the host tests, long is 64 bits there */
+typedef unsigned int          uint32;         /*           0 .. 4294967295       */
+typedef signed int            sint32;         /* -2147483648 .. +2147483647      */
+#else
 typedef unsigned long         uint32;         /*           0 .. 4294967295       */
 typedef signed long           sint32;         /* -2147483648 .. +2147483647      */
+#endif
 typedef unsigned long long    uint64;         /*       0 .. 18446744073709551615  */
 typedef signed long long      sint64;         /* -9223372036854775808 .. 9223372036854775807 */
 typedef float                 float32;
@@ -40,4 +46,10 @@ typedef double                float64;
 /* Boolean Data Type */
 typedef uint8 boolean;
 
+/* Standard return type of the services that can fail */
+typedef uint8 Std_ReturnType;
+
+#define E_OK        ((Std_ReturnType)0x00u)
+#define E_NOT_OK    ((Std_ReturnType)0x01u)
+
 #endif /* STD_TYPE_H_ */
@@ -3,6 +3,9 @@
 
 #include "std_types.h"
 
+/* The GPIO registers below are on the APB aperture, the GPIO driver accesses the ports on the
+ * AHB aperture when GPIO_USE_AHB is TRUE (Gpio.h) */
+
 /*****************************************************************************
 GPIO registers (PORTA)
 *****************************************************************************/
@@ -191,6 +194,21 @@ NVIC Registers
 #define NVIC_DIS2_REG             (*((volatile uint32 *)0xE000E188))
 #define NVIC_DIS3_REG             (*((volatile uint32 *)0xE000E18C))
 #define NVIC_DIS4_REG             (*((volatile uint32 *)0xE000E190))
+#define NVIC_PEND0_REG            (*((volatile uint32 *)0xE000E200))
+#define NVIC_PEND1_REG            (*((volatile uint32 *)0xE000E204))
+#define NVIC_PEND2_REG            (*((volatile uint32 *)0xE000E208))
+#define NVIC_PEND3_REG            (*((volatile uint32 *)0xE000E20C))
+#define NVIC_PEND4_REG            (*((volatile uint32 *)0xE000E210))
+#define NVIC_UNPEND0_REG          (*((volatile uint32 *)0xE000E280))
+#define NVIC_UNPEND1_REG          (*((volatile uint32 *)0xE000E284))
+#define NVIC_UNPEND2_REG          (*((volatile uint32 *)0xE000E288))
+#define NVIC_UNPEND3_REG          (*((volatile uint32 *)0xE000E28C))
+#define NVIC_UNPEND4_REG          (*((volatile uint32 *)0xE000E290))
+#define NVIC_ACTIVE0_REG          (*((volatile uint32 *)0xE000E300))
+#define NVIC_ACTIVE1_REG          (*((volatile uint32 *)0xE000E304))
+#define NVIC_ACTIVE2_REG          (*((volatile uint32 *)0xE000E308))
+#define NVIC_ACTIVE3_REG          (*((volatile uint32 *)0xE000E30C))
+#define NVIC_ACTIVE4_REG          (*((volatile uint32 *)0xE000E310))
 
 /*****************************************************************************
 System Control Block Registers
@@ -200,7 +218,28 @@ System Control Block Registers
 #define NVIC_SYSTEM_PRI3_REG      (*((volatile uint32 *)0xE000ED20))
 #define NVIC_SYSTEM_SYSHNDCTRL    (*((volatile uint32 *)0xE000ED24))
 #define NVIC_SYSTEM_INTCTRL       (*((volatile uint32 *)0xE000ED04))
+#define NVIC_SYSTEM_VTABLE        (*((volatile uint32 *)0xE000ED08))
+#define NVIC_SYSTEM_APINT         (*((volatile uint32 *)0xE000ED0C))
 #define NVIC_SYSTEM_CFGCTRL       (*((volatile uint32 *)0xE000ED14))
+#define NVIC_FAULT_STAT_REG       (*((volatile uint32 *)0xE000ED28))
+#define NVIC_HFAULT_STAT_REG      (*((volatile uint32 *)0xE000ED2C))
+#define NVIC_MM_ADDR_REG          (*((volatile uint32 *)0xE000ED34))
+#define NVIC_FAULT_ADDR_REG       (*((volatile uint32 *)0xE000ED38))
+
+/*****************************************************************************
+Data Watchpoint and Trace (DWT) Registers
+*****************************************************************************/
+#define DWT_CTRL_REG              (*((volatile uint32 *)0xE0001000))
+#define DWT_CYCCNT_REG            (*((volatile uint32 *)0xE0001004))
+#define CORE_DEBUG_DEMCR_REG      (*((volatile uint32 *)0xE000EDFC))
+
+/*****************************************************************************
+Floating-Point Unit Registers
+*****************************************************************************/
+#define NVIC_CPAC_REG             (*((volatile uint32 *)0xE000ED88))
+#define NVIC_FPCC_REG             (*((volatile uint32 *)0xE000EF34))
+#define NVIC_FPCA_REG             (*((volatile uint32 *)0xE000EF38))
+#define NVIC_FPDSC_REG            (*((volatile uint32 *)0xE000EF3C))
 
 /*****************************************************************************
 MPU Registers
@@ -30,14 +30,10 @@
 //
 //*****************************************************************************
 void ResetISR(void);
-static void NmiSR(void);
-static void FaultISR(void);
-static void IntDefaultHandler(void);
-static void Bus_FaultISR(void);
-static void Usage_FaultISR(void);
-static void Mem_FaultISR(void);
-extern void GPIOPortF_Handler(void);
+extern void Fault_Handler(void);
+extern void IntDefaultHandler(void);
 extern void SysTick_Handler(void);
+extern void PendSV_Handler(void);
 //*****************************************************************************
 //
 // External declaration for the reset handler that is to be called when the
@@ -73,11 +69,11 @@ void (* const g_pfnVectors[])(void) =
  (void (*)(void))((uint32_t)&__STACK_TOP),
  // The initial stack pointer
  ResetISR,                               // The reset handler
- NmiSR,                                  // The NMI handler
- FaultISR,                               // The hard fault handler
- Mem_FaultISR,                           // The MPU fault handler
- Bus_FaultISR,                           // The bus fault handler
- Usage_FaultISR,                         // The usage fault handler
+ Fault_Handler,                          // The NMI handler
+ Fault_Handler,                          // The hard fault handler
+ Fault_Handler,                          // The MPU fault handler
+ Fault_Handler,                          // The bus fault handler
+ Fault_Handler,                          // The usage fault handler
  0,                                      // Reserved
  0,                                      // Reserved
  0,                                      // Reserved
@@ -85,7 +81,7 @@ void (* const g_pfnVectors[])(void) =
  IntDefaultHandler,                      // SVCall handler
  IntDefaultHandler,                      // Debug monitor handler
  0,                                      // Reserved
- IntDefaultHandler,                      // The PendSV handler
+ PendSV_Handler,                         // The PendSV handler
  SysTick_Handler,                      // The SysTick handler
  IntDefaultHandler,                      // GPIO Port A
  IntDefaultHandler,                      // GPIO Port B
@@ -117,7 +113,7 @@ void (* const g_pfnVectors[])(void) =
  IntDefaultHandler,                      // Analog Comparator 2
  IntDefaultHandler,                      // System Control (PLL, OSC, BO)
  IntDefaultHandler,                      // FLASH Control
- GPIOPortF_Handler,                      // GPIO Port F
+ IntDefaultHandler,                      // GPIO Port F
  IntDefaultHandler,                      // GPIO Port G
  IntDefaultHandler,                      // GPIO Port H
  IntDefaultHandler,                      // UART2 Rx and Tx
@@ -251,83 +247,8 @@ ResetISR(void)
 
 //*****************************************************************************
 //
-// This is the code that gets called when the processor receives a NMI.  This
-// simply enters an infinite loop, preserving the system state for examination
-// by a debugger.
+// The NMI, the faults and the unexpected interrupts are handled by
+// Fault_Handler (Fault_Handler.asm), it saves a fault record for the next
+// boot and resets the system.
 //
 //*****************************************************************************
-static void
-NmiSR(void)
-{
-    //
-    // Enter an infinite loop.
-    //
-    while(1)
-    {
-    }
-}
-static void
-Bus_FaultISR(void)
-{
-    //
-    // Enter an infinite loop.
-    //
-    while(1)
-    {
-    }
-}
-static void
-Usage_FaultISR(void)
-{
-    //
-    // Enter an infinite loop.
-    //
-    while(1)
-    {
-    }
-}
-static void
-Mem_FaultISR(void)
-{
-    //
-    // Enter an infinite loop.
-    //
-    while(1)
-    {
-    }
-}
-//*****************************************************************************
-//
-// This is the code that gets called when the processor receives a fault
-// interrupt.  This simply enters an infinite loop, preserving the system state
-// for examination by a debugger.
-//
-//*****************************************************************************
-static void
-FaultISR(void)
-{
-    //
-    // Enter an infinite loop.
-    //
-    while(1)
-    {
-    }
-}
-
-//*****************************************************************************
-//
-// This is the code that gets called when the processor receives an unexpected
-// interrupt.  This simply enters an infinite loop, preserving the system state
-// for examination by a debugger.
-//
-//*****************************************************************************
-static void
-IntDefaultHandler(void)
-{
-    //
-    // Go into an infinite loop.
-    //
-    while(1)
-    {
-    }
-}
@@ -0,0 +1,286 @@
+ /******************************************************************************
+ *
+ * Module: Host Tests
+ *
+ * File Name: FaultDecode.c
+ *
+ * Description: Host decoder of the fault record of Fault.c (g_LastFault in main.c). It names the
+ *              exception of the vector and the CFSR and HFSR bits that are set, and maps the PC and
+ *              the LR to the function holding them (armnm) and to their source line (armaddr2line)
+ *              with the .out image of the same build. The MMFAR and BFAR are printed when the CFSR
+ *              marks them valid.
+ *
+ *              The tools are armnm and armaddr2line unless FAULT_NM and FAULT_ADDR2LINE name other
+ *              ones taking the same arguments (nm and addr2line of binutils read the image too).
+ *
+ *              Usage: FaultDecode <image.out> <Vector> <PC> <LR> <CFSR> <HFSR> [<MMFAR> <BFAR>]
+ *              or:    make decode IMAGE=<image.out> VECTOR=<Vector> PC=<PC> LR=<LR> CFSR=<CFSR> HFSR=<HFSR>
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define DECODE_DEFAULT_NM                    "armnm"
+#define DECODE_DEFAULT_ADDR2LINE             "armaddr2line"
+
+/* Longest line read from the tools and longest command */
+#define DECODE_LINE_LENGTH                   512
+
+/* CFSR bits giving the validity of the fault address registers */
+#define DECODE_CFSR_MMARVALID_MASK           0x00000080UL
+#define DECODE_CFSR_BFARVALID_MASK           0x00008000UL
+
+/* An LR of 0xFFFFFFxx is an EXC_RETURN value, not a code address */
+#define DECODE_EXC_RETURN_MASK               0xFFFFFF00UL
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* One bit of a fault status register */
+typedef struct
+{
+    uint8 Bit;
+    const char *Name;
+    const char *Meaning;
+}Decode_BitType;
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+/* Configurable Fault Status: MemManage (7:0), Bus (15:8) and Usage (31:16) faults */
+static const Decode_BitType g_CfsrBits[] =
+{
+    {0,  "IACCVIOL",    "MPU violation on an instruction fetch"},
+    {1,  "DACCVIOL",    "MPU violation on a data access, MMFAR holds the address"},
+    {3,  "MUNSTKERR",   "MemManage fault on the unstacking of an exception return"},
+    {4,  "MSTKERR",     "MemManage fault on the stacking of an exception entry"},
+    {5,  "MLSPERR",     "MemManage fault on the lazy floating-point state preservation"},
+    {7,  "MMARVALID",   "MMFAR holds the faulting address"},
+    {8,  "IBUSERR",     "Bus error on an instruction fetch"},
+    {9,  "PRECISERR",   "Precise data bus error, PC is the faulting instruction"},
+    {10, "IMPRECISERR", "Imprecise data bus error, PC is after the faulting store"},
+    {11, "UNSTKERR",    "Bus fault on the unstacking of an exception return"},
+    {12, "STKERR",      "Bus fault on the stacking of an exception entry"},
+    {13, "LSPERR",      "Bus fault on the lazy floating-point state preservation"},
+    {15, "BFARVALID",   "BFAR holds the faulting address"},
+    {16, "UNDEFINSTR",  "Undefined instruction"},
+    {17, "INVSTATE",    "Invalid state, e.g. a branch to an address with bit 0 clear"},
+    {18, "INVPC",       "Invalid EXC_RETURN loaded in the PC"},
+    {19, "NOCP",        "Coprocessor access while it is disabled, e.g. the FPU before Fpu_Init"},
+    {24, "UNALIGNED",   "Unaligned access with the trap enabled"},
+    {25, "DIVBYZERO",   "Division by zero with the trap enabled"}
+};
+
+/* Hard Fault Status */
+static const Decode_BitType g_HfsrBits[] =
+{
+    {1,  "VECTTBL",     "Bus fault on a vector table read"},
+    {30, "FORCED",      "Escalated configurable fault, see the CFSR"},
+    {31, "DEBUGEVT",    "Debug event while the debugger is not attached"}
+};
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static const char *Decode_Tool(const char *Variable, const char *Default)
+{
+    const char *Tool = getenv(Variable);
+
+    return ((Tool != NULL) && (Tool[0] != '\0')) ? Tool : Default;
+}
+
+static uint32 Decode_Number(const char *Text)
+{
+    char *End;
+    unsigned long Value = strtoul(Text, &End, 0);
+
+    if((End == Text) || (*End != '\0'))
+    {
+        printf("Invalid number: %s\n", Text);
+        exit(1);
+    }
+
+    return (uint32)Value;
+}
+
+static void Decode_Vector(uint32 Vector)
+{
+    static const char *const Names[] =
+    {
+        "Thread mode", "Reset", "NMI", "HardFault", "MemManage", "BusFault", "UsageFault"
+    };
+
+    if(Vector < (sizeof(Names) / sizeof(Names[0])))
+    {
+        printf("Vector:  %u (%s)\n", (unsigned int)Vector, Names[Vector]);
+    }
+    else if(Vector >= 16)
+    {
+        printf("Vector:  %u (IRQ %u, unexpected interrupt)\n", (unsigned int)Vector, (unsigned int)(Vector - 16));
+    }
+    else
+    {
+        printf("Vector:  %u (reserved or system exception)\n", (unsigned int)Vector);
+    }
+}
+
+static void Decode_Bits(const char *Register, uint32 Value, const Decode_BitType *Bits, uint32 Count)
+{
+    uint32 Known = 0;
+    uint32 Index;
+
+    printf("%s:    0x%08X\n", Register, (unsigned int)Value);
+    for(Index = 0; Index < Count; Index++)
+    {
+        if(Value & (1UL << Bits[Index].Bit))
+        {
+            printf("  %-12s %s\n", Bits[Index].Name, Bits[Index].Meaning);
+        }
+        Known |= (uint32)(1UL << Bits[Index].Bit);
+    }
+    if(Value & ~Known)
+    {
+        printf("  reserved bits 0x%08X\n", (unsigned int)(Value & ~Known));
+    }
+}
+
+/* Function of the image holding Address: the text symbol at or below it closest to it */
+static void Decode_Symbol(const char *Image, uint32 Address)
+{
+    char Command[DECODE_LINE_LENGTH];
+    char Line[DECODE_LINE_LENGTH];
+    char Name[DECODE_LINE_LENGTH];
+    char Best[DECODE_LINE_LENGTH] = "";
+    unsigned long Value;
+    uint32 BestValue = 0;
+    char Type;
+    FILE *Pipe;
+
+    snprintf(Command, sizeof(Command), "%s \"%s\"", Decode_Tool("FAULT_NM", DECODE_DEFAULT_NM), Image);
+    Pipe = popen(Command, "r");
+    if(Pipe == NULL)
+    {
+        printf("  cannot run: %s\n", Command);
+        return;
+    }
+
+    while(fgets(Line, sizeof(Line), Pipe) != NULL)
+    {
+        if((sscanf(Line, "%lx %c %511s", &Value, &Type, Name) == 3) && ((Type == 'T') || (Type == 't')) &&
+           (Name[0] != '$'))
+        {
+            /* Thumb function symbols may have bit 0 set */
+            Value &= ~1UL;
+            if((Value <= Address) && ((Best[0] == '\0') || (Value > BestValue)))
+            {
+                BestValue = (uint32)Value;
+                strcpy(Best, Name);
+            }
+        }
+    }
+    pclose(Pipe);
+
+    if(Best[0] != '\0')
+    {
+        printf("  in %s + 0x%X\n", Best, (unsigned int)(Address - BestValue));
+    }
+    else
+    {
+        printf("  no function symbol below 0x%08X\n", (unsigned int)Address);
+    }
+}
+
+/* Source line of Address */
+static void Decode_Line(const char *Image, uint32 Address)
+{
+    char Command[DECODE_LINE_LENGTH];
+    char Line[DECODE_LINE_LENGTH];
+    FILE *Pipe;
+
+    snprintf(Command, sizeof(Command), "%s -e \"%s\" 0x%08X", Decode_Tool("FAULT_ADDR2LINE", DECODE_DEFAULT_ADDR2LINE),
+             Image, (unsigned int)Address);
+    Pipe = popen(Command, "r");
+    if(Pipe == NULL)
+    {
+        printf("  cannot run: %s\n", Command);
+        return;
+    }
+
+    while(fgets(Line, sizeof(Line), Pipe) != NULL)
+    {
+        printf("  at %s", Line);
+    }
+    pclose(Pipe);
+}
+
+static void Decode_Address(const char *Image, const char *Register, uint32 Address)
+{
+    printf("%s:      0x%08X\n", Register, (unsigned int)Address);
+
+    if((Address & DECODE_EXC_RETURN_MASK) == DECODE_EXC_RETURN_MASK)
+    {
+        printf("  EXC_RETURN, the faulting code is an exception handler\n");
+        return;
+    }
+
+    /* The stacked LR of a Thumb caller has bit 0 set */
+    Address &= ~1UL;
+    Decode_Symbol(Image, Address);
+    Decode_Line(Image, Address);
+}
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    const char *Image;
+    uint32 CFSR;
+    uint32 HFSR;
+
+    if((argc != 7) && (argc != 9))
+    {
+        printf("Usage: %s <image.out> <Vector> <PC> <LR> <CFSR> <HFSR> [<MMFAR> <BFAR>]\n", argv[0]);
+        return 1;
+    }
+
+    Image = argv[1];
+    CFSR = Decode_Number(argv[5]);
+    HFSR = Decode_Number(argv[6]);
+
+    Decode_Vector(Decode_Number(argv[2]));
+    Decode_Address(Image, "PC", Decode_Number(argv[3]));
+    Decode_Address(Image, "LR", Decode_Number(argv[4]));
+    Decode_Bits("CFSR", CFSR, g_CfsrBits, sizeof(g_CfsrBits) / sizeof(g_CfsrBits[0]));
+    Decode_Bits("HFSR", HFSR, g_HfsrBits, sizeof(g_HfsrBits) / sizeof(g_HfsrBits[0]));
+
+    if(argc == 9)
+    {
+        if(CFSR & DECODE_CFSR_MMARVALID_MASK)
+        {
+            printf("MMFAR:   0x%08X\n", (unsigned int)Decode_Number(argv[7]));
+        }
+        if(CFSR & DECODE_CFSR_BFARVALID_MASK)
+        {
+            printf("BFAR:    0x%08X\n", (unsigned int)Decode_Number(argv[8]));
+        }
+    }
+
+    return 0;
+}
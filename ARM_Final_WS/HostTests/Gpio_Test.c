@@ -0,0 +1,302 @@
+ /******************************************************************************
+ *
+ * Module: Host Tests
+ *
+ * File Name: Gpio_Test.c
+ *
+ * Description: Host test of the DATA aliases and the range checks of Gpio.c. The ports and their
+ *              bit-band alias are host memory filled with random bytes, the host does not mask the
+ *              DATA accesses so the test checks each service stores the expected value to the
+ *              expected alias word and changes no other word.
+ *
+ *              It checks the address of GPIO_DATA_ALIAS for every mask of every port on both
+ *              apertures, the bit-band alias of known bits, the uint8 result of GPIO_READ_PINS, and
+ *              that a service given an invalid port or pin returns E_NOT_OK (or 0) without any access.
+ *
+ *              Gpio.c is included so the test can use the register offsets and port bases.
+ *
+ *              Usage: Gpio_Test [seed]
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "Gpio.c"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Register window of the six ports on the selected aperture and its bit-band alias */
+#define TEST_PORTS_ADDRESS                   GPIO_PORTA_BASE_ADDRESS
+#define TEST_PORTS_SIZE                      0x6000
+#define TEST_ALIAS_ADDRESS                   BITBAND_ALIAS_ADDRESS(TEST_PORTS_ADDRESS, 0)
+#define TEST_ALIAS_SIZE                      (TEST_PORTS_SIZE << 5)
+
+/* Word of the host memory at a target address */
+#define TEST_WORD(ADDRESS)                   (*((volatile uint32 *)(unsigned long)(ADDRESS)))
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+/* Expected content of the register window and of its alias */
+static uint8 g_Ports[TEST_PORTS_SIZE];
+static uint8 g_Alias[TEST_ALIAS_SIZE];
+
+static const uint32 g_ApbBases[GPIO_PORTS_NUM] =
+{
+    GPIO_PORTA_APB_BASE_ADDRESS, GPIO_PORTB_APB_BASE_ADDRESS, GPIO_PORTC_APB_BASE_ADDRESS,
+    GPIO_PORTD_APB_BASE_ADDRESS, GPIO_PORTE_APB_BASE_ADDRESS, GPIO_PORTF_APB_BASE_ADDRESS
+};
+
+static const uint32 g_AhbBases[GPIO_PORTS_NUM] =
+{
+    GPIO_PORTA_AHB_BASE_ADDRESS, GPIO_PORTB_AHB_BASE_ADDRESS, GPIO_PORTC_AHB_BASE_ADDRESS,
+    GPIO_PORTD_AHB_BASE_ADDRESS, GPIO_PORTE_AHB_BASE_ADDRESS, GPIO_PORTF_AHB_BASE_ADDRESS
+};
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Fill the registers and the alias with random bytes */
+static void Test_Fill(void)
+{
+    uint32 Index;
+
+    for(Index = 0; Index < TEST_PORTS_SIZE; Index++)
+    {
+        g_Ports[Index] = (uint8)Host_Random();
+    }
+    for(Index = 0; Index < TEST_ALIAS_SIZE; Index++)
+    {
+        g_Alias[Index] = (uint8)Host_Random();
+    }
+    memcpy((void *)(unsigned long)TEST_PORTS_ADDRESS, g_Ports, TEST_PORTS_SIZE);
+    memcpy((void *)(unsigned long)TEST_ALIAS_ADDRESS, g_Alias, TEST_ALIAS_SIZE);
+}
+
+/* Expect Value in the word at Address, in the registers or in the alias */
+static void Test_Expect(uint32 Address, uint32 Value)
+{
+    if(Address >= TEST_ALIAS_ADDRESS)
+    {
+        memcpy(&g_Alias[Address - TEST_ALIAS_ADDRESS], &Value, sizeof(Value));
+    }
+    else
+    {
+        memcpy(&g_Ports[Address - TEST_PORTS_ADDRESS], &Value, sizeof(Value));
+    }
+}
+
+/* Every word holds its expected value */
+static void Test_Check(void)
+{
+    TEST_ASSERT(memcmp((void *)(unsigned long)TEST_PORTS_ADDRESS, g_Ports, TEST_PORTS_SIZE) == 0);
+    TEST_ASSERT(memcmp((void *)(unsigned long)TEST_ALIAS_ADDRESS, g_Alias, TEST_ALIAS_SIZE) == 0);
+}
+
+/* Bits 9:2 of the alias address are the mask, DATA is the only register below the DIR offset */
+static void Test_AliasAddresses(void)
+{
+    uint32 Port;
+    uint32 Mask;
+
+    for(Port = 0; Port < GPIO_PORTS_NUM; Port++)
+    {
+        TEST_ASSERT(g_PortBase[Port] == ((GPIO_USE_AHB == TRUE) ? g_AhbBases[Port] : g_ApbBases[Port]));
+
+        for(Mask = 0; Mask <= GPIO_ALL_PINS_MASK; Mask++)
+        {
+            TEST_ASSERT((unsigned long)&GPIO_DATA_ALIAS(g_ApbBases[Port], Mask) == (g_ApbBases[Port] + (Mask * 4)));
+            TEST_ASSERT((unsigned long)&GPIO_DATA_ALIAS(g_AhbBases[Port], Mask) == (g_AhbBases[Port] + (Mask * 4)));
+            TEST_ASSERT((unsigned long)&GPIO_DATA_ALIAS(g_AhbBases[Port], (uint8)Mask) < (g_AhbBases[Port] + GPIO_DIR_OFFSET));
+        }
+    }
+}
+
+/* Alias words of known bits, from the examples of the Cortex-M4 manual and the TM4C123GH6PM registers,
+ * and the limits of the two regions */
+static void Test_BitBandAddresses(void)
+{
+    TEST_ASSERT(BITBAND_ALIAS_ADDRESS(BITBAND_SRAM_BASE, 0) == BITBAND_SRAM_ALIAS_BASE);
+    TEST_ASSERT(BITBAND_ALIAS_ADDRESS(BITBAND_PERIPH_BASE, 0) == BITBAND_PERIPH_ALIAS_BASE);
+    TEST_ASSERT(BITBAND_ALIAS_ADDRESS(0x20000300UL, 2) == 0x22006008UL);
+    TEST_ASSERT(BITBAND_ALIAS_ADDRESS(0x200FFFFCUL, 31) == 0x23FFFFFCUL);
+    TEST_ASSERT(BITBAND_ALIAS_ADDRESS(0x400FE608UL, 5) == 0x43FCC114UL);     /* RCGCGPIO port F */
+    TEST_ASSERT(BITBAND_ALIAS_ADDRESS(GPIO_PORTF_APB_BASE_ADDRESS + GPIO_IM_OFFSET, 4) == 0x424A8210UL);
+    TEST_ASSERT(BITBAND_ALIAS_ADDRESS(GPIO_PORTF_AHB_BASE_ADDRESS + GPIO_IM_OFFSET, 4) == 0x42BA8210UL);
+    TEST_ASSERT((unsigned long)&BITBAND_PERIPH(TEST_WORD(GPIO_PORTF_AHB_BASE_ADDRESS + GPIO_IM_OFFSET), 4) == 0x42BA8210UL);
+
+    TEST_ASSERT(BITBAND_IS_BANDED(0x20000000UL));
+    TEST_ASSERT(BITBAND_IS_BANDED(0x200FFFFCUL));
+    TEST_ASSERT(BITBAND_IS_BANDED(0x400FFFFCUL));
+    TEST_ASSERT(!BITBAND_IS_BANDED(0x1FFFFFFCUL));
+    TEST_ASSERT(!BITBAND_IS_BANDED(0x20100000UL));                          /* SRAM above the first 1 MB */
+    TEST_ASSERT(!BITBAND_IS_BANDED(0x40100000UL));
+    TEST_ASSERT(!BITBAND_IS_BANDED(0xE000ED04UL));                          /* ICSR, System Control Space */
+}
+
+/* Each write stores its value to the alias of its pins only, each read returns the low byte */
+static void Test_DataAccesses(void)
+{
+    Gpio_PortType Port;
+    uint32 Base;
+    uint32 Write;
+    uint32 Word;
+    uint8 Mask;
+    uint8 Value;
+    uint8 Pin;
+
+    Test_Fill();
+
+    for(Port = GPIO_PORTA; Port < GPIO_PORTS_NUM; Port++)
+    {
+        Base = g_PortBase[Port];
+
+        for(Pin = 0; Pin < 8; Pin++)
+        {
+            TEST_ASSERT(Gpio_WritePin(Port, Pin, LOGIC_HIGH) == E_OK);
+            Test_Expect(Base + ((1UL << Pin) * 4), GPIO_ALL_PINS_MASK);
+            Test_Check();
+            TEST_ASSERT(Gpio_ReadPin(Port, Pin) == LOGIC_HIGH);
+
+            TEST_ASSERT(Gpio_WritePin(Port, Pin, LOGIC_LOW) == E_OK);
+            Test_Expect(Base + ((1UL << Pin) * 4), 0);
+            Test_Check();
+            TEST_ASSERT(Gpio_ReadPin(Port, Pin) == LOGIC_LOW);
+
+            TEST_ASSERT(Gpio_TogglePin(Port, Pin) == E_OK);
+            Test_Expect(Base + ((1UL << Pin) * 4), 0xFFFFFFFFUL);
+            Test_Check();
+        }
+
+        for(Write = 0; Write < 64; Write++)
+        {
+            Mask = (uint8)Host_Random();
+            Value = (uint8)Host_Random();
+
+            TEST_ASSERT(Gpio_WritePins(Port, Mask, Value) == E_OK);
+            Test_Expect(Base + ((uint32)Mask * 4), Value);
+            Test_Check();
+
+            /* Only the low byte of the alias is returned */
+            TEST_WORD(Base + ((uint32)Mask * 4)) = Host_Random();
+            Test_Expect(Base + ((uint32)Mask * 4), TEST_WORD(Base + ((uint32)Mask * 4)));
+            TEST_ASSERT(Gpio_ReadPins(Port, Mask) == (uint8)TEST_WORD(Base + ((uint32)Mask * 4)));
+
+            Word = TEST_WORD(Base + ((uint32)Mask * 4));
+            TEST_ASSERT(Gpio_TogglePins(Port, Mask) == E_OK);
+            Test_Expect(Base + ((uint32)Mask * 4), ~Word);
+            Test_Check();
+        }
+
+        TEST_ASSERT(Gpio_WritePort(Port, 0xA5) == E_OK);
+        Test_Expect(Base + (GPIO_ALL_PINS_MASK * 4), 0xA5);
+        Test_Check();
+        TEST_ASSERT(Gpio_ReadPort(Port) == 0xA5);
+    }
+}
+
+/* Each pin interrupt service stores to its own register or alias word */
+static void Test_Interrupts(void)
+{
+    Gpio_PortType Port;
+    uint32 Base;
+    uint8 Mask;
+    uint8 Pin;
+
+    Test_Fill();
+
+    for(Port = GPIO_PORTA; Port < GPIO_PORTS_NUM; Port++)
+    {
+        Base = g_PortBase[Port];
+
+        for(Pin = 0; Pin < 8; Pin++)
+        {
+            TEST_ASSERT(Gpio_EnableInterruptPin(Port, Pin) == E_OK);
+            Test_Expect(BITBAND_ALIAS_ADDRESS(Base + GPIO_IM_OFFSET, Pin), 1);
+            Test_Check();
+
+            TEST_ASSERT(Gpio_DisableInterruptPin(Port, Pin) == E_OK);
+            Test_Expect(BITBAND_ALIAS_ADDRESS(Base + GPIO_IM_OFFSET, Pin), 0);
+            Test_Check();
+        }
+
+        Mask = (uint8)Host_Random();
+        TEST_ASSERT(Gpio_ClearInterrupt(Port, Mask) == E_OK);
+        Test_Expect(Base + GPIO_ICR_OFFSET, Mask);
+        Test_Check();
+
+        TEST_ASSERT(Gpio_GetInterruptStatus(Port) == (uint8)TEST_WORD(Base + GPIO_MIS_OFFSET));
+    }
+}
+
+/* An invalid port or pin is rejected before any access: a pin above 7 would reach the registers
+ * past DATA and the alias of another register, a port past F would read past g_PortBase */
+static void Test_InvalidArguments(void)
+{
+    Gpio_PortType Port;
+    uint8 Pin;
+
+    Test_Fill();
+
+    for(Port = GPIO_PORTA; Port < GPIO_PORTS_NUM; Port++)
+    {
+        for(Pin = 8; Pin != 0; Pin++)
+        {
+            TEST_ASSERT(Gpio_EnableInterruptPin(Port, Pin) == E_NOT_OK);
+            TEST_ASSERT(Gpio_DisableInterruptPin(Port, Pin) == E_NOT_OK);
+            TEST_ASSERT(Gpio_WritePin(Port, Pin, LOGIC_HIGH) == E_NOT_OK);
+            TEST_ASSERT(Gpio_TogglePin(Port, Pin) == E_NOT_OK);
+            TEST_ASSERT(Gpio_ReadPin(Port, Pin) == LOGIC_LOW);
+        }
+    }
+
+    for(Port = GPIO_PORTS_NUM; Port < (GPIO_PORTS_NUM + 4); Port++)
+    {
+        TEST_ASSERT(Gpio_ConfigPins(Port, GPIO_ALL_PINS_MASK, GPIO_OUTPUT, GPIO_PULL_UP) == E_NOT_OK);
+        TEST_ASSERT(Gpio_ConfigInterrupt(Port, GPIO_ALL_PINS_MASK, GPIO_EDGE_BOTH) == E_NOT_OK);
+        TEST_ASSERT(Gpio_EnableInterruptPin(Port, 0) == E_NOT_OK);
+        TEST_ASSERT(Gpio_DisableInterruptPin(Port, 0) == E_NOT_OK);
+        TEST_ASSERT(Gpio_GetInterruptStatus(Port) == 0);
+        TEST_ASSERT(Gpio_ClearInterrupt(Port, GPIO_ALL_PINS_MASK) == E_NOT_OK);
+        TEST_ASSERT(Gpio_ReadPort(Port) == 0);
+        TEST_ASSERT(Gpio_WritePort(Port, 0xFF) == E_NOT_OK);
+        TEST_ASSERT(Gpio_ReadPins(Port, GPIO_ALL_PINS_MASK) == 0);
+        TEST_ASSERT(Gpio_WritePins(Port, GPIO_ALL_PINS_MASK, 0xFF) == E_NOT_OK);
+        TEST_ASSERT(Gpio_TogglePins(Port, GPIO_ALL_PINS_MASK) == E_NOT_OK);
+        TEST_ASSERT(Gpio_ReadPin(Port, 0) == LOGIC_LOW);
+        TEST_ASSERT(Gpio_WritePin(Port, 0, LOGIC_HIGH) == E_NOT_OK);
+        TEST_ASSERT(Gpio_TogglePin(Port, 0) == E_NOT_OK);
+    }
+
+    Test_Check();
+}
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    Host_Seed(argc, argv);
+
+    Host_MapRegisters(TEST_PORTS_ADDRESS, TEST_PORTS_SIZE);     /* GPIO ports A to F */
+    Host_MapRegisters(TEST_ALIAS_ADDRESS, TEST_ALIAS_SIZE);     /* Their bit-band alias */
+
+    Test_AliasAddresses();
+    Test_BitBandAddresses();
+    Test_DataAccesses();
+    Test_Interrupts();
+    Test_InvalidArguments();
+
+    printf("Gpio_Test passed\n");
+    return 0;
+}
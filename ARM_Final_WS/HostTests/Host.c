@@ -0,0 +1,128 @@
+ /******************************************************************************
+ *
+ * Module: Host Tests
+ *
+ * File Name: Host.c
+ *
+ * Description: Source file of the host stand-ins of the TI ARM compiler intrinsics and of the
+ *              helpers shared by the host tests
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/mman.h>
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* BASEPRI implements the 3 upper bits of the priority byte */
+#define HOST_BASEPRI_MASK                    0xE0
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+volatile unsigned int g_HostPrimask = 0;
+volatile unsigned int g_HostBasePri = 0;
+
+static unsigned int g_RandomState = 1;
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+unsigned int _disable_IRQ(void)
+{
+    unsigned int Previous = g_HostPrimask;
+    g_HostPrimask = 1;
+    return Previous;
+}
+
+unsigned int _enable_IRQ(void)
+{
+    unsigned int Previous = g_HostPrimask;
+    g_HostPrimask = 0;
+    return Previous;
+}
+
+void _restore_interrupts(unsigned int State)
+{
+    g_HostPrimask = State;
+}
+
+unsigned int _set_interrupt_priority(unsigned int Priority)
+{
+    unsigned int Previous = g_HostBasePri;
+    g_HostBasePri = Priority & HOST_BASEPRI_MASK;
+    return Previous;
+}
+
+/* The write of BASEPRI_MAX is ignored for 0 and when it would lower the masking */
+unsigned int NVIC_RaiseBasePri(unsigned int BasePri)
+{
+    unsigned int Previous = g_HostBasePri;
+    unsigned int Masked = BasePri & HOST_BASEPRI_MASK;
+
+    if((Masked != 0) && ((Previous == 0) || (Masked < Previous)))
+    {
+        g_HostBasePri = Masked;
+    }
+
+    return Previous;
+}
+
+/* Count of leading zeros, 32 for 0 like the CLZ instruction */
+int _norm(int Value)
+{
+    return (Value == 0) ? 32 : __builtin_clz((unsigned int)Value);
+}
+
+void Host_Fail(const char *File, int Line, const char *Condition)
+{
+    printf("FAILED %s:%d: %s\n", File, Line, Condition);
+    exit(1);
+}
+
+void Host_MapRegisters(unsigned long Address, unsigned long Size)
+{
+    void *Block = mmap((void *)Address, Size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if(Block != (void *)Address)
+    {
+        printf("Cannot map the registers at 0x%08lX\n", Address);
+        exit(1);
+    }
+}
+
+unsigned int Host_Seed(int argc, char *argv[])
+{
+    unsigned int Seed = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 0) : (unsigned int)time(NULL);
+
+    /* xorshift32 never leaves 0 */
+    g_RandomState = (Seed != 0) ? Seed : 1;
+    printf("seed %u\n", Seed);
+
+    return Seed;
+}
+
+unsigned int Host_Random(void)
+{
+    g_RandomState ^= g_RandomState << 13;
+    g_RandomState ^= g_RandomState >> 17;
+    g_RandomState ^= g_RandomState << 5;
+    return g_RandomState;
+}
+
+unsigned int Host_RandomBelow(unsigned int Bound)
+{
+    return (unsigned int)(((unsigned long long)Host_Random() * Bound) >> 32);
+}
@@ -0,0 +1,78 @@
+ /******************************************************************************
+ *
+ * Module: Host Tests
+ *
+ * File Name: Host.h
+ *
+ * Description: header file forced into every file of the host test builds (gcc -include Host.h).
+ *              It replaces the TI ARM compiler intrinsics and the inline instructions of the
+ *              target modules by host stand-ins so the target independent modules build and run
+ *              unchanged on a 64-bit Linux host.
+ *
+ *              The intrinsics and NVIC_RaiseBasePri (NVIC_BasePri.asm on the target) emulate PRIMASK
+ *              and BASEPRI in g_HostPrimask and g_HostBasePri, so a test can check the critical
+ *              sections are balanced. The inline instructions (CPSID, DSB, WFI, ...) are replaced by
+ *              memory barriers.
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+#ifndef HOST_H_
+#define HOST_H_
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* The inline instructions have no host equivalent, they become full memory barriers so a DMB keeps
+ * ordering the two sides of a lock-free queue running in two host threads */
+#define __asm(INSTRUCTION)              __sync_synchronize()
+
+/* Stop the test with the failed condition and its location */
+#define TEST_ASSERT(COND)                                                               \
+    do                                                                                  \
+    {                                                                                   \
+        if(!(COND))                                                                     \
+        {                                                                               \
+            Host_Fail(__FILE__, __LINE__, #COND);                                       \
+        }                                                                               \
+    }while(0)
+
+/*******************************************************************************
+ *                       External Variables                                    *
+ *******************************************************************************/
+
+/* Emulated PRIMASK (1 masks all the interrupts) and BASEPRI (the 3 implemented upper bits) */
+extern volatile unsigned int g_HostPrimask;
+extern volatile unsigned int g_HostBasePri;
+
+/*******************************************************************************
+ *                                Functions Prototypes                          *
+ *******************************************************************************/
+
+/* TI ARM compiler intrinsics */
+unsigned int _disable_IRQ(void);
+unsigned int _enable_IRQ(void);
+void _restore_interrupts(unsigned int State);
+unsigned int _set_interrupt_priority(unsigned int Priority);
+int _norm(int Value);
+
+/* BASEPRI_MAX helper of NVIC_BasePri.asm */
+unsigned int NVIC_RaiseBasePri(unsigned int BasePri);
+
+/* Report a failed TEST_ASSERT and exit with an error */
+void Host_Fail(const char *File, int Line, const char *Condition);
+
+/* Map zeroed host memory at the address of a block of target registers, the registers then behave
+ * like plain RAM. Address and Size must be multiples of 4 KB */
+void Host_MapRegisters(unsigned long Address, unsigned long Size);
+
+/* Seed of the test pseudo-random generator, from the first command line argument or the time */
+unsigned int Host_Seed(int argc, char *argv[]);
+
+/* Pseudo-random number (xorshift32) and pseudo-random number in 0 .. Bound - 1 */
+unsigned int Host_Random(void);
+unsigned int Host_RandomBelow(unsigned int Bound);
+
+#endif /* HOST_H_ */
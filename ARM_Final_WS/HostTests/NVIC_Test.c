@@ -0,0 +1,170 @@
+ /******************************************************************************
+ *
+ * Module: Host Tests
+ *
+ * File Name: NVIC_Test.c
+ *
+ * Description: Host test of the priority services of NVIC.c. The System Control Space is host
+ *              memory filled with random bytes, every priority write of every IRQ and system
+ *              exception must change its own byte only. The uint8 field mask of the former
+ *              read-modify-write cleared the priorities sharing the word with the IRQ.
+ *
+ *              Usage: NVIC_Test [seed]
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include <stdio.h>
+#include "NVIC.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* System exception vectors 4 - 15 have a priority byte in NVIC_SYSTEM_PRI1_REG - NVIC_SYSTEM_PRI3_REG */
+#define TEST_SYSTEM_PRI_BYTES                12
+
+/* Priority values, the 3 upper bits of the byte */
+#define TEST_PRIORITIES                      (1 << NVIC_PRIORITY_BITS)
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Configurable exception and its vector number */
+typedef struct
+{
+    NVIC_ExceptionType Exception_Num;
+    uint8 Vector;
+}Test_ExceptionType;
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+/* Expected content of the priority registers */
+static uint8 g_IrqBytes[NVIC_PRI_REGS * 4];
+static uint8 g_SystemBytes[TEST_SYSTEM_PRI_BYTES];
+
+static const Test_ExceptionType g_Exceptions[] =
+{
+    {EXCEPTION_MEM_FAULT_TYPE,     4},
+    {EXCEPTION_BUS_FAULT_TYPE,     5},
+    {EXCEPTION_USAGE_FAULT_TYPE,   6},
+    {EXCEPTION_SVC_TYPE,           11},
+    {EXCEPTION_DEBUG_MONITOR_TYPE, 12},
+    {EXCEPTION_PEND_SV_TYPE,       14},
+    {EXCEPTION_SYSTICK_TYPE,       15}
+};
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Fill the priority registers with random bytes, the low bits too so a write of a whole word or of
+ * a shifted mask shows */
+static void Test_Fill(void)
+{
+    uint32 Index;
+
+    for(Index = 0; Index < sizeof(g_IrqBytes); Index++)
+    {
+        g_IrqBytes[Index] = (uint8)Host_Random();
+        NVIC_IRQ_PRI_BYTE(Index) = g_IrqBytes[Index];
+    }
+    for(Index = 0; Index < TEST_SYSTEM_PRI_BYTES; Index++)
+    {
+        g_SystemBytes[Index] = (uint8)Host_Random();
+        NVIC_SYSTEM_PRI_BYTE(Index + 4) = g_SystemBytes[Index];
+    }
+}
+
+/* Every priority byte holds its expected value */
+static void Test_Check(void)
+{
+    uint32 Index;
+
+    for(Index = 0; Index < sizeof(g_IrqBytes); Index++)
+    {
+        TEST_ASSERT(NVIC_IRQ_PRI_BYTE(Index) == g_IrqBytes[Index]);
+    }
+    for(Index = 0; Index < TEST_SYSTEM_PRI_BYTES; Index++)
+    {
+        TEST_ASSERT(NVIC_SYSTEM_PRI_BYTE(Index + 4) == g_SystemBytes[Index]);
+    }
+}
+
+/* Each IRQ in each byte lane of its NVIC_PRIn_REG, with every priority */
+static void Test_IrqPriorities(void)
+{
+    NVIC_IRQType IRQ_Num;
+    NVIC_IRQPriorityType Priority;
+
+    Test_Fill();
+
+    for(IRQ_Num = 0; IRQ_Num < NVIC_IRQ_COUNT; IRQ_Num++)
+    {
+        for(Priority = 0; Priority < TEST_PRIORITIES; Priority++)
+        {
+            NVIC_SetPriorityIRQ(IRQ_Num, Priority);
+            g_IrqBytes[IRQ_Num] = (uint8)(Priority << NVIC_PRIORITY_BITS_SHIFT);
+
+            Test_Check();
+            TEST_ASSERT(NVIC_GetPriorityIRQ(IRQ_Num) == Priority);
+        }
+    }
+
+    /* Random order, so a write also lands next to priorities set by the test */
+    for(Priority = 0; Priority < 200; Priority++)
+    {
+        IRQ_Num = (NVIC_IRQType)Host_RandomBelow(NVIC_IRQ_COUNT);
+        NVIC_SetPriorityIRQ(IRQ_Num, (NVIC_IRQPriorityType)(Priority % TEST_PRIORITIES));
+        g_IrqBytes[IRQ_Num] = (uint8)((Priority % TEST_PRIORITIES) << NVIC_PRIORITY_BITS_SHIFT);
+        Test_Check();
+    }
+}
+
+/* Each configurable exception with every priority, the fixed ones change nothing */
+static void Test_ExceptionPriorities(void)
+{
+    NVIC_ExceptionPriorityType Priority;
+    uint8 Entry;
+
+    Test_Fill();
+
+    for(Entry = 0; Entry < (sizeof(g_Exceptions) / sizeof(g_Exceptions[0])); Entry++)
+    {
+        for(Priority = 0; Priority < TEST_PRIORITIES; Priority++)
+        {
+            NVIC_SetPriorityException(g_Exceptions[Entry].Exception_Num, Priority);
+            g_SystemBytes[g_Exceptions[Entry].Vector - 4] = (uint8)(Priority << NVIC_PRIORITY_BITS_SHIFT);
+            Test_Check();
+        }
+    }
+
+    NVIC_SetPriorityException(EXCEPTION_RESET_TYPE, 3);
+    NVIC_SetPriorityException(EXCEPTION_NMI_TYPE, 3);
+    NVIC_SetPriorityException(EXCEPTION_HARD_FAULT_TYPE, 3);
+    Test_Check();
+}
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    Host_Seed(argc, argv);
+
+    Host_MapRegisters(0xE000E000, 0x1000);     /* NVIC and System Control Block */
+
+    Test_IrqPriorities();
+    Test_ExceptionPriorities();
+
+    printf("NVIC_Test passed\n");
+    return 0;
+}
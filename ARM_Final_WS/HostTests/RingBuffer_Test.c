@@ -0,0 +1,351 @@
+ /******************************************************************************
+ *
+ * Module: Host Tests
+ *
+ * File Name: RingBuffer_Test.c
+ *
+ * Description: Stress test of the lock-free single-producer/single-consumer ring buffer of
+ *              RingBuffer.c with a producer and a consumer running in two host threads.
+ *
+ *              The producer pushes a sequence of numbered elements and the consumer checks it
+ *              gets every element once, in order and intact. Each phase uses one pair of
+ *              services: Push/Pop, PushByte/PopByte, PushWord/PopWord, PushBulk/PopBulk with
+ *              random counts and GetWriteSpan/CommitWrite with GetReadSpan/CommitRead. Head and
+ *              Tail start at 0xFFFFFFF0, so every phase crosses the wrap of the free running
+ *              counters as well as the end of the storage.
+ *
+ *              Usage: RingBuffer_Test [seed]
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+#include "RingBuffer.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Elements transferred in every phase */
+#define TEST_ELEMENTS                        2000000UL
+
+/* Capacity of the ring buffer, small so both sides often find it full or empty */
+#define TEST_CAPACITY                        64
+
+/* Largest count of one bulk or span transfer, above the capacity to hit the partial transfers */
+#define TEST_MAX_BULK                        80
+
+/* Start value of Head and Tail */
+#define TEST_START_COUNTER                   0xFFFFFFF0UL
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef enum
+{
+    TEST_PHASE_ELEMENT,
+    TEST_PHASE_BYTE,
+    TEST_PHASE_WORD,
+    TEST_PHASE_BULK,
+    TEST_PHASE_SPAN,
+    TEST_PHASES
+}Test_PhaseType;
+
+/* Element of the generic services, the check word catches a torn copy */
+typedef struct
+{
+    uint32 Sequence;
+    uint32 Check;
+}Test_ElementType;
+
+/* One side of the transfer */
+typedef struct
+{
+    Test_PhaseType Phase;
+    uint32 RandomState;             /* Own xorshift32 state, Host_Random is not thread safe */
+    uint32 MaxCount;                /* Largest count seen by the consumer */
+}Test_SideType;
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+static RingBuffer_Type g_Ring;
+static Test_ElementType g_ElementStorage[TEST_CAPACITY];
+static uint8 g_ByteStorage[TEST_CAPACITY];
+static uint32 g_WordStorage[TEST_CAPACITY];
+
+static const char *const g_PhaseNames[TEST_PHASES] =
+{
+    "Push/Pop", "PushByte/PopByte", "PushWord/PopWord", "PushBulk/PopBulk", "WriteSpan/ReadSpan"
+};
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static uint32 Test_Random(Test_SideType *Side)
+{
+    Side->RandomState ^= Side->RandomState << 13;
+    Side->RandomState ^= Side->RandomState >> 17;
+    Side->RandomState ^= Side->RandomState << 5;
+    return Side->RandomState;
+}
+
+/* Count of a bulk or span transfer, 1 .. TEST_MAX_BULK and not past the last element */
+static uint32 Test_RandomCount(Test_SideType *Side, uint32 Sequence)
+{
+    uint32 Count = 1 + (Test_Random(Side) % TEST_MAX_BULK);
+
+    return (Count < (TEST_ELEMENTS - Sequence)) ? Count : (TEST_ELEMENTS - Sequence);
+}
+
+/* Check word of an element, differs from the sequence in every byte */
+static uint32 Test_CheckWord(uint32 Sequence)
+{
+    return ~(uint32)(Sequence * 0x9E3779B1UL);
+}
+
+static Test_ElementType Test_MakeElement(uint32 Sequence)
+{
+    Test_ElementType Element;
+
+    Element.Sequence = Sequence;
+    Element.Check = Test_CheckWord(Sequence);
+    return Element;
+}
+
+static void Test_CheckElement(const Test_ElementType *Element, uint32 Sequence)
+{
+    TEST_ASSERT(Element->Sequence == Sequence);
+    TEST_ASSERT(Element->Check == Test_CheckWord(Sequence));
+}
+
+static void *Test_Producer(void *a_Arg)
+{
+    Test_SideType *Side = (Test_SideType *)a_Arg;
+    Test_ElementType Bulk[TEST_MAX_BULK];
+    Test_ElementType Element;
+    void *Span;
+    uint32 Sequence = 0;
+    uint32 Previous;
+    uint32 Count;
+    uint32 Limit;
+    uint32 Index;
+
+    while(Sequence < TEST_ELEMENTS)
+    {
+        Previous = Sequence;
+
+        switch(Side->Phase)
+        {
+        case TEST_PHASE_ELEMENT:
+            Element = Test_MakeElement(Sequence);
+            if(RingBuffer_Push(&g_Ring, &Element) == E_OK)
+            {
+                Sequence++;
+            }
+            break;
+        case TEST_PHASE_BYTE:
+            if(RingBuffer_PushByte(&g_Ring, (uint8)Sequence) == E_OK)
+            {
+                Sequence++;
+            }
+            break;
+        case TEST_PHASE_WORD:
+            if(RingBuffer_PushWord(&g_Ring, Sequence) == E_OK)
+            {
+                Sequence++;
+            }
+            break;
+        case TEST_PHASE_BULK:
+            Count = Test_RandomCount(Side, Sequence);
+            for(Index = 0; Index < Count; Index++)
+            {
+                Bulk[Index] = Test_MakeElement(Sequence + Index);
+            }
+            Count = RingBuffer_PushBulk(&g_Ring, Bulk, Count);
+            TEST_ASSERT(Count <= TEST_CAPACITY);
+            Sequence += Count;
+            break;
+        case TEST_PHASE_SPAN:
+            Count = RingBuffer_GetWriteSpan(&g_Ring, &Span);
+            TEST_ASSERT(Count <= TEST_CAPACITY);
+            Limit = Test_RandomCount(Side, Sequence);
+            if(Count > Limit)
+            {
+                Count = Limit;
+            }
+            for(Index = 0; Index < Count; Index++)
+            {
+                ((Test_ElementType *)Span)[Index] = Test_MakeElement(Sequence + Index);
+            }
+            RingBuffer_CommitWrite(&g_Ring, Count);
+            Sequence += Count;
+            break;
+        default:
+            break;
+        }
+
+        /* Full or empty: let the other side run, the host may have a single core */
+        if(Sequence == Previous)
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void *Test_Consumer(void *a_Arg)
+{
+    Test_SideType *Side = (Test_SideType *)a_Arg;
+    Test_ElementType Bulk[TEST_MAX_BULK];
+    Test_ElementType Element;
+    const void *Span;
+    uint32 Sequence = 0;
+    uint32 Previous;
+    uint32 Count;
+    uint32 Limit;
+    uint32 Index;
+    uint32 Word;
+    uint8 Byte;
+
+    while(Sequence < TEST_ELEMENTS)
+    {
+        Previous = Sequence;
+
+        Count = RingBuffer_GetCount(&g_Ring);
+        TEST_ASSERT(Count <= TEST_CAPACITY);
+        if(Count > Side->MaxCount)
+        {
+            Side->MaxCount = Count;
+        }
+
+        switch(Side->Phase)
+        {
+        case TEST_PHASE_ELEMENT:
+            if(RingBuffer_Pop(&g_Ring, &Element) == E_OK)
+            {
+                Test_CheckElement(&Element, Sequence);
+                Sequence++;
+            }
+            break;
+        case TEST_PHASE_BYTE:
+            if(RingBuffer_PopByte(&g_Ring, &Byte) == E_OK)
+            {
+                TEST_ASSERT(Byte == (uint8)Sequence);
+                Sequence++;
+            }
+            break;
+        case TEST_PHASE_WORD:
+            if(RingBuffer_PopWord(&g_Ring, &Word) == E_OK)
+            {
+                TEST_ASSERT(Word == Sequence);
+                Sequence++;
+            }
+            break;
+        case TEST_PHASE_BULK:
+            Count = RingBuffer_PopBulk(&g_Ring, Bulk, Test_RandomCount(Side, Sequence));
+            TEST_ASSERT(Count <= TEST_CAPACITY);
+            for(Index = 0; Index < Count; Index++)
+            {
+                Test_CheckElement(&Bulk[Index], Sequence + Index);
+            }
+            Sequence += Count;
+            break;
+        case TEST_PHASE_SPAN:
+            Count = RingBuffer_GetReadSpan(&g_Ring, &Span);
+            TEST_ASSERT(Count <= TEST_CAPACITY);
+            Limit = Test_RandomCount(Side, Sequence);
+            if(Count > Limit)
+            {
+                Count = Limit;
+            }
+            for(Index = 0; Index < Count; Index++)
+            {
+                Test_CheckElement(&((const Test_ElementType *)Span)[Index], Sequence + Index);
+            }
+            RingBuffer_CommitRead(&g_Ring, Count);
+            Sequence += Count;
+            break;
+        default:
+            break;
+        }
+
+        /* Full or empty: let the other side run, the host may have a single core */
+        if(Sequence == Previous)
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/* Run one phase with the two sides in their own threads */
+static void Test_Phase(Test_PhaseType Phase)
+{
+    Test_SideType Producer = {Phase, 0, 0};
+    Test_SideType Consumer = {Phase, 0, 0};
+    pthread_t ProducerThread;
+    pthread_t ConsumerThread;
+
+    switch(Phase)
+    {
+    case TEST_PHASE_BYTE:
+        TEST_ASSERT(RingBuffer_Init(&g_Ring, g_ByteStorage, TEST_CAPACITY, sizeof(g_ByteStorage[0])) == E_OK);
+        break;
+    case TEST_PHASE_WORD:
+        TEST_ASSERT(RingBuffer_Init(&g_Ring, g_WordStorage, TEST_CAPACITY, sizeof(g_WordStorage[0])) == E_OK);
+        break;
+    default:
+        TEST_ASSERT(RingBuffer_Init(&g_Ring, g_ElementStorage, TEST_CAPACITY, sizeof(g_ElementStorage[0])) == E_OK);
+        break;
+    }
+
+    /* Both counters close to their wrap, the storage index is not 0 */
+    g_Ring.Head = TEST_START_COUNTER;
+    g_Ring.Tail = TEST_START_COUNTER;
+
+    Producer.RandomState = Host_Random() | 1;
+    Consumer.RandomState = Host_Random() | 1;
+
+    TEST_ASSERT(pthread_create(&ConsumerThread, NULL, Test_Consumer, &Consumer) == 0);
+    TEST_ASSERT(pthread_create(&ProducerThread, NULL, Test_Producer, &Producer) == 0);
+    TEST_ASSERT(pthread_join(ProducerThread, NULL) == 0);
+    TEST_ASSERT(pthread_join(ConsumerThread, NULL) == 0);
+
+    /* Everything consumed and the counters wrapped */
+    TEST_ASSERT(RingBuffer_GetCount(&g_Ring) == 0);
+    TEST_ASSERT(g_Ring.Head == (uint32)(TEST_START_COUNTER + TEST_ELEMENTS));
+    TEST_ASSERT(g_Ring.Head < TEST_START_COUNTER);
+
+    printf("%s: %lu elements, max count %u\n", g_PhaseNames[Phase], TEST_ELEMENTS, (unsigned int)Consumer.MaxCount);
+}
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    Test_PhaseType Phase;
+
+    Host_Seed(argc, argv);
+
+    for(Phase = TEST_PHASE_ELEMENT; Phase < TEST_PHASES; Phase++)
+    {
+        Test_Phase(Phase);
+    }
+
+    printf("RingBuffer_Test passed\n");
+    return 0;
+}
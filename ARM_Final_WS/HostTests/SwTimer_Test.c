@@ -0,0 +1,420 @@
+ /******************************************************************************
+ *
+ * Module: Host Tests
+ *
+ * File Name: SwTimer_Test.c
+ *
+ * Description: Randomized host test of the timing wheel of SwTimer.c against a reference model
+ *              keeping the running timers in a list sorted by expiry tick.
+ *
+ *              Every tick the timers due in the model must be exactly the timers called back by
+ *              the wheel. The periods cover the level 0 slots, the cascades at Tick & 63 and the
+ *              upper levels, the timers parked beyond SWTIMER_MAX_DIRECT_TICKS and
+ *              SWTIMER_MAX_PERIOD_TICKS. The call backs start, stop and restart timers, themselves
+ *              included, and the idle path skips ticks with SwTimer_GetIdleTicks/SwTimer_SkipTicks.
+ *              The tick counter starts close to its 32-bit wrap.
+ *
+ *              Usage: SwTimer_Test [seed]
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include "SwTimer.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define TEST_TIMERS                          48
+#define TEST_RANDOM_ITERATIONS               3000000
+
+/* Model tick of no expiry */
+#define TEST_NO_EXPIRY                       0xFFFFFFFFFFFFFFFFULL
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef struct
+{
+    boolean Active;
+    uint64 Expiry;                  /* Tick processing the expiry, not wrapped */
+    uint32 Period;
+    SwTimer_ModeType Mode;
+    uint32 Fired;
+}Model_TimerType;
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+static SwTimer_Type g_Timers[TEST_TIMERS];
+static Model_TimerType g_Model[TEST_TIMERS];
+
+/* Running timers of the model sorted by expiry */
+static uint8 g_ModelList[TEST_TIMERS];
+static uint8 g_ModelCount = 0;
+
+/* Next tick to be processed, not wrapped */
+static uint64 g_ModelTick;
+
+/* Tick processed by SwTimer_Tick, TEST_NO_EXPIRY outside of it */
+static uint64 g_ProcessedTick = TEST_NO_EXPIRY;
+
+/* Call backs take random actions when TRUE */
+static boolean g_CallBackActions = TRUE;
+
+static uint64 g_Expiries = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static void Model_Remove(uint8 Id)
+{
+    uint8 Index;
+
+    for(Index = 0; Index < g_ModelCount; Index++)
+    {
+        if(g_ModelList[Index] == Id)
+        {
+            for(; Index < (g_ModelCount - 1); Index++)
+            {
+                g_ModelList[Index] = g_ModelList[Index + 1];
+            }
+            g_ModelCount--;
+            return;
+        }
+    }
+}
+
+static void Model_Insert(uint8 Id)
+{
+    uint8 Index = g_ModelCount;
+
+    while((Index > 0) && (g_Model[g_ModelList[Index - 1]].Expiry > g_Model[Id].Expiry))
+    {
+        g_ModelList[Index] = g_ModelList[Index - 1];
+        Index--;
+    }
+    g_ModelList[Index] = Id;
+    g_ModelCount++;
+}
+
+static uint64 Model_NextExpiry(void)
+{
+    return (g_ModelCount != 0) ? g_Model[g_ModelList[0]].Expiry : TEST_NO_EXPIRY;
+}
+
+/* Period of every level of the wheel, of the cascade boundaries and of the parked timers */
+static uint32 Test_RandomPeriod(void)
+{
+    uint32 Boundary;
+    uint32 Period;
+
+    switch(Host_RandomBelow(10))
+    {
+    case 0: case 1: case 2: case 3:
+        return 1 + Host_RandomBelow(2 * SWTIMER_LEVEL_SLOTS);
+    case 4:
+        return 1 + Host_RandomBelow(SWTIMER_LEVEL_SLOTS * SWTIMER_LEVEL_SLOTS * 2);
+    case 5:
+        return 1 + Host_RandomBelow(1UL << 20);
+    case 6: case 7:
+        /* Expiry on a slot boundary of level 1, 2 or 3, or one tick around it */
+        Boundary = 1UL << (SWTIMER_LEVEL_BITS * (1 + Host_RandomBelow(3)));
+        Period = (uint32)(((g_ModelTick + Boundary) & ~((uint64)Boundary - 1)) - g_ModelTick);
+        return Period + Host_RandomBelow(3);
+    case 8:
+        /* Around the longest delay the wheel holds directly */
+        return SWTIMER_MAX_DIRECT_TICKS - 2 + Host_RandomBelow(5);
+    default:
+        return SWTIMER_MAX_PERIOD_TICKS - Host_RandomBelow(1UL << 24);
+    }
+}
+
+static void Test_CheckCurrentTick(void)
+{
+    TEST_ASSERT(SwTimer_GetTicks() == (uint32)g_ModelTick);
+}
+
+static void Test_Start(uint8 Id)
+{
+    Std_ReturnType Status = SwTimer_Start(&g_Timers[Id]);
+
+    if(g_Model[Id].Active)
+    {
+        TEST_ASSERT(Status == E_NOT_OK);
+        return;
+    }
+
+    TEST_ASSERT(Status == E_OK);
+    g_Model[Id].Active = TRUE;
+    g_Model[Id].Expiry = g_ModelTick + g_Model[Id].Period - 1;
+    Model_Insert(Id);
+}
+
+static void Test_Stop(uint8 Id)
+{
+    SwTimer_Stop(&g_Timers[Id]);
+
+    if(g_Model[Id].Active)
+    {
+        g_Model[Id].Active = FALSE;
+        Model_Remove(Id);
+    }
+}
+
+/* Period 0 keeps the current period */
+static void Test_Restart(uint8 Id, uint32 Period)
+{
+    TEST_ASSERT(SwTimer_Restart(&g_Timers[Id], Period) == E_OK);
+
+    if(g_Model[Id].Active)
+    {
+        Model_Remove(Id);
+    }
+    if(Period != 0)
+    {
+        g_Model[Id].Period = Period;
+    }
+    g_Model[Id].Active = TRUE;
+    g_Model[Id].Expiry = g_ModelTick + g_Model[Id].Period - 1;
+    Model_Insert(Id);
+}
+
+/* One random service call on a random timer */
+static void Test_RandomAction(uint8 Self)
+{
+    uint8 Id = (uint8)Host_RandomBelow(TEST_TIMERS);
+
+    switch(Host_RandomBelow(6))
+    {
+    case 0:
+        Test_Start(Id);
+        break;
+    case 1:
+        Test_Stop(Id);
+        break;
+    case 2:
+        Test_Restart(Id, 0);
+        break;
+    case 3:
+        Test_Restart(Id, Test_RandomPeriod());
+        break;
+    case 4:
+        /* A one-shot timer restarting itself from its call back */
+        Test_Restart(Self, Test_RandomPeriod());
+        break;
+    default:
+        Test_Stop(Self);
+        break;
+    }
+}
+
+static void Test_CallBack(void *a_Arg)
+{
+    uint8 Id = (uint8)(uintptr_t)a_Arg;
+    Model_TimerType *Model = &g_Model[Id];
+
+    /* Called from SwTimer_Tick, the wheel already moved to the next tick */
+    TEST_ASSERT(g_ProcessedTick != TEST_NO_EXPIRY);
+    Test_CheckCurrentTick();
+
+    /* Due in the model at this very tick */
+    TEST_ASSERT(Model->Active);
+    TEST_ASSERT(Model->Expiry == g_ProcessedTick);
+
+    Model_Remove(Id);
+    Model->Fired++;
+    g_Expiries++;
+    if(Model->Mode == SWTIMER_PERIODIC)
+    {
+        Model->Expiry += Model->Period;
+        Model_Insert(Id);
+    }
+    else
+    {
+        Model->Active = FALSE;
+    }
+    TEST_ASSERT(SwTimer_IsActive(&g_Timers[Id]) == Model->Active);
+
+    /* Call backs run outside of the critical section of the tick */
+    TEST_ASSERT(g_HostBasePri == 0);
+
+    if(g_CallBackActions && (Host_RandomBelow(3) == 0))
+    {
+        Test_RandomAction(Id);
+    }
+}
+
+/* Process one tick and check every timer due in the model was called back */
+static void Test_Tick(void)
+{
+    g_ProcessedTick = g_ModelTick;
+    g_ModelTick++;
+
+    SwTimer_Tick();
+
+    TEST_ASSERT(Model_NextExpiry() > g_ProcessedTick);
+    TEST_ASSERT(g_HostBasePri == 0);
+    g_ProcessedTick = TEST_NO_EXPIRY;
+    Test_CheckCurrentTick();
+}
+
+/* Skip the ticks reported free by the wheel, all of them or a random part */
+static void Test_Idle(boolean SkipAll)
+{
+    uint32 IdleTicks = SwTimer_GetIdleTicks();
+    uint32 Skip;
+
+    TEST_ASSERT(IdleTicks >= 1);
+
+    if(IdleTicks == SWTIMER_NO_PENDING_TICKS)
+    {
+        TEST_ASSERT(g_ModelCount == 0);
+        return;
+    }
+
+    /* The next IdleTicks - 1 ticks have nothing to expire */
+    TEST_ASSERT(Model_NextExpiry() >= (g_ModelTick + IdleTicks - 1));
+
+    Skip = SkipAll ? (IdleTicks - 1) : Host_RandomBelow(IdleTicks);
+    SwTimer_SkipTicks(Skip);
+    g_ModelTick += Skip;
+    Test_CheckCurrentTick();
+}
+
+/* Empty wheel starting at Tick */
+static void Test_Reset(uint32 Tick)
+{
+    uint8 Id;
+
+    SwTimer_Init();
+    SwTimer_SkipTicks(Tick);
+    g_ModelTick = Tick;
+    g_ModelCount = 0;
+
+    for(Id = 0; Id < TEST_TIMERS; Id++)
+    {
+        g_Model[Id].Active = FALSE;
+        g_Model[Id].Fired = 0;
+    }
+}
+
+static void Test_Parameters(void)
+{
+    SwTimer_Type Timer;
+
+    TEST_ASSERT(SwTimer_Create(&Timer, SWTIMER_ONE_SHOT, 0, Test_CallBack, NULL) == E_NOT_OK);
+    TEST_ASSERT(SwTimer_Create(&Timer, SWTIMER_ONE_SHOT, SWTIMER_MAX_PERIOD_TICKS + 1, Test_CallBack, NULL) == E_NOT_OK);
+    TEST_ASSERT(SwTimer_Create(&Timer, SWTIMER_ONE_SHOT, 1, NULL, NULL) == E_NOT_OK);
+    TEST_ASSERT(SwTimer_Create(&Timer, SWTIMER_PERIODIC, SWTIMER_MAX_PERIOD_TICKS, Test_CallBack, NULL) == E_OK);
+    TEST_ASSERT(SwTimer_Restart(&Timer, SWTIMER_MAX_PERIOD_TICKS + 1) == E_NOT_OK);
+    TEST_ASSERT(SwTimer_IsActive(&Timer) == FALSE);
+}
+
+/* Random timers, call back actions and idle skips */
+static void Test_Random(void)
+{
+    uint32 Iteration;
+    uint8 Id;
+
+    Test_Reset(0xFFFFFFFFUL - Host_RandomBelow(1UL << 20));
+
+    for(Id = 0; Id < TEST_TIMERS; Id++)
+    {
+        g_Model[Id].Mode = (Host_RandomBelow(2) == 0) ? SWTIMER_ONE_SHOT : SWTIMER_PERIODIC;
+        g_Model[Id].Period = Test_RandomPeriod();
+        TEST_ASSERT(SwTimer_Create(&g_Timers[Id], g_Model[Id].Mode, g_Model[Id].Period, Test_CallBack,
+                                   (void *)(uintptr_t)Id) == E_OK);
+    }
+
+    for(Iteration = 0; Iteration < TEST_RANDOM_ITERATIONS; Iteration++)
+    {
+        switch(Host_RandomBelow(8))
+        {
+        case 0:
+            Test_RandomAction((uint8)Host_RandomBelow(TEST_TIMERS));
+            TEST_ASSERT(g_HostBasePri == 0);
+            break;
+        case 1:
+            Test_Idle(FALSE);
+            break;
+        default:
+            break;
+        }
+        Test_Tick();
+    }
+
+    printf("random: %llu expiries, tick 0x%08X\n", (unsigned long long)g_Expiries, (unsigned int)SwTimer_GetTicks());
+}
+
+/* The longest periods: only the idle skips make 2^31 ticks affordable */
+static void Test_LongPeriods(void)
+{
+    static const uint32 Periods[] =
+    {
+        SWTIMER_MAX_PERIOD_TICKS,
+        SWTIMER_MAX_PERIOD_TICKS - 1,
+        SWTIMER_MAX_DIRECT_TICKS,
+        SWTIMER_MAX_DIRECT_TICKS + 1,
+        SWTIMER_MAX_DIRECT_TICKS * 3 + 7,
+        1UL << 30
+    };
+    const uint8 Count = sizeof(Periods) / sizeof(Periods[0]);
+    uint8 Id;
+
+    g_CallBackActions = FALSE;
+    Test_Reset(0xFFFFFFFFUL - Host_RandomBelow(1UL << 24));
+
+    for(Id = 0; Id < Count; Id++)
+    {
+        g_Model[Id].Mode = SWTIMER_ONE_SHOT;
+        g_Model[Id].Period = Periods[Id];
+        TEST_ASSERT(SwTimer_Create(&g_Timers[Id], SWTIMER_ONE_SHOT, Periods[Id], Test_CallBack,
+                                   (void *)(uintptr_t)Id) == E_OK);
+        Test_Start(Id);
+    }
+
+    while(g_ModelCount != 0)
+    {
+        Test_Idle(TRUE);
+        Test_Tick();
+    }
+
+    for(Id = 0; Id < Count; Id++)
+    {
+        TEST_ASSERT(g_Model[Id].Fired == 1);
+    }
+    /* Nothing is left in the wheel, the start of a level 0 round always reports one tick */
+    if((SwTimer_GetTicks() & SWTIMER_LEVEL_MASK) == 0)
+    {
+        Test_Tick();
+    }
+    TEST_ASSERT(SwTimer_GetIdleTicks() == SWTIMER_NO_PENDING_TICKS);
+
+    printf("long periods: done at tick 0x%08X\n", (unsigned int)SwTimer_GetTicks());
+}
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    Host_Seed(argc, argv);
+
+    Test_Parameters();
+    Test_Random();
+    Test_LongPeriods();
+
+    printf("SwTimer_Test passed\n");
+    return 0;
+}
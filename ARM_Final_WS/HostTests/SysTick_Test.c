@@ -0,0 +1,289 @@
+ /******************************************************************************
+ *
+ * Module: Host Tests
+ *
+ * File Name: SysTick_Test.c
+ *
+ * Description: Host test of the 64-bit time base of SysTick.c. The SysTick and RCC registers are
+ *              host memory, the test moves the counter, pends the reload and runs SysTick_Handler
+ *              like the hardware would.
+ *
+ *              It checks the tick count across the 2^31 and 2^32 wraps of the low word, a reader
+ *              preempting the handler between the low word and the epoch updates, a reader of a
+ *              higher priority running in SysTick_Handler right after the exception entry, and that
+ *              the microseconds never go back at a clock that is not a whole number of MHz.
+ *
+ *              SysTick.c is included so the test can place the counter close to its wraps.
+ *
+ *              Usage: SysTick_Test [seed]
+ *
+ * Author: Karima Mahmoud
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                    Header Files                             *
+ *******************************************************************************/
+#include <stdio.h>
+
+/* FPU_ISR_ENTER runs the higher priority reader of Fpu_IsrEnter below */
+#define FPU_MEASURE_STACKING                 TRUE
+
+#include "SysTick.c"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* RCC: main oscillator without PLL (BYPASS), XTAL field value of the crystal */
+#define TEST_RCC_BYPASS                      0x00000800
+#define TEST_XTAL_14_31818_MHZ               0x14
+#define TEST_XTAL_16_384_MHZ                 0x16
+
+/* Reads of the time base in one hardware period */
+#define TEST_READS_PER_PERIOD                97
+
+/*******************************************************************************
+ *                               Global Variables                              *
+ *******************************************************************************/
+
+/* Last values returned by the time base, a read must never return less */
+static uint64 g_LastTicks;
+static uint64 g_LastCycles;
+static uint64 g_LastMicros;
+
+static uint32 g_HandlerReads = 0;
+static uint32 g_HookTicks = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Read the three time bases and check they did not go back */
+static void Test_Read(void)
+{
+    uint64 Ticks = SysTick_GetTicks64();
+    uint64 Cycles = SysTick_GetCycles64();
+    uint64 Micros = SysTick_GetMicros();
+
+    TEST_ASSERT(Ticks >= g_LastTicks);
+    TEST_ASSERT(Cycles >= g_LastCycles);
+    TEST_ASSERT(Micros >= g_LastMicros);
+
+    g_LastTicks = Ticks;
+    g_LastCycles = Cycles;
+    g_LastMicros = Micros;
+}
+
+/* Runs in SysTick_Handler right after the tick is counted, like an interrupt of a higher priority
+ * preempting the handler */
+uint32 Fpu_IsrEnter(void)
+{
+    g_HandlerReads++;
+    Test_Read();
+    return 0;
+}
+
+void Fpu_IsrExit(uint32 a_State)
+{
+}
+
+/* Tick consumer bound by SYSTICK_STATIC_HOOKS in App_Cfg.h */
+void SwTimer_Tick(void)
+{
+    g_HookTicks++;
+}
+
+/* One hardware period of the counter: reads while it counts down, reads while the reload is
+ * pending, then the exception entry clears PENDSTSET and the handler runs */
+static void Test_Period(void)
+{
+    uint32 Reload = SYSTICK_RELOAD_REG;
+    uint32 Start = SYSTICK_CURRENT_REG;
+    uint32 Read;
+
+    /* The counter continues from where the previous period left it */
+    for(Read = 0; Read < TEST_READS_PER_PERIOD; Read++)
+    {
+        SYSTICK_CURRENT_REG = Start - (uint32)(((uint64)Start * Read) / TEST_READS_PER_PERIOD);
+        Test_Read();
+    }
+    SYSTICK_CURRENT_REG = 0;
+    Test_Read();
+
+    /* Reloaded, the handler did not run yet */
+    SYSTICK_CURRENT_REG = Reload - Host_RandomBelow(Reload / 4);
+    NVIC_SYSTEM_INTCTRL |= SYSTICK_PENDSTSET_MASK;
+    Test_Read();
+
+    NVIC_SYSTEM_INTCTRL &= ~(SYSTICK_PENDSTSET_MASK);
+    SysTick_Handler();
+    Test_Read();
+
+    /* Nothing pending, the single load of the low word agrees */
+    TEST_ASSERT((uint32)g_LastTicks == SysTick_GetTicks());
+}
+
+/* Start the time base with the given crystal and tick period */
+static void Test_Init(uint32 Xtal, uint32 MicrosPerTick)
+{
+    SYSCTL_RCC2_REG = 0;
+    SYSCTL_RCC_REG = TEST_RCC_BYPASS | (Xtal << SYSCTL_RCC_XTAL_POS);
+    NVIC_SYSTEM_INTCTRL = 0;
+
+    TEST_ASSERT(SysTick_InitMicros(MicrosPerTick) == E_OK);
+    SYSTICK_CURRENT_REG = SYSTICK_RELOAD_REG;
+
+    g_LastTicks = 0;
+    g_LastCycles = 0;
+    g_LastMicros = 0;
+}
+
+/* Place the tick count at Ticks as if the handler counted up to it */
+static void Test_SetTicks(uint64 Ticks)
+{
+    g_TicksLow = (uint32)Ticks;
+    g_TicksEpoch = (uint32)((Ticks >> 32) << 1) | ((uint32)Ticks >> 31);
+    g_PrescalerCount = g_Prescaler;
+    g_LastTicks = 0;
+    g_LastCycles = 0;
+    g_LastMicros = 0;
+}
+
+/* At 14.31818 MHz the rounded 14 cycles per microsecond made the microseconds of a 1 ms tick reach
+ * 1022 before going back to 1000 at the next tick */
+static void Test_NonIntegerClock(void)
+{
+    uint32 Period;
+
+    Test_Init(TEST_XTAL_14_31818_MHZ, 1000);
+    TEST_ASSERT(SysTick_GetCoreClock() == 14318180UL);
+    TEST_ASSERT(SYSTICK_RELOAD_REG == (14318 - 1));
+
+    for(Period = 0; Period < 1000; Period++)
+    {
+        Test_Period();
+    }
+
+    TEST_ASSERT(g_LastTicks == 1000);
+    TEST_ASSERT(g_LastMicros >= 1000000);
+    TEST_ASSERT(g_HookTicks >= 1000);
+}
+
+/* Low word wraps at 2^31 (epoch toggle) and 2^32 (high word carry) */
+static void Test_Wraps(void)
+{
+    static const uint64 Starts[] =
+    {
+        0x000000007FFFFFC0ULL,
+        0x00000000FFFFFFC0ULL,
+        0x000000017FFFFFC0ULL,
+        0x00000001FFFFFFC0ULL,
+        0x12345678FFFFFFC0ULL
+    };
+    uint64 Expected;
+    uint8 Start;
+    uint8 Tick;
+
+    Test_Init(TEST_XTAL_16_384_MHZ, 1000);
+
+    for(Start = 0; Start < (sizeof(Starts) / sizeof(Starts[0])); Start++)
+    {
+        Test_SetTicks(Starts[Start]);
+        Expected = Starts[Start];
+
+        for(Tick = 0; Tick < 128; Tick++)
+        {
+            TEST_ASSERT(SysTick_GetTicks64() == Expected);
+            Test_Period();
+            Expected++;
+            TEST_ASSERT(SysTick_GetTicks64() == Expected);
+            TEST_ASSERT(SysTick_GetMicros() >= (Expected * 1000));
+        }
+    }
+}
+
+/* A reader preempting the handler between the store of the low word and the epoch update sees
+ * the new low word with the previous epoch */
+static void Test_EpochRace(void)
+{
+    Test_Init(TEST_XTAL_16_384_MHZ, 1000);
+
+    /* Low word reached 2^31, epoch not incremented yet */
+    g_TicksLow = 0x80000000UL;
+    g_TicksEpoch = 0;
+    TEST_ASSERT(SysTick_GetTicks64() == 0x0000000080000000ULL);
+
+    /* Low word wrapped to 0, epoch still odd */
+    g_TicksLow = 0;
+    g_TicksEpoch = 1;
+    TEST_ASSERT(SysTick_GetTicks64() == 0x0000000100000000ULL);
+
+    g_TicksLow = 0x80000000UL;
+    g_TicksEpoch = 2;
+    TEST_ASSERT(SysTick_GetTicks64() == 0x0000000180000000ULL);
+}
+
+/* Ticks longer than the 24-bit counter: several hardware periods per tick */
+static void Test_Prescaled(void)
+{
+    uint32 Period;
+
+    Test_Init(TEST_XTAL_14_31818_MHZ, 2500000);
+    TEST_ASSERT(g_Prescaler == 3);
+
+    Test_SetTicks(0x00000000FFFFFFFEULL);
+    for(Period = 0; Period < (3 * 8); Period++)
+    {
+        Test_Period();
+    }
+    TEST_ASSERT(g_LastTicks == 0x0000000100000006ULL);
+}
+
+/* Random crystals and tick periods */
+static void Test_RandomClocks(void)
+{
+    uint32 Run;
+    uint32 Period;
+    uint32 Xtal;
+    uint32 MicrosPerTick;
+
+    for(Run = 0; Run < 200; Run++)
+    {
+        Xtal = SYSCTL_XTAL_FIRST + Host_RandomBelow(sizeof(g_XtalFrequency) / sizeof(g_XtalFrequency[0]));
+        MicrosPerTick = 50 + Host_RandomBelow(20000);
+
+        Test_Init(Xtal, MicrosPerTick);
+        Test_SetTicks(0x00000000FFFFFFF0ULL + Host_RandomBelow(32));
+
+        for(Period = 0; Period < (32 * g_Prescaler); Period++)
+        {
+            Test_Period();
+        }
+    }
+}
+
+/*******************************************************************************
+ *                               Functions Definitions                         *
+ *******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    Host_Seed(argc, argv);
+
+    Host_MapRegisters(0xE000E000, 0x1000);     /* SysTick and System Control Block */
+    Host_MapRegisters(0x400FE000, 0x1000);     /* System Control */
+    Host_MapRegisters(0xE0001000, 0x1000);     /* DWT cycle counter */
+
+    Test_NonIntegerClock();
+    Test_Wraps();
+    Test_EpochRace();
+    Test_Prescaled();
+    Test_RandomClocks();
+
+    TEST_ASSERT(g_HandlerReads != 0);
+    TEST_ASSERT(g_HostBasePri == 0);
+
+    printf("SysTick_Test passed\n");
+    return 0;
+}